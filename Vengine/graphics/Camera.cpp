@@ -0,0 +1,63 @@
+#include "Camera.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <algorithm>
+
+///////////////////////// CAMERA BEG //////////////////////////////
+
+Camera::Camera()
+{
+    position = glm::vec3(0.0f, 1.5f, 0.0f);
+    target   = glm::vec3(0.0f, 0.0f, 0.0f);
+    up       = glm::vec3(0.0f, 0.0f, 1.0f);
+
+    fieldOfView = 90.0f;
+    nearPlane   = 0.1f;
+    farPlane    = 100.0f;
+}
+
+glm::mat4 Camera::getView() const
+{
+    return glm::lookAt(position, target, up);
+}
+
+glm::mat4 Camera::getProjection(VkExtent2D extent) const
+{
+    glm::mat4 projection = glm::perspective(glm::radians(fieldOfView),
+                                            extent.width / (float) extent.height,
+                                            nearPlane,
+                                            farPlane);
+
+    // GLM     OpenGL,   Y 
+    //     -  Y 
+    //  
+    projection[1][1] *= -1;
+
+    return projection;
+}
+
+float Camera::getPixelsPerUnit(VkExtent2D extent) const
+{
+    return extent.height / (2.0f * std::tan(glm::radians(fieldOfView) * 0.5f));
+}
+
+void Camera::orbit(glm::vec3 target, float radius, float height, float angle)
+{
+    float radians = glm::radians(angle);
+
+    this->target = target;
+    position     = target + glm::vec3(radius * std::cos(radians), height, radius * std::sin(radians));
+    up           = glm::vec3(0.0f, 1.0f, 0.0f);
+}
+
+CameraPath makeTurntablePath(glm::vec3 target, float radius, float height)
+{
+    return [target, radius, height](uint32_t frame, uint32_t frameCount, Camera &camera)
+    {
+        camera.orbit(target, radius, height, 360.0f * frame / std::max(frameCount, 1u));
+    };
+}
+
+///////////////////////// CAMERA END //////////////////////////////
\ No newline at end of file
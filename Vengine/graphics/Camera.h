@@ -0,0 +1,45 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEFAULT_ALIGNED_GENTYPES
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <vulkan/vulkan.h>
+
+#include <functional>
+
+/*
+*    
+*       [-1, 1]  XZ
+*/
+class Camera
+{
+public:
+    glm::vec3 position;
+    glm::vec3 target;
+    glm::vec3 up;
+
+    float fieldOfView; //     
+    float nearPlane;
+    float farPlane;
+
+    Camera();
+
+    glm::mat4 getView() const;
+    glm::mat4 getProjection(VkExtent2D extent) const;
+
+    //             
+    //       distance  size * getPixelsPerUnit(extent) / distance
+    float     getPixelsPerUnit(VkExtent2D extent) const;
+
+    //      radius   height  target
+    //    target. angle  
+    void      orbit(glm::vec3 target, float radius, float height, float angle);
+};
+
+//     frame  frameCount    
+using CameraPath = std::function<void(uint32_t frame, uint32_t frameCount, Camera &camera)>;
+
+//    target  frameCount 
+CameraPath makeTurntablePath(glm::vec3 target, float radius, float height);
@@ -0,0 +1,158 @@
+#include "DrawSorter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+//       
+static const size_t minKeysPerChunk = 16384;
+
+static const uint32_t radixBits  = 8;
+static const uint32_t radixSize  = 1 << radixBits;
+static const uint32_t radixMask  = radixSize - 1;
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// DRAW KEY BEG //////////////////////////////
+
+uint64_t DrawKey::pack(uint32_t pipeline,
+                       uint32_t material,
+                       uint32_t mesh,
+                       float    depth)
+{
+    if(pipeline >= (1u << pipelineBits) ||
+       material >= (1u << materialBits) ||
+       mesh     >= (1u << meshBits))
+        throw std::out_of_range("failed to pack draw sort key!");
+
+    //   -       ,   
+    uint32_t depthBitsValue = 0;
+    if(depth > 0.0f)
+    {
+        std::memcpy(&depthBitsValue, &depth, sizeof(depth));
+        depthBitsValue >>= 32 - depthBits;
+    }
+
+    uint64_t key = pipeline;
+    key = (key << materialBits) | material;
+    key = (key << meshBits)     | mesh;
+    key = (key << depthBits)    | depthBitsValue;
+
+    return key;
+}
+
+uint32_t DrawKey::getPipeline(uint64_t key)
+{
+    return static_cast<uint32_t>(key >> (materialBits + meshBits + depthBits));
+}
+
+uint32_t DrawKey::getMaterial(uint64_t key)
+{
+    return static_cast<uint32_t>(key >> (meshBits + depthBits)) & ((1u << materialBits) - 1);
+}
+
+uint32_t DrawKey::getMesh(uint64_t key)
+{
+    return static_cast<uint32_t>(key >> depthBits) & ((1u << meshBits) - 1);
+}
+
+///////////////////////// DRAW KEY END //////////////////////////////
+
+
+///////////////////////// DRAW SORTER BEG //////////////////////////////
+
+DrawSorter::DrawSorter()
+{
+    workers = nullptr;
+}
+
+void DrawSorter::setWorkerPool(WorkerPool *workers)
+{
+    this->workers = workers;
+}
+
+void DrawSorter::sort(std::vector<uint64_t> &keys,
+                      std::vector<uint32_t> &values)
+{
+    if(keys.size() != values.size())
+        throw std::invalid_argument("draw sort keys and values have different sizes!");
+
+    size_t count = keys.size();
+    if(count < 2)
+        return;
+
+    // ,       .     
+    uint64_t differentBits = 0;
+    for(uint64_t key : keys)
+        differentBits |= key ^ keys[0];
+
+    size_t threadCount = workers ? workers->getThreadCount() : 1;
+    size_t chunkCount  = std::max<size_t>(std::min(threadCount, count / minKeysPerChunk), 1);
+    size_t chunkSize   = (count + chunkCount - 1) / chunkCount;
+
+    //         
+    auto runChunks = [&](const std::function<void(size_t)> &work)
+    {
+        if(chunkCount > 1)
+            workers->run(chunkCount, work);
+        else
+            work(0);
+    };
+
+    tempKeys.resize(count);
+    tempValues.resize(count);
+    histograms.resize(chunkCount * radixSize);
+
+    for(uint32_t shift = 0; shift < 64; shift += radixBits)
+    {
+        if(((differentBits >> shift) & radixMask) == 0)
+            continue;
+
+        std::fill(histograms.begin(), histograms.end(), 0);
+
+        runChunks([&](size_t chunk)
+        {
+            size_t    begin     = std::min(chunk * chunkSize, count);
+            size_t    end       = std::min(begin + chunkSize, count);
+            uint32_t *histogram = &histograms[chunk * radixSize];
+
+            for(size_t i = begin; i < end; i++)
+                histogram[(keys[i] >> shift) & radixMask]++;
+        });
+
+        //      :    ,
+        //        
+        uint32_t offset = 0;
+        for(uint32_t digit = 0; digit < radixSize; digit++)
+            for(size_t chunk = 0; chunk < chunkCount; chunk++)
+            {
+                uint32_t digitCount = histograms[chunk * radixSize + digit];
+                histograms[chunk * radixSize + digit] = offset;
+                offset += digitCount;
+            }
+
+        runChunks([&](size_t chunk)
+        {
+            size_t    begin   = std::min(chunk * chunkSize, count);
+            size_t    end     = std::min(begin + chunkSize, count);
+            uint32_t *offsets = &histograms[chunk * radixSize];
+
+            for(size_t i = begin; i < end; i++)
+            {
+                uint32_t destination = offsets[(keys[i] >> shift) & radixMask]++;
+
+                tempKeys[destination]   = keys[i];
+                tempValues[destination] = values[i];
+            }
+        });
+
+        keys.swap(tempKeys);
+        values.swap(tempValues);
+    }
+}
+
+///////////////////////// DRAW SORTER END //////////////////////////////
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "WorkerPool.h"
+
+/*
+*    .       
+*      :
+* |  6 |  () 16 |  18 |  24 |
+*            ,
+*   -   ,  -   ,     
+*/
+struct DrawKey
+{
+    static const uint32_t pipelineBits = 6;
+    static const uint32_t materialBits = 16;
+    static const uint32_t meshBits     = 18;
+    static const uint32_t depthBits    = 24;
+
+    // depth -    .    float
+    //     ,      
+    static uint64_t pack(uint32_t pipeline,
+                         uint32_t material,
+                         uint32_t mesh,
+                         float    depth);
+
+    static uint32_t getPipeline(uint64_t key);
+    static uint32_t getMaterial(uint64_t key);
+    static uint32_t getMesh    (uint64_t key);
+};
+
+/*
+*     8   ,   
+*   ,    , . ,     
+*     :       
+*     WorkerPool.     ,   
+*/
+class DrawSorter
+{
+public:
+    DrawSorter();
+
+    //       
+    void setWorkerPool(WorkerPool *workers);
+
+    //  keys     values   
+    void sort(std::vector<uint64_t> &keys,
+              std::vector<uint32_t> &values);
+
+private:
+    WorkerPool *workers;
+
+    //     .   ,     
+    std::vector<uint64_t> tempKeys;
+    std::vector<uint32_t> tempValues;
+    //  : 256   
+    std::vector<uint32_t> histograms;
+};
@@ -0,0 +1,148 @@
+#include "FrameStats.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+static float toMilliseconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+static FrameStats::Summary summarize(std::vector<float> values)
+{
+    FrameStats::Summary summary = {};
+    if(values.empty())
+        return summary;
+
+    std::sort(values.begin(), values.end());
+
+    float sum = 0.0f;
+    for(float value : values)
+        sum += value;
+
+    size_t p99Index = std::min(values.size() - 1, values.size() * 99 / 100);
+
+    summary.avg     = sum / values.size();
+    summary.min     = values.front();
+    summary.p99     = values[p99Index];
+    summary.max     = values.back();
+    summary.samples = values.size();
+
+    return summary;
+}
+
+static void printSeries(const char *name, const std::vector<float> &values)
+{
+    FrameStats::Summary summary = summarize(values);
+
+    if(summary.samples == 0)
+    {
+        std::cout << name << ": no samples\n";
+        return;
+    }
+
+    std::cout << name << ": "
+              << "avg " << summary.avg << " ms, "
+              << "min " << summary.min << " ms, "
+              << "p99 " << summary.p99 << " ms, "
+              << "max " << summary.max << " ms "
+              << "(" << summary.samples << " samples)\n";
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// FRAME STATS BEG //////////////////////////////
+
+FrameStats::FrameStats()
+{
+    reset();
+}
+
+void FrameStats::beginFrame()
+{
+    frameBegin = Clock::now();
+
+    if(hasLastFrame)
+        frameTimes.push_back(toMilliseconds(frameBegin - lastFrameBegin));
+
+    lastFrameBegin = frameBegin;
+    hasLastFrame   = true;
+    inFrame        = true;
+
+    // ,    ,    
+    inputInFrame = inputPending;
+}
+
+void FrameStats::registerInput()
+{
+    //      ,      
+    if(inputPending)
+        return;
+
+    inputTime    = Clock::now();
+    inputPending = true;
+}
+
+void FrameStats::framePresented()
+{
+    Clock::time_point presentTime = Clock::now();
+
+    //     reset
+    if(inFrame)
+        presentCallTimes.push_back(toMilliseconds(presentTime - frameBegin));
+
+    inFrame = false;
+
+    if(!inputInFrame)
+        return;
+
+    inputLatencies.push_back(toMilliseconds(presentTime - inputTime));
+
+    inputPending = false;
+    inputInFrame = false;
+}
+
+size_t FrameStats::getFrameCount()
+{
+    return frameTimes.size();
+}
+
+FrameStats::Summary FrameStats::getFrameTimeSummary() const
+{
+    return summarize(frameTimes);
+}
+
+FrameStats::Summary FrameStats::getPresentCallSummary() const
+{
+    return summarize(presentCallTimes);
+}
+
+void FrameStats::print(const std::string &label)
+{
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\n[" << label << "]\n";
+
+    printSeries("frame time                 ", frameTimes);
+    printSeries("frame start to present call", presentCallTimes);
+    printSeries("key to present call        ", inputLatencies);
+
+    std::cout.unsetf(std::ios_base::floatfield);
+}
+
+void FrameStats::reset()
+{
+    hasLastFrame = false;
+    inFrame      = false;
+    inputPending = false;
+    inputInFrame = false;
+
+    frameTimes.clear();
+    presentCallTimes.clear();
+    inputLatencies.clear();
+}
+
+///////////////////////// FRAME STATS END //////////////////////////////
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/*
+*           
+*   -       vkQueuePresentKHR,     
+*   .            
+*     :   ,     ,
+*    vkQueuePresentKHR  ,   .   
+*  ,   ,   
+*/
+class FrameStats
+{
+public:
+    //     .    samples = 0
+    struct Summary
+    {
+        float  avg;
+        float  min;
+        float  p99;
+        float  max;
+        size_t samples;
+    };
+
+    FrameStats();
+
+    void beginFrame();
+    void registerInput();
+    void framePresented();
+
+    size_t getFrameCount();
+
+    Summary getFrameTimeSummary()   const;
+    Summary getPresentCallSummary() const;
+
+    void print(const std::string &label);
+    void reset();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point lastFrameBegin;
+    Clock::time_point frameBegin;
+    Clock::time_point inputTime;
+
+    bool hasLastFrame;
+    bool inFrame;
+    bool inputPending;
+    bool inputInFrame;
+
+    std::vector<float> frameTimes;
+    std::vector<float> presentCallTimes;
+    std::vector<float> inputLatencies;
+};
@@ -0,0 +1,242 @@
+#include "FrustumCulling.h"
+
+#include <algorithm>
+
+// AVX       (/arch:AVX),  SSE,
+//     x64 .      
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define CULLING_USE_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define CULLING_USE_SSE
+#endif
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+//       
+static const size_t minSpheresPerChunk = 16384;
+
+static glm::vec4 getRow(const glm::mat4 &matrix, int row)
+{
+    //  GLM   
+    return glm::vec4(matrix[0][row], matrix[1][row], matrix[2][row], matrix[3][row]);
+}
+
+static glm::vec4 normalizePlane(const glm::vec4 &plane)
+{
+    //   a*x + b*y + c*z + d -    ,
+    //      
+    return plane / glm::length(glm::vec3(plane));
+}
+
+static bool isSphereVisible(const Frustum     &frustum,
+                            const SphereArray &spheres,
+                            size_t             index)
+{
+    for(const glm::vec4 &plane : frustum.planes)
+    {
+        float distance = plane.x * spheres.centerX[index] +
+                         plane.y * spheres.centerY[index] +
+                         plane.z * spheres.centerZ[index] +
+                         plane.w;
+
+        if(distance < -spheres.radius[index])
+            return false;
+    }
+
+    return true;
+}
+
+static void pushVisible(int                    mask,
+                        size_t                 first,
+                        int                    width,
+                        std::vector<uint32_t> &visible)
+{
+    for(int bit = 0; bit < width; bit++)
+        if(mask & (1 << bit))
+            visible.push_back(static_cast<uint32_t>(first + bit));
+}
+
+static void cullRange(const Frustum          &frustum,
+                      const SphereArray      &spheres,
+                      size_t                  begin,
+                      size_t                  end,
+                      std::vector<uint32_t>  &visible)
+{
+    visible.clear();
+
+    size_t i = begin;
+
+#if defined(CULLING_USE_AVX)
+    __m256 planeX[6], planeY[6], planeZ[6], planeW[6];
+    for(int p = 0; p < 6; p++)
+    {
+        planeX[p] = _mm256_set1_ps(frustum.planes[p].x);
+        planeY[p] = _mm256_set1_ps(frustum.planes[p].y);
+        planeZ[p] = _mm256_set1_ps(frustum.planes[p].z);
+        planeW[p] = _mm256_set1_ps(frustum.planes[p].w);
+    }
+
+    for(; i + 8 <= end; i += 8)
+    {
+        __m256 x         = _mm256_loadu_ps(&spheres.centerX[i]);
+        __m256 y         = _mm256_loadu_ps(&spheres.centerY[i]);
+        __m256 z         = _mm256_loadu_ps(&spheres.centerZ[i]);
+        __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&spheres.radius[i]));
+
+        //  ,          -radius
+        __m256 inside = _mm256_cmp_ps(_mm256_setzero_ps(), _mm256_setzero_ps(), _CMP_EQ_OQ);
+        for(int p = 0; p < 6; p++)
+        {
+            __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(planeX[p], x),
+                                                          _mm256_mul_ps(planeY[p], y)),
+                                            _mm256_add_ps(_mm256_mul_ps(planeZ[p], z),
+                                                          planeW[p]));
+
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+        }
+
+        int mask = _mm256_movemask_ps(inside);
+        if(mask)
+            pushVisible(mask, i, 8, visible);
+    }
+#elif defined(CULLING_USE_SSE)
+    __m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+    for(int p = 0; p < 6; p++)
+    {
+        planeX[p] = _mm_set1_ps(frustum.planes[p].x);
+        planeY[p] = _mm_set1_ps(frustum.planes[p].y);
+        planeZ[p] = _mm_set1_ps(frustum.planes[p].z);
+        planeW[p] = _mm_set1_ps(frustum.planes[p].w);
+    }
+
+    for(; i + 4 <= end; i += 4)
+    {
+        __m128 x         = _mm_loadu_ps(&spheres.centerX[i]);
+        __m128 y         = _mm_loadu_ps(&spheres.centerY[i]);
+        __m128 z         = _mm_loadu_ps(&spheres.centerZ[i]);
+        __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&spheres.radius[i]));
+
+        //  ,          -radius
+        __m128 inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+        for(int p = 0; p < 6; p++)
+        {
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[p], x),
+                                                    _mm_mul_ps(planeY[p], y)),
+                                         _mm_add_ps(_mm_mul_ps(planeZ[p], z),
+                                                    planeW[p]));
+
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+        }
+
+        int mask = _mm_movemask_ps(inside);
+        if(mask)
+            pushVisible(mask, i, 4, visible);
+    }
+#endif
+
+    // ,    SIMD 
+    for(; i < end; i++)
+        if(isSphereVisible(frustum, spheres, i))
+            visible.push_back(static_cast<uint32_t>(i));
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// FRUSTUM BEG //////////////////////////////
+
+void Frustum::setFromMatrix(const glm::mat4 &viewProjection)
+{
+    glm::vec4 row0 = getRow(viewProjection, 0);
+    glm::vec4 row1 = getRow(viewProjection, 1);
+    glm::vec4 row2 = getRow(viewProjection, 2);
+    glm::vec4 row3 = getRow(viewProjection, 3);
+
+    planes[0] = normalizePlane(row3 + row0); // 
+    planes[1] = normalizePlane(row3 - row0); // 
+    planes[2] = normalizePlane(row3 + row1); // 
+    planes[3] = normalizePlane(row3 - row1); // 
+    //       [-w, w].    [0, w]  
+    //   ,             
+    planes[4] = normalizePlane(row3 + row2); // 
+    planes[5] = normalizePlane(row3 - row2); // 
+}
+
+///////////////////////// FRUSTUM END //////////////////////////////
+
+
+///////////////////////// SPHERE ARRAY BEG //////////////////////////////
+
+void SphereArray::resize(size_t count)
+{
+    centerX.resize(count);
+    centerY.resize(count);
+    centerZ.resize(count);
+    radius.resize(count);
+}
+
+size_t SphereArray::size() const
+{
+    return radius.size();
+}
+
+void SphereArray::set(size_t index, const glm::vec3 &center, float sphereRadius)
+{
+    centerX[index] = center.x;
+    centerY[index] = center.y;
+    centerZ[index] = center.z;
+    radius[index]  = sphereRadius;
+}
+
+///////////////////////// SPHERE ARRAY END //////////////////////////////
+
+
+///////////////////////// FRUSTUM CULLER BEG //////////////////////////////
+
+FrustumCuller::FrustumCuller()
+{
+    workers = nullptr;
+}
+
+void FrustumCuller::setWorkerPool(WorkerPool *workers)
+{
+    this->workers = workers;
+}
+
+void FrustumCuller::cull(const Frustum          &frustum,
+                         const SphereArray      &spheres,
+                         std::vector<uint32_t>  &visible)
+{
+    size_t count       = spheres.size();
+    size_t threadCount = workers ? workers->getThreadCount() : 1;
+    size_t chunkCount  = std::min(threadCount, count / minSpheresPerChunk);
+
+    if(chunkCount <= 1)
+    {
+        cullRange(frustum, spheres, 0, count, visible);
+        return;
+    }
+
+    //    8,         SIMD 
+    size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    chunkSize = (chunkSize + 7) / 8 * 8;
+
+    chunkVisible.resize(chunkCount);
+
+    workers->run(chunkCount, [&](size_t chunk)
+    {
+        size_t begin = std::min(chunk * chunkSize, count);
+        size_t end   = std::min(begin + chunkSize, count);
+
+        cullRange(frustum, spheres, begin, end, chunkVisible[chunk]);
+    });
+
+    //     ,      
+    visible.clear();
+    for(const std::vector<uint32_t> &chunk : chunkVisible)
+        visible.insert(visible.end(), chunk.begin(), chunk.end());
+}
+
+///////////////////////// FRUSTUM CULLER END //////////////////////////////
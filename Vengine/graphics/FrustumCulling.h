@@ -0,0 +1,64 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEFAULT_ALIGNED_GENTYPES
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <vector>
+
+#include "WorkerPool.h"
+
+/*
+*        (a, b, c, d)
+*  p     ,  a*p.x + b*p.y + c*p.z + d >= 0
+*/
+struct Frustum
+{
+    glm::vec4 planes[6];
+
+    //     projection * view
+    void setFromMatrix(const glm::mat4 &viewProjection);
+};
+
+/*
+*      
+*       ,  
+*   SIMD   4 (SSE)  8 (AVX) 
+*/
+struct SphereArray
+{
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> radius;
+
+    void   resize(size_t count);
+    size_t size() const;
+
+    void set(size_t index, const glm::vec3 &center, float sphereRadius);
+};
+
+/*
+*  ,         
+*     ,      WorkerPool
+*/
+class FrustumCuller
+{
+public:
+    FrustumCuller();
+
+    //        
+    void setWorkerPool(WorkerPool *workers);
+
+    //   visible      
+    void cull(const Frustum          &frustum,
+              const SphereArray      &spheres,
+              std::vector<uint32_t>  &visible);
+
+private:
+    WorkerPool *workers;
+
+    //   .   ,     
+    std::vector<std::vector<uint32_t>> chunkVisible;
+};
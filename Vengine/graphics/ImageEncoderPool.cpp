@@ -0,0 +1,158 @@
+#include "ImageEncoderPool.h"
+
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+#include "tools.h"
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+using Clock = std::chrono::steady_clock;
+
+static double toSeconds(Clock::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// IMAGE ENCODER POOL BEG //////////////////////////////
+
+ImageEncoderPool::ImageEncoderPool()
+{
+    maxQueuedImages = 1;
+    threadCount     = 0;
+    stopping        = false;
+    unfinishedJobs  = 0;
+    stats           = {};
+}
+
+ImageEncoderPool::~ImageEncoderPool()
+{
+    finish();
+}
+
+void ImageEncoderPool::start(uint32_t threadCount,
+                             size_t   maxQueuedImages)
+{
+    if(threadCount == 0)
+        threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+    this->threadCount     = threadCount;
+    this->maxQueuedImages = std::max<size_t>(maxQueuedImages, 1);
+    stopping              = false;
+    stats                 = {};
+
+    for(uint32_t i = 0; i < threadCount; i++)
+        workers.emplace_back(&ImageEncoderPool::work, this);
+}
+
+void ImageEncoderPool::push(const std::string &path,
+                            int                width,
+                            int                height,
+                            std::vector<Pixel> pixels)
+{
+    enqueue({path, width, height, std::move(pixels), nullptr});
+}
+
+void ImageEncoderPool::encodePng(int                         width,
+                                 int                         height,
+                                 std::vector<Pixel>          pixels,
+                                 std::vector<unsigned char> &png)
+{
+    enqueue({std::string(), width, height, std::move(pixels), &png});
+}
+
+void ImageEncoderPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    jobFinished.wait(lock, [this]() { return unfinishedJobs == 0; });
+}
+
+void ImageEncoderPool::enqueue(Job job)
+{
+    Clock::time_point begin = Clock::now();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    jobTaken.wait(lock, [this]() { return jobs.size() < maxQueuedImages; });
+
+    stats.pushWaitSeconds += toSeconds(Clock::now() - begin);
+
+    jobs.push_back(std::move(job));
+    unfinishedJobs++;
+    jobAdded.notify_one();
+}
+
+void ImageEncoderPool::work()
+{
+    while(true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAdded.wait(lock, [this]() { return stopping || !jobs.empty(); });
+
+            //       
+            if(jobs.empty())
+                return;
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        jobTaken.notify_one();
+
+        Clock::time_point begin = Clock::now();
+
+        try
+        {
+            if(job.png)
+                *job.png = VengineTools::encodePng(job.width, job.height, job.pixels);
+            else
+                VengineTools::saveImage(job.path, job.width, job.height, job.pixels);
+        }
+        catch(std::exception &e)
+        {
+            std::cerr << e.what() << std::endl;
+        }
+
+        double encodeSeconds = toSeconds(Clock::now() - begin);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.images++;
+            stats.bytes         += job.pixels.size() * sizeof(Pixel);
+            stats.encodeSeconds += encodeSeconds;
+            unfinishedJobs--;
+        }
+        jobFinished.notify_all();
+    }
+}
+
+void ImageEncoderPool::finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobAdded.notify_all();
+
+    for(std::thread &worker : workers)
+        worker.join();
+
+    workers.clear();
+}
+
+uint32_t ImageEncoderPool::getThreadCount() const
+{
+    return threadCount;
+}
+
+ImageEncoderPool::Stats ImageEncoderPool::getStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+///////////////////////// IMAGE ENCODER POOL END //////////////////////////////
\ No newline at end of file
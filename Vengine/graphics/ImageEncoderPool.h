@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Pixel.h"
+
+/*
+*         PNG     ,
+*     
+*  ,    ,    .   
+* push ,         ,    - 
+*/
+class ImageEncoderPool
+{
+public:
+    struct Stats
+    {
+        uint64_t images;
+        uint64_t bytes;
+        //      
+        double   encodeSeconds;
+        //  push    
+        double   pushWaitSeconds;
+    };
+
+    ImageEncoderPool();
+    ~ImageEncoderPool();
+
+    // threadCount = 0 -      ,  
+    void start(uint32_t threadCount, size_t maxQueuedImages);
+
+    //      path,   VengineTools::saveImage
+    void push(const std::string &path,
+              int                width,
+              int                height,
+              std::vector<Pixel> pixels);
+
+    // PNG   png,     wait  finish
+    void encodePng(int                         width,
+                   int                         height,
+                   std::vector<Pixel>          pixels,
+                   std::vector<unsigned char> &png);
+
+    //    ,   
+    void wait();
+
+    //       
+    void finish();
+
+    uint32_t getThreadCount() const;
+    Stats    getStats();
+
+private:
+    struct Job
+    {
+        std::string        path;
+        int                width;
+        int                height;
+        std::vector<Pixel> pixels;
+        // nullptr -     path
+        std::vector<unsigned char> *png;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<Job>          jobs;
+    size_t                   maxQueuedImages;
+    uint32_t                 threadCount;
+    bool                     stopping;
+    //      
+    size_t                   unfinishedJobs;
+
+    std::mutex               mutex;
+    std::condition_variable  jobAdded;
+    std::condition_variable  jobTaken;
+    std::condition_variable  jobFinished;
+
+    Stats                    stats;
+
+    void enqueue(Job job);
+    void work();
+};
\ No newline at end of file
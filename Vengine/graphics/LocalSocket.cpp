@@ -0,0 +1,271 @@
+#include "LocalSocket.h"
+
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <afunix.h>
+    #pragma comment(lib, "Ws2_32.lib")
+
+    using SocketHandle = SOCKET;
+    static const SocketHandle invalidSocket = INVALID_SOCKET;
+
+    #define closeSocket closesocket
+#else
+    #include <sys/socket.h>
+    #include <sys/select.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+
+    using SocketHandle = int;
+    static const SocketHandle invalidSocket = -1;
+
+    #define closeSocket ::close
+#endif
+
+//           SIGPIPE
+#ifdef MSG_NOSIGNAL
+    static const int sendFlags = MSG_NOSIGNAL;
+#else
+    static const int sendFlags = 0;
+#endif
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+static void initSockets()
+{
+#ifdef _WIN32
+    static bool initialized = false;
+    if(initialized)
+        return;
+
+    WSADATA data;
+    if(WSAStartup(MAKEWORD(2, 2), &data) != 0)
+        throw std::runtime_error("failed to initialize winsock!");
+
+    initialized = true;
+#endif
+}
+
+static sockaddr_un makeAddress(const std::string &path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    if(path.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("socket path is too long!");
+
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    return address;
+}
+
+static SocketHandle createSocket()
+{
+    initSockets();
+
+    SocketHandle socketHandle = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(socketHandle == invalidSocket)
+        throw std::runtime_error("failed to create socket!");
+
+    return socketHandle;
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// LOCAL SOCKET BEG //////////////////////////////
+
+LocalSocket::LocalSocket()
+{
+    handle = static_cast<intptr_t>(invalidSocket);
+}
+
+LocalSocket::LocalSocket(intptr_t handle)
+{
+    this->handle = handle;
+}
+
+LocalSocket::~LocalSocket()
+{
+    close();
+}
+
+LocalSocket::LocalSocket(LocalSocket &&other)
+{
+    handle   = other.handle;
+    received = std::move(other.received);
+    path     = std::move(other.path);
+
+    other.handle = static_cast<intptr_t>(invalidSocket);
+    other.path.clear();
+}
+
+LocalSocket &LocalSocket::operator=(LocalSocket &&other)
+{
+    if(this != &other)
+    {
+        close();
+
+        handle   = other.handle;
+        received = std::move(other.received);
+        path     = std::move(other.path);
+
+        other.handle = static_cast<intptr_t>(invalidSocket);
+        other.path.clear();
+    }
+
+    return *this;
+}
+
+LocalSocket LocalSocket::listen(const std::string &path)
+{
+    SocketHandle socketHandle = createSocket();
+    sockaddr_un  address      = makeAddress(path);
+
+    std::remove(path.c_str());
+
+    if(bind(socketHandle, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+       ::listen(socketHandle, SOMAXCONN) != 0)
+    {
+        closeSocket(socketHandle);
+        throw std::runtime_error("failed to listen on socket " + path + "!");
+    }
+
+    LocalSocket server(static_cast<intptr_t>(socketHandle));
+    server.path = path;
+
+    return server;
+}
+
+LocalSocket LocalSocket::connect(const std::string &path)
+{
+    SocketHandle socketHandle = createSocket();
+    sockaddr_un  address      = makeAddress(path);
+
+    if(::connect(socketHandle, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        closeSocket(socketHandle);
+        throw std::runtime_error("failed to connect to socket " + path + "!");
+    }
+
+    return LocalSocket(static_cast<intptr_t>(socketHandle));
+}
+
+LocalSocket LocalSocket::accept()
+{
+    SocketHandle client = ::accept(static_cast<SocketHandle>(handle), nullptr, nullptr);
+    if(client == invalidSocket)
+        throw std::runtime_error("failed to accept connection!");
+
+    return LocalSocket(static_cast<intptr_t>(client));
+}
+
+bool LocalSocket::isOpen() const
+{
+    return handle != static_cast<intptr_t>(invalidSocket);
+}
+
+bool LocalSocket::receiveMore()
+{
+    char buffer[4096];
+
+    int count = recv(static_cast<SocketHandle>(handle), buffer, sizeof(buffer), 0);
+    if(count <= 0)
+        return false;
+
+    received.append(buffer, count);
+    return true;
+}
+
+bool LocalSocket::readLine(std::string &line)
+{
+    size_t end;
+    while((end = received.find('\n')) == std::string::npos)
+    {
+        if(received.size() > maxLineLength)
+            throw std::runtime_error("line is too long!");
+
+        if(!receiveMore())
+            return false;
+    }
+
+    if(end > maxLineLength)
+        throw std::runtime_error("line is too long!");
+
+    line = received.substr(0, end);
+    received.erase(0, end + 1);
+
+    //   Windows     \r\n
+    if(!line.empty() && line.back() == '\r')
+        line.pop_back();
+
+    return true;
+}
+
+bool LocalSocket::readBytes(void *data, size_t size)
+{
+    while(received.size() < size)
+        if(!receiveMore())
+            return false;
+
+    memcpy(data, received.data(), size);
+    received.erase(0, size);
+
+    return true;
+}
+
+bool LocalSocket::hasPendingData()
+{
+    if(!received.empty())
+        return true;
+
+    SocketHandle socketHandle = static_cast<SocketHandle>(handle);
+
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET(socketHandle, &readable);
+
+    timeval noWait{};
+
+    return select(static_cast<int>(socketHandle) + 1, &readable, nullptr, nullptr, &noWait) > 0;
+}
+
+void LocalSocket::write(const void *data, size_t size)
+{
+    const char *bytes = static_cast<const char *>(data);
+
+    while(size > 0)
+    {
+        int count = send(static_cast<SocketHandle>(handle), bytes, static_cast<int>(size), sendFlags);
+        if(count <= 0)
+            throw std::runtime_error("failed to write to socket!");
+
+        bytes += count;
+        size  -= count;
+    }
+}
+
+void LocalSocket::write(const std::string &text)
+{
+    write(text.data(), text.size());
+}
+
+void LocalSocket::close()
+{
+    if(!isOpen())
+        return;
+
+    closeSocket(static_cast<SocketHandle>(handle));
+    handle = static_cast<intptr_t>(invalidSocket);
+
+    if(!path.empty())
+    {
+        std::remove(path.c_str());
+        path.clear();
+    }
+}
+
+///////////////////////// LOCAL SOCKET END //////////////////////////////
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+/*
+*    Unix      
+*  Windows 10    AF_UNIX  Winsock,      
+*    std::runtime_error,     - 
+*/
+class LocalSocket
+{
+public:
+    LocalSocket();
+    ~LocalSocket();
+
+    LocalSocket(LocalSocket &&other);
+    LocalSocket &operator=(LocalSocket &&other);
+
+    LocalSocket(const LocalSocket &)            = delete;
+    LocalSocket &operator=(const LocalSocket &) = delete;
+
+    //  ,    , 
+    static LocalSocket listen(const std::string &path);
+    static LocalSocket connect(const std::string &path);
+
+    //   
+    LocalSocket accept();
+
+    bool isOpen() const;
+
+    //    ,       
+    static const size_t maxLineLength = 64 * 1024;
+
+    //    '\n',   .  false,   
+    //  '\n'    maxLineLength ,  std::runtime_error
+    bool readLine(std::string &line);
+    bool readBytes(void *data, size_t size);
+
+    //   ,     
+    bool hasPendingData();
+
+    void write(const void *data, size_t size);
+    void write(const std::string &text);
+
+    void close();
+
+private:
+    intptr_t    handle;
+    //   ,     
+    std::string received;
+    //    - ,    
+    std::string path;
+
+    explicit LocalSocket(intptr_t handle);
+
+    // false,   
+    bool receiveMore();
+};
\ No newline at end of file
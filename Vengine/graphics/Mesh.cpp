@@ -1,5 +1,24 @@
 #include "Mesh.h"
 
+#include <algorithm>
+
+#include "MeshSimplifier.h"
+#include "MeshletBuilder.h"
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+//       
+static const size_t minLodTriangleCount = 64;
+
+//        
+static const float lodReduction = 0.5f;
+
+//            
+static const size_t minMeshletTriangleCount = 4096;
+
+///////////////////////// STATIC END //////////////////////////////
+
+
 ///////////////////////// MESH BEG //////////////////////////////
 
 Mesh::Mesh(std::string path)
@@ -10,6 +29,82 @@ Mesh::Mesh(std::string path)
 void Mesh::loadFromFile(std::string path)
 {
     VengineTools::loadMesh(path, vertices, indices);
+    computeBounds();
+    generateMeshlets();
+    generateLods();
+}
+
+void Mesh::computeBounds()
+{
+    if(vertices.empty())
+    {
+        box    = BoundingBox();
+        sphere = BoundingSphere();
+        return;
+    }
+
+    box.min = vertices[0].pos;
+    box.max = vertices[0].pos;
+
+    for(const Vertex &vertex : vertices)
+    {
+        box.min = glm::min(box.min, vertex.pos);
+        box.max = glm::max(box.max, vertex.pos);
+    }
+
+    //      .    ,
+    //        
+    sphere.center = (box.min + box.max) * 0.5f;
+    sphere.radius = 0.0f;
+
+    for(const Vertex &vertex : vertices)
+        sphere.radius = std::max(sphere.radius, glm::length(vertex.pos - sphere.center));
+}
+
+void Mesh::generateMeshlets()
+{
+    meshlets.clear();
+
+    if(indices.size() / 3 < minMeshletTriangleCount)
+        return;
+
+    VengineTools::buildMeshlets(vertices, indices, meshlets);
+}
+
+void Mesh::generateLods()
+{
+    lods.clear();
+    lods.reserve(maxLodCount - 1);
+
+    float error = 0.0f;
+    for(uint32_t level = 1; level < maxLodCount; level++)
+    {
+        //     ,      
+        //    ,    
+        const std::vector<uint32_t> &source = lods.empty() ? indices : lods.back().indices;
+
+        size_t targetIndexCount = static_cast<size_t>(source.size() / 3 * lodReduction) * 3;
+        if(targetIndexCount < minLodTriangleCount * 3)
+            break;
+
+        float levelError = 0.0f;
+        std::vector<uint32_t> simplified = VengineTools::simplifyMesh(vertices,
+                                                                      source,
+                                                                      targetIndexCount,
+                                                                      levelError);
+
+        //      ,        
+        if(simplified.size() > source.size() * 0.9f)
+            break;
+
+        //     ,   
+        error += levelError;
+
+        MeshLod lod;
+        lod.indices = std::move(simplified);
+        lod.error   = error;
+        lods.push_back(std::move(lod));
+    }
 }
 
 ///////////////////////// MESH END //////////////////////////////
\ No newline at end of file
@@ -7,15 +7,73 @@
 
 #include "tools.h"
 
+//  ,   
+struct BoundingBox
+{
+    glm::vec3 min = glm::vec3(0.0f, 0.0f, 0.0f);
+    glm::vec3 max = glm::vec3(0.0f, 0.0f, 0.0f);
+};
+
+struct BoundingSphere
+{
+    glm::vec3 center = glm::vec3(0.0f, 0.0f, 0.0f);
+    //        
+    float     radius = -1.0f;
+};
+
+//   .     ,    
+struct MeshLod
+{
+    std::vector<uint32_t> indices;
+    //        
+    float                 error = 0.0f;
+};
+
+/*
+*     
+*  ,            
+*/
+struct Meshlet
+{
+    uint32_t       firstIndex;    //     Mesh::indices
+    uint32_t       triangleCount;
+
+    BoundingSphere sphere;        //   
+    //        coneAxis. coneCutoff - 
+    //    ,   1     
+    glm::vec3      coneAxis;
+    float          coneCutoff;
+};
+
 class Mesh
 {
 public:
     std::vector<Vertex>   vertices;
     std::vector<uint32_t> indices;
 
+    //    .     
+    //    ,      computeBounds
+    BoundingBox    box;
+    BoundingSphere sphere;
+
+    //      ,    
+    //     ,       generateLods
+    std::vector<MeshLod> lods;
+
+    //        
+    static const uint32_t maxLodCount = 4;
+
+    //   .       ,
+    //           
+    std::vector<Meshlet> meshlets;
+
     Mesh() = default;
     Mesh(std::string path);
 
     void loadFromFile(std::string path);
+    void computeBounds();
+    void generateLods();
+    //   indices ,      
+    void generateMeshlets();
 };
 
@@ -0,0 +1,599 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+//             
+static const double boundaryWeight = 10.0;
+
+//   ,       
+static const uint32_t maxPassCount = 100;
+
+enum class VertexKind
+{
+    MANIFOLD = 0, //  ,     
+    BORDER   = 1, //   ,    
+    SEAM     = 2, //       ,    
+    LOCKED   = 3  //  
+};
+
+/*
+*  -   4x4,         
+*    ,     ,
+*           
+*/
+struct Quadric
+{
+    double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+    double a11 = 0.0, a12 = 0.0, a13 = 0.0;
+    double a22 = 0.0, a23 = 0.0;
+    double a33 = 0.0;
+
+    double weight = 0.0;
+};
+
+struct Collapse
+{
+    double   error;
+    uint32_t from;
+    uint32_t to;
+};
+
+//          
+struct Adjacency
+{
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> triangles;
+};
+
+static Quadric makePlaneQuadric(const glm::vec3 &normal, const glm::vec3 &point, double weight)
+{
+    double a = normal.x;
+    double b = normal.y;
+    double c = normal.z;
+    double d = -(a * point.x + b * point.y + c * point.z);
+
+    Quadric quadric;
+    quadric.a00 = a * a * weight; quadric.a01 = a * b * weight; quadric.a02 = a * c * weight; quadric.a03 = a * d * weight;
+    quadric.a11 = b * b * weight; quadric.a12 = b * c * weight; quadric.a13 = b * d * weight;
+    quadric.a22 = c * c * weight; quadric.a23 = c * d * weight;
+    quadric.a33 = d * d * weight;
+
+    quadric.weight = weight;
+
+    return quadric;
+}
+
+static void addQuadric(Quadric &target, const Quadric &source)
+{
+    target.a00 += source.a00; target.a01 += source.a01; target.a02 += source.a02; target.a03 += source.a03;
+    target.a11 += source.a11; target.a12 += source.a12; target.a13 += source.a13;
+    target.a22 += source.a22; target.a23 += source.a23;
+    target.a33 += source.a33;
+
+    target.weight += source.weight;
+}
+
+//        
+static double getQuadricError(const Quadric &quadric, const glm::vec3 &point)
+{
+    double x = point.x;
+    double y = point.y;
+    double z = point.z;
+
+    double error = quadric.a00 * x * x + 2.0 * quadric.a01 * x * y + 2.0 * quadric.a02 * x * z + 2.0 * quadric.a03 * x +
+                   quadric.a11 * y * y + 2.0 * quadric.a12 * y * z + 2.0 * quadric.a13 * y +
+                   quadric.a22 * z * z + 2.0 * quadric.a23 * z +
+                   quadric.a33;
+
+    return quadric.weight > 0.0 ? std::abs(error) / quadric.weight : 0.0;
+}
+
+static glm::vec3 getCross(const glm::vec3 &a, const glm::vec3 &b)
+{
+    return glm::vec3(a.y * b.z - a.z * b.y,
+                     a.z * b.x - a.x * b.z,
+                     a.x * b.y - a.y * b.x);
+}
+
+static float getLength(const glm::vec3 &vector)
+{
+    return std::sqrt(vector.x * vector.x + vector.y * vector.y + vector.z * vector.z);
+}
+
+//   ,     
+static glm::vec3 getTriangleNormal(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c)
+{
+    return getCross(b - a, c - a);
+}
+
+static bool isPositionLess(const Vertex &a, const Vertex &b)
+{
+    if(a.pos.x != b.pos.x) return a.pos.x < b.pos.x;
+    if(a.pos.y != b.pos.y) return a.pos.y < b.pos.y;
+    return a.pos.z < b.pos.z;
+}
+
+static bool isVertexLess(const Vertex &a, const Vertex &b)
+{
+    if(isPositionLess(a, b)) return true;
+    if(isPositionLess(b, a)) return false;
+
+    if(a.texCoord.x != b.texCoord.x) return a.texCoord.x < b.texCoord.x;
+    if(a.texCoord.y != b.texCoord.y) return a.texCoord.y < b.texCoord.y;
+    if(a.color.x    != b.color.x)    return a.color.x    < b.color.x;
+    if(a.color.y    != b.color.y)    return a.color.y    < b.color.y;
+    return a.color.z < b.color.z;
+}
+
+// remap[i] -   ,   i    less
+template<typename Less>
+static std::vector<uint32_t> buildRemap(const std::vector<Vertex> &vertices, Less less)
+{
+    std::vector<uint32_t> order(vertices.size());
+    for(uint32_t i = 0; i < order.size(); i++)
+        order[i] = i;
+
+    std::sort(order.begin(), order.end(),
+              [&](uint32_t a, uint32_t b)
+              {
+                  if(less(vertices[a], vertices[b])) return true;
+                  if(less(vertices[b], vertices[a])) return false;
+                  return a < b;
+              });
+
+    std::vector<uint32_t> remap(vertices.size());
+    for(size_t i = 0; i < order.size(); i++)
+    {
+        bool sameAsPrevious = i > 0 && !less(vertices[order[i - 1]], vertices[order[i]]);
+        remap[order[i]] = sameAsPrevious ? remap[order[i - 1]] : order[i];
+    }
+
+    return remap;
+}
+
+static void buildAdjacency(const std::vector<uint32_t> &indices,
+                           size_t                       vertexCount,
+                           Adjacency                   &adjacency)
+{
+    adjacency.offsets.assign(vertexCount + 1, 0);
+    for(uint32_t index : indices)
+        adjacency.offsets[index + 1]++;
+
+    for(size_t i = 0; i < vertexCount; i++)
+        adjacency.offsets[i + 1] += adjacency.offsets[i];
+
+    std::vector<uint32_t> cursor(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+
+    adjacency.triangles.resize(indices.size());
+    for(size_t i = 0; i < indices.size(); i++)
+        adjacency.triangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+}
+
+// ,   vertex       
+static uint32_t getNextCorner(const std::vector<uint32_t> &indices, uint32_t triangle, uint32_t vertex)
+{
+    const uint32_t *corners = &indices[triangle * 3];
+
+    if(corners[0] == vertex) return corners[1];
+    if(corners[1] == vertex) return corners[2];
+    return corners[0];
+}
+
+static bool hasEdge(const Adjacency             &adjacency,
+                    const std::vector<uint32_t> &indices,
+                    uint32_t                     from,
+                    uint32_t                     to)
+{
+    for(uint32_t i = adjacency.offsets[from]; i < adjacency.offsets[from + 1]; i++)
+        if(getNextCorner(indices, adjacency.triangles[i], from) == to)
+            return true;
+
+    return false;
+}
+
+//     ,   ,      
+static bool hasPositionalEdge(const Adjacency             &adjacency,
+                              const std::vector<uint32_t> &indices,
+                              const std::vector<uint32_t> &positionRemap,
+                              const std::vector<uint32_t> &wedges,
+                              uint32_t                     from,
+                              uint32_t                     to)
+{
+    uint32_t wedge = from;
+    do
+    {
+        for(uint32_t i = adjacency.offsets[wedge]; i < adjacency.offsets[wedge + 1]; i++)
+            if(positionRemap[getNextCorner(indices, adjacency.triangles[i], wedge)] == to)
+                return true;
+
+        wedge = wedges[wedge];
+    }
+    while(wedge != from);
+
+    return false;
+}
+
+static std::vector<VertexKind> classifyVertices(const Adjacency             &adjacency,
+                                                const std::vector<uint32_t> &indices,
+                                                const std::vector<uint32_t> &positionRemap,
+                                                const std::vector<uint32_t> &wedges,
+                                                std::vector<bool>           &openVertices)
+{
+    size_t vertexCount = positionRemap.size();
+
+    //     ,         
+    openVertices.assign(vertexCount, false);
+    for(size_t i = 0; i < indices.size(); i++)
+    {
+        uint32_t from = indices[i];
+        uint32_t to   = indices[i - i % 3 + (i + 1) % 3];
+
+        if(!hasPositionalEdge(adjacency, indices, positionRemap, wedges, positionRemap[to], positionRemap[from]))
+        {
+            openVertices[positionRemap[from]] = true;
+            openVertices[positionRemap[to]]   = true;
+        }
+    }
+
+    std::vector<VertexKind> kinds(vertexCount, VertexKind::LOCKED);
+    for(uint32_t vertex = 0; vertex < vertexCount; vertex++)
+    {
+        uint32_t wedgeCount = 1;
+        for(uint32_t wedge = wedges[vertex]; wedge != vertex; wedge = wedges[wedge])
+            wedgeCount++;
+
+        bool open = openVertices[positionRemap[vertex]];
+
+        if(wedgeCount == 1)
+            kinds[vertex] = open ? VertexKind::BORDER : VertexKind::MANIFOLD;
+        else if(wedgeCount == 2 && !open)
+            kinds[vertex] = VertexKind::SEAM;
+    }
+
+    return kinds;
+}
+
+static void addTriangleQuadrics(const std::vector<Vertex>   &vertices,
+                                const std::vector<uint32_t> &indices,
+                                const std::vector<uint32_t> &positionRemap,
+                                std::vector<Quadric>        &quadrics)
+{
+    for(size_t i = 0; i < indices.size(); i += 3)
+    {
+        const glm::vec3 &a = vertices[indices[i + 0]].pos;
+        const glm::vec3 &b = vertices[indices[i + 1]].pos;
+        const glm::vec3 &c = vertices[indices[i + 2]].pos;
+
+        glm::vec3 normal = getTriangleNormal(a, b, c);
+        float     length = getLength(normal);
+
+        if(length == 0.0f)
+            continue;
+
+        Quadric quadric = makePlaneQuadric(normal / length, a, length * 0.5);
+
+        for(int corner = 0; corner < 3; corner++)
+            addQuadric(quadrics[positionRemap[indices[i + corner]]], quadric);
+    }
+}
+
+//       ,    
+//  .              
+static void addBoundaryQuadrics(const std::vector<Vertex>   &vertices,
+                                const std::vector<uint32_t> &indices,
+                                const Adjacency             &adjacency,
+                                const std::vector<uint32_t> &positionRemap,
+                                std::vector<Quadric>        &quadrics)
+{
+    for(size_t i = 0; i < indices.size(); i++)
+    {
+        size_t   triangle = i - i % 3;
+        uint32_t from     = indices[i];
+        uint32_t to       = indices[triangle + (i + 1) % 3];
+        uint32_t other    = indices[triangle + (i + 2) % 3];
+
+        //            
+        if(hasEdge(adjacency, indices, to, from))
+            continue;
+
+        const glm::vec3 &a = vertices[from].pos;
+        const glm::vec3 &b = vertices[to].pos;
+
+        glm::vec3 edgeNormal = getCross(b - a, getTriangleNormal(a, b, vertices[other].pos));
+        float     length     = getLength(edgeNormal);
+
+        if(length == 0.0f)
+            continue;
+
+        glm::vec3 edge   = b - a;
+        double    weight = (edge.x * edge.x + edge.y * edge.y + edge.z * edge.z) * boundaryWeight;
+
+        Quadric quadric = makePlaneQuadric(edgeNormal / length, a, weight);
+
+        addQuadric(quadrics[positionRemap[from]], quadric);
+        addQuadric(quadrics[positionRemap[to]],   quadric);
+    }
+}
+
+//   ,   
+static uint32_t getOtherWedge(const std::vector<uint32_t> &wedges, uint32_t vertex)
+{
+    return wedges[vertex];
+}
+
+static bool canCollapse(const std::vector<VertexKind>  &kinds,
+                        const Adjacency                &adjacency,
+                        const std::vector<uint32_t>    &indices,
+                        const std::vector<uint32_t>    &positionRemap,
+                        const std::vector<uint32_t>    &wedges,
+                        uint32_t                        from,
+                        uint32_t                        to)
+{
+    switch(kinds[from])
+    {
+    case VertexKind::MANIFOLD:
+        return true;
+
+    case VertexKind::BORDER:
+        //    ,     
+        return (kinds[to] == VertexKind::BORDER || kinds[to] == VertexKind::LOCKED) &&
+               (!hasPositionalEdge(adjacency, indices, positionRemap, wedges, positionRemap[to], positionRemap[from]) ||
+                !hasPositionalEdge(adjacency, indices, positionRemap, wedges, positionRemap[from], positionRemap[to]));
+
+    case VertexKind::SEAM:
+    {
+        if(kinds[to] != VertexKind::SEAM)
+            return false;
+
+        //        
+        bool forward  = hasEdge(adjacency, indices, from, to);
+        bool backward = hasEdge(adjacency, indices, to, from);
+        if(forward == backward)
+            return false;
+
+        //            
+        uint32_t otherFrom = getOtherWedge(wedges, from);
+        uint32_t otherTo   = getOtherWedge(wedges, to);
+
+        return hasEdge(adjacency, indices, otherFrom, otherTo) ||
+               hasEdge(adjacency, indices, otherTo,   otherFrom);
+    }
+
+    default:
+        return false;
+    }
+}
+
+//        from
+static bool isCollapseFlipping(const std::vector<Vertex>   &vertices,
+                               const std::vector<uint32_t> &indices,
+                               const Adjacency             &adjacency,
+                               const std::vector<uint32_t> &positionRemap,
+                               const std::vector<uint32_t> &wedges,
+                               const std::vector<uint32_t> &collapseRemap,
+                               uint32_t                     from,
+                               uint32_t                     to)
+{
+    const glm::vec3 &target = vertices[to].pos;
+
+    uint32_t wedge = from;
+    do
+    {
+        for(uint32_t i = adjacency.offsets[wedge]; i < adjacency.offsets[wedge + 1]; i++)
+        {
+            const uint32_t *corners = &indices[adjacency.triangles[i] * 3];
+
+            // ,     ,     
+            glm::vec3 before[3];
+            glm::vec3 after[3];
+            bool      degenerate = false;
+
+            for(int corner = 0; corner < 3; corner++)
+            {
+                uint32_t vertex = collapseRemap[corners[corner]];
+
+                before[corner] = vertices[vertex].pos;
+                after[corner]  = positionRemap[corners[corner]] == positionRemap[from] ? target : before[corner];
+
+                //    from-to   
+                if(positionRemap[vertex] == positionRemap[to])
+                    degenerate = true;
+            }
+
+            if(degenerate)
+                continue;
+
+            glm::vec3 normalBefore = getTriangleNormal(before[0], before[1], before[2]);
+            glm::vec3 normalAfter  = getTriangleNormal(after[0],  after[1],  after[2]);
+
+            float dot = normalBefore.x * normalAfter.x +
+                        normalBefore.y * normalAfter.y +
+                        normalBefore.z * normalAfter.z;
+
+            if(dot <= 0.0f)
+                return true;
+        }
+
+        wedge = wedges[wedge];
+    }
+    while(wedge != from);
+
+    return false;
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// MESH SIMPLIFIER BEG //////////////////////////////
+
+namespace VengineTools
+{
+    std::vector<uint32_t> buildVertexRemap(const std::vector<Vertex> &vertices)
+    {
+        return buildRemap(vertices, isVertexLess);
+    }
+
+    std::vector<uint32_t> simplifyMesh(const std::vector<Vertex>   &vertices,
+                                       const std::vector<uint32_t> &indices,
+                                       size_t                       targetIndexCount,
+                                       float                       &resultError)
+    {
+        resultError = 0.0f;
+
+        //              
+        std::vector<uint32_t> vertexRemap   = buildVertexRemap(vertices);
+        std::vector<uint32_t> positionRemap = buildRemap(vertices, isPositionLess);
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+
+        for(size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            uint32_t a = vertexRemap[indices[i + 0]];
+            uint32_t b = vertexRemap[indices[i + 1]];
+            uint32_t c = vertexRemap[indices[i + 2]];
+
+            if(positionRemap[a] == positionRemap[b] ||
+               positionRemap[b] == positionRemap[c] ||
+               positionRemap[c] == positionRemap[a])
+                continue;
+
+            result.push_back(a);
+            result.push_back(b);
+            result.push_back(c);
+        }
+
+        if(result.size() <= targetIndexCount)
+            return result;
+
+        size_t vertexCount = vertices.size();
+
+        //    ,       
+        std::vector<uint32_t> wedges(vertexCount);
+        for(uint32_t i = 0; i < vertexCount; i++)
+            wedges[i] = i;
+
+        for(uint32_t i = 0; i < vertexCount; i++)
+        {
+            if(vertexRemap[i] != i || positionRemap[i] == i)
+                continue;
+
+            uint32_t first = positionRemap[i];
+            wedges[i]      = wedges[first];
+            wedges[first]  = i;
+        }
+
+        Adjacency adjacency;
+        buildAdjacency(result, vertexCount, adjacency);
+
+        std::vector<bool>       openVertices;
+        std::vector<VertexKind> kinds = classifyVertices(adjacency, result, positionRemap, wedges, openVertices);
+
+        //    ,       
+        std::vector<Quadric> quadrics(vertexCount);
+        addTriangleQuadrics(vertices, result, positionRemap, quadrics);
+        addBoundaryQuadrics(vertices, result, adjacency, positionRemap, quadrics);
+
+        std::vector<Collapse> collapses;
+        std::vector<uint32_t> collapseRemap(vertexCount);
+        std::vector<bool>     collapseLocked(vertexCount);
+
+        double maxError = 0.0;
+
+        for(uint32_t pass = 0; pass < maxPassCount && result.size() > targetIndexCount; pass++)
+        {
+            if(pass > 0)
+                buildAdjacency(result, vertexCount, adjacency);
+
+            collapses.clear();
+            for(size_t i = 0; i < result.size(); i++)
+            {
+                uint32_t a = result[i];
+                uint32_t b = result[i - i % 3 + (i + 1) % 3];
+
+                Quadric quadric = quadrics[positionRemap[a]];
+                addQuadric(quadric, quadrics[positionRemap[b]]);
+
+                if(canCollapse(kinds, adjacency, result, positionRemap, wedges, a, b))
+                    collapses.push_back({getQuadricError(quadric, vertices[b].pos), a, b});
+
+                if(canCollapse(kinds, adjacency, result, positionRemap, wedges, b, a))
+                    collapses.push_back({getQuadricError(quadric, vertices[a].pos), b, a});
+            }
+
+            std::sort(collapses.begin(), collapses.end(),
+                      [](const Collapse &a, const Collapse &b) { return a.error < b.error; });
+
+            for(uint32_t i = 0; i < vertexCount; i++)
+                collapseRemap[i] = i;
+
+            collapseLocked.assign(vertexCount, false);
+
+            //     .   
+            //      
+            size_t removeLimit   = (result.size() - targetIndexCount) / 3;
+            size_t removeCount   = 0;
+            size_t collapseCount = 0;
+
+            for(const Collapse &collapse : collapses)
+            {
+                if(removeCount >= removeLimit)
+                    break;
+
+                uint32_t fromPosition = positionRemap[collapse.from];
+                uint32_t toPosition   = positionRemap[collapse.to];
+
+                //          
+                if(collapseLocked[fromPosition] || collapseLocked[toPosition])
+                    continue;
+
+                if(isCollapseFlipping(vertices, result, adjacency, positionRemap, wedges, collapseRemap, collapse.from, collapse.to))
+                    continue;
+
+                collapseRemap[collapse.from] = collapse.to;
+                if(kinds[collapse.from] == VertexKind::SEAM)
+                    collapseRemap[getOtherWedge(wedges, collapse.from)] = getOtherWedge(wedges, collapse.to);
+
+                addQuadric(quadrics[toPosition], quadrics[fromPosition]);
+
+                collapseLocked[fromPosition] = true;
+                collapseLocked[toPosition]   = true;
+
+                maxError = std::max(maxError, collapse.error);
+                removeCount += kinds[collapse.from] == VertexKind::MANIFOLD ? 2 : 1;
+                collapseCount++;
+            }
+
+            if(collapseCount == 0)
+                break;
+
+            //   ,     
+            size_t writeIndex = 0;
+            for(size_t i = 0; i < result.size(); i += 3)
+            {
+                uint32_t a = collapseRemap[result[i + 0]];
+                uint32_t b = collapseRemap[result[i + 1]];
+                uint32_t c = collapseRemap[result[i + 2]];
+
+                if(positionRemap[a] == positionRemap[b] ||
+                   positionRemap[b] == positionRemap[c] ||
+                   positionRemap[c] == positionRemap[a])
+                    continue;
+
+                result[writeIndex++] = a;
+                result[writeIndex++] = b;
+                result[writeIndex++] = c;
+            }
+            result.resize(writeIndex);
+        }
+
+        resultError = static_cast<float>(std::sqrt(maxError));
+
+        return result;
+    }
+}
+
+///////////////////////// MESH SIMPLIFIER END //////////////////////////////
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "vulkanWrapper/Vertex.h"
+
+#include <vector>
+
+namespace VengineTools
+{
+    // remap[i] -   ,    i   
+    //        ,   
+    //       
+    std::vector<uint32_t> buildVertexRemap(const std::vector<Vertex> &vertices);
+
+    /*
+    *         
+    *     ,     ,   - 
+    *    ,      
+    *        ,    
+    *         ,  ,  
+    *  ,   
+    *  resultError        
+    */
+    std::vector<uint32_t> simplifyMesh(const std::vector<Vertex>   &vertices,
+                                       const std::vector<uint32_t> &indices,
+                                       size_t                       targetIndexCount,
+                                       float                       &resultError);
+}
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "MeshSimplifier.h"
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+//       ~84 ,        
+static const float minConeDot = 0.1f;
+
+static const uint32_t noTriangle = UINT32_MAX;
+
+static glm::vec3 getCross(const glm::vec3 &a, const glm::vec3 &b)
+{
+    return glm::vec3(a.y * b.z - a.z * b.y,
+                     a.z * b.x - a.x * b.z,
+                     a.x * b.y - a.y * b.x);
+}
+
+static float getLength(const glm::vec3 &vector)
+{
+    return std::sqrt(vector.x * vector.x + vector.y * vector.y + vector.z * vector.z);
+}
+
+//  10   ,        
+static uint32_t spreadBits(uint32_t value)
+{
+    value &= 0x3ff;
+    value = (value | (value << 16)) & 0x030000ff;
+    value = (value | (value <<  8)) & 0x0300f00f;
+    value = (value | (value <<  4)) & 0x030c30c3;
+    value = (value | (value <<  2)) & 0x09249249;
+
+    return value;
+}
+
+//     .       
+static uint32_t getMortonCode(const glm::vec3 &point, const glm::vec3 &min, const glm::vec3 &size)
+{
+    uint32_t x = static_cast<uint32_t>(size.x > 0.0f ? (point.x - min.x) / size.x * 1023.0f : 0.0f);
+    uint32_t y = static_cast<uint32_t>(size.y > 0.0f ? (point.y - min.y) / size.y * 1023.0f : 0.0f);
+    uint32_t z = static_cast<uint32_t>(size.z > 0.0f ? (point.z - min.z) / size.z * 1023.0f : 0.0f);
+
+    return spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2);
+}
+
+static void computeMeshletBounds(const std::vector<Vertex>   &vertices,
+                                 const std::vector<uint32_t> &indices,
+                                 Meshlet                     &meshlet)
+{
+    const uint32_t *corners = &indices[meshlet.firstIndex];
+    uint32_t        count   = meshlet.triangleCount * 3;
+
+    glm::vec3 min = vertices[corners[0]].pos;
+    glm::vec3 max = vertices[corners[0]].pos;
+
+    for(uint32_t i = 0; i < count; i++)
+    {
+        min = glm::min(min, vertices[corners[i]].pos);
+        max = glm::max(max, vertices[corners[i]].pos);
+    }
+
+    meshlet.sphere.center = (min + max) * 0.5f;
+    meshlet.sphere.radius = 0.0f;
+
+    for(uint32_t i = 0; i < count; i++)
+        meshlet.sphere.radius = std::max(meshlet.sphere.radius,
+                                         getLength(vertices[corners[i]].pos - meshlet.sphere.center));
+
+    //   -   ,  -    
+    std::vector<glm::vec3> normals;
+    normals.reserve(meshlet.triangleCount);
+
+    glm::vec3 axis(0.0f, 0.0f, 0.0f);
+    for(uint32_t i = 0; i < count; i += 3)
+    {
+        const glm::vec3 &a = vertices[corners[i + 0]].pos;
+        const glm::vec3 &b = vertices[corners[i + 1]].pos;
+        const glm::vec3 &c = vertices[corners[i + 2]].pos;
+
+        glm::vec3 normal = getCross(b - a, c - a);
+        float     length = getLength(normal);
+
+        if(length == 0.0f)
+            continue;
+
+        normals.push_back(normal / length);
+        axis += normals.back();
+    }
+
+    float axisLength = getLength(axis);
+
+    meshlet.coneAxis   = axisLength > 0.0f ? axis / axisLength : glm::vec3(0.0f, 0.0f, 1.0f);
+    meshlet.coneCutoff = 1.0f;
+
+    if(normals.empty() || axisLength == 0.0f)
+        return;
+
+    float minDot = 1.0f;
+    for(const glm::vec3 &normal : normals)
+        minDot = std::min(minDot, normal.x * meshlet.coneAxis.x +
+                                  normal.y * meshlet.coneAxis.y +
+                                  normal.z * meshlet.coneAxis.z);
+
+    //     ,      
+    //    90     
+    if(minDot > minConeDot)
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// MESHLET BUILDER BEG //////////////////////////////
+
+namespace VengineTools
+{
+    void buildMeshlets(const std::vector<Vertex> &vertices,
+                       std::vector<uint32_t>     &indices,
+                       std::vector<Meshlet>      &meshlets)
+    {
+        meshlets.clear();
+
+        uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+        if(triangleCount == 0)
+            return;
+
+        std::vector<uint32_t> remap = buildVertexRemap(vertices);
+
+        //         
+        std::vector<uint32_t> offsets(vertices.size() + 1, 0);
+        for(uint32_t i = 0; i < triangleCount * 3; i++)
+            offsets[remap[indices[i]] + 1]++;
+
+        for(size_t i = 0; i < vertices.size(); i++)
+            offsets[i + 1] += offsets[i];
+
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        std::vector<uint32_t> vertexTriangles(triangleCount * 3);
+        for(uint32_t i = 0; i < triangleCount * 3; i++)
+            vertexTriangles[cursor[remap[indices[i]]]++] = i / 3;
+
+        std::vector<glm::vec3> centroids(triangleCount);
+        for(uint32_t triangle = 0; triangle < triangleCount; triangle++)
+            centroids[triangle] = (vertices[indices[triangle * 3 + 0]].pos +
+                                   vertices[indices[triangle * 3 + 1]].pos +
+                                   vertices[indices[triangle * 3 + 2]].pos) / 3.0f;
+
+        glm::vec3 min = centroids[0];
+        glm::vec3 max = centroids[0];
+        for(const glm::vec3 &centroid : centroids)
+        {
+            min = glm::min(min, centroid);
+            max = glm::max(max, centroid);
+        }
+
+        //           ,
+        //        
+        std::vector<uint32_t> mortonCodes(triangleCount);
+        std::vector<uint32_t> seeds(triangleCount);
+        for(uint32_t triangle = 0; triangle < triangleCount; triangle++)
+        {
+            mortonCodes[triangle] = getMortonCode(centroids[triangle], min, max - min);
+            seeds[triangle]       = triangle;
+        }
+
+        std::sort(seeds.begin(), seeds.end(),
+                  [&](uint32_t a, uint32_t b) { return mortonCodes[a] < mortonCodes[b]; });
+
+        std::vector<bool>     used(triangleCount, false);
+        // ,           
+        std::vector<uint32_t> vertexMeshlet(vertices.size(), UINT32_MAX);
+        std::vector<uint32_t> triangleMeshlet(triangleCount, UINT32_MAX);
+        std::vector<uint32_t> candidates;
+        std::vector<uint32_t> result;
+        result.reserve(triangleCount * 3);
+
+        size_t seedCursor = 0;
+        for(uint32_t meshletIndex = 0; ; meshletIndex++)
+        {
+            Meshlet meshlet{};
+            meshlet.firstIndex = static_cast<uint32_t>(result.size());
+
+            uint32_t  vertexCount = 0;
+            glm::vec3 centroidSum(0.0f, 0.0f, 0.0f);
+
+            candidates.clear();
+
+            while(meshlet.triangleCount < maxMeshletTriangles)
+            {
+                uint32_t best          = noTriangle;
+                uint32_t bestNewCount  = 4;
+                float    bestDistance  = 0.0f;
+
+                if(meshlet.triangleCount == 0)
+                {
+                    while(seedCursor < seeds.size() && used[seeds[seedCursor]])
+                        seedCursor++;
+
+                    if(seedCursor < seeds.size())
+                        best = seeds[seedCursor];
+                }
+                else
+                {
+                    //     ,      ,
+                    //    -    ,    
+                    glm::vec3 center = centroidSum / static_cast<float>(meshlet.triangleCount);
+
+                    size_t writeIndex = 0;
+                    for(uint32_t candidate : candidates)
+                    {
+                        if(used[candidate])
+                            continue;
+
+                        candidates[writeIndex++] = candidate;
+
+                        uint32_t newCount = 0;
+                        for(int corner = 0; corner < 3; corner++)
+                            if(vertexMeshlet[remap[indices[candidate * 3 + corner]]] != meshletIndex)
+                                newCount++;
+
+                        if(vertexCount + newCount > maxMeshletVertices)
+                            continue;
+
+                        glm::vec3 offset   = centroids[candidate] - center;
+                        float     distance = offset.x * offset.x + offset.y * offset.y + offset.z * offset.z;
+
+                        if(newCount < bestNewCount || (newCount == bestNewCount && distance < bestDistance))
+                        {
+                            best         = candidate;
+                            bestNewCount = newCount;
+                            bestDistance = distance;
+                        }
+                    }
+                    candidates.resize(writeIndex);
+                }
+
+                if(best == noTriangle)
+                    break;
+
+                used[best] = true;
+                centroidSum += centroids[best];
+                meshlet.triangleCount++;
+
+                for(int corner = 0; corner < 3; corner++)
+                {
+                    uint32_t vertex = remap[indices[best * 3 + corner]];
+
+                    //        
+                    result.push_back(vertex);
+
+                    if(vertexMeshlet[vertex] == meshletIndex)
+                        continue;
+
+                    vertexMeshlet[vertex] = meshletIndex;
+                    vertexCount++;
+
+                    for(uint32_t i = offsets[vertex]; i < offsets[vertex + 1]; i++)
+                    {
+                        uint32_t triangle = vertexTriangles[i];
+
+                        if(used[triangle] || triangleMeshlet[triangle] == meshletIndex)
+                            continue;
+
+                        triangleMeshlet[triangle] = meshletIndex;
+                        candidates.push_back(triangle);
+                    }
+                }
+            }
+
+            if(meshlet.triangleCount == 0)
+                break;
+
+            computeMeshletBounds(vertices, result, meshlet);
+            meshlets.push_back(meshlet);
+        }
+
+        indices = std::move(result);
+    }
+}
+
+///////////////////////// MESHLET BUILDER END //////////////////////////////
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vector>
+
+#include "Mesh.h"
+
+namespace VengineTools
+{
+    //   .     mesh shader, 
+    //     ,       vkCmdDrawIndexed
+    const uint32_t maxMeshletVertices  = 64;
+    const uint32_t maxMeshletTriangles = 124;
+
+    /*
+    *           
+    *     
+    *   indices  ,      ,
+    *    ,      
+    */
+    void buildMeshlets(const std::vector<Vertex> &vertices,
+                       std::vector<uint32_t>     &indices,
+                       std::vector<Meshlet>      &meshlets);
+}
\ No newline at end of file
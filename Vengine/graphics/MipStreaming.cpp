@@ -0,0 +1,199 @@
+#include "MipStreaming.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+//          
+static const uint32_t startSize = 64;
+
+//        
+static const uint64_t dropDelay = 120;
+
+//   ,        requestedSize
+static uint32_t findRequestedBase(uint32_t longSide, uint32_t levelCount, uint32_t requestedSize)
+{
+    uint32_t base = 0;
+    while(base + 1 < levelCount && (longSide >> (base + 1)) >= requestedSize)
+        base++;
+
+    return base;
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// MIP LEVEL BEG //////////////////////////////
+
+MipLevel downsampleMipLevel(const Pixel *pixels, uint32_t width, uint32_t height)
+{
+    MipLevel level;
+    level.width  = std::max(width  / 2, 1u);
+    level.height = std::max(height / 2, 1u);
+    level.pixels.resize(level.width * level.height);
+
+    for(uint32_t y = 0; y < level.height; y++)
+        for(uint32_t x = 0; x < level.width; x++)
+        {
+            uint32_t x0 = std::min(x * 2, width  - 1);
+            uint32_t y0 = std::min(y * 2, height - 1);
+            uint32_t x1 = std::min(x0 + 1, width  - 1);
+            uint32_t y1 = std::min(y0 + 1, height - 1);
+
+            const Pixel *quad[4] = {
+                &pixels[y0 * width + x0],
+                &pixels[y0 * width + x1],
+                &pixels[y1 * width + x0],
+                &pixels[y1 * width + x1]
+            };
+
+            uint32_t r = 0, g = 0, b = 0, a = 0;
+            for(const Pixel *pixel : quad)
+            {
+                r += pixel->r;
+                g += pixel->g;
+                b += pixel->b;
+                a += pixel->a;
+            }
+
+            level.pixels[y * level.width + x] = Pixel{
+                static_cast<unsigned char>((r + 2) / 4),
+                static_cast<unsigned char>((g + 2) / 4),
+                static_cast<unsigned char>((b + 2) / 4),
+                static_cast<unsigned char>((a + 2) / 4)
+            };
+        }
+
+    return level;
+}
+
+///////////////////////// MIP LEVEL END //////////////////////////////
+
+
+///////////////////////// MIP STREAMING BEG //////////////////////////////
+
+void MipStreaming::setTexture(TextureHandle texture, Texture &source, bool streaming)
+{
+    if(texture >= entries.size())
+        entries.resize(texture + 1);
+
+    Entry &entry = entries[texture];
+    entry.streaming = streaming;
+    entry.width     = source.getWidth();
+    entry.height    = source.getHeight();
+    entry.levels.clear();
+
+    const Pixel *pixels = source.pixels.data();
+    uint32_t     width  = entry.width;
+    uint32_t     height = entry.height;
+    while(width > 1 || height > 1)
+    {
+        entry.levels.push_back(downsampleMipLevel(pixels, width, height));
+
+        pixels = entry.levels.back().pixels.data();
+        width  = entry.levels.back().width;
+        height = entry.levels.back().height;
+    }
+
+    uint32_t levelCount = getLevelCount(texture);
+    uint32_t longSide   = std::max(entry.width, entry.height);
+
+    entry.residentBase = 0;
+    while(streaming && entry.residentBase + 1 < levelCount && (longSide >> entry.residentBase) > startSize)
+        entry.residentBase++;
+
+    entry.requestedBase = entry.residentBase;
+    entry.requestFrame  = 0;
+}
+
+void MipStreaming::clear()
+{
+    entries.clear();
+}
+
+uint32_t MipStreaming::getLevelCount(TextureHandle texture) const
+{
+    return static_cast<uint32_t>(entries[texture].levels.size()) + 1;
+}
+
+uint32_t MipStreaming::getResidentBase(TextureHandle texture) const
+{
+    return entries[texture].residentBase;
+}
+
+void MipStreaming::setResidentBase(TextureHandle texture, uint32_t base)
+{
+    Entry &entry = entries[texture];
+
+    if(base < entry.residentBase)
+        refinements++;
+    else if(base > entry.residentBase)
+        drops++;
+
+    entry.residentBase = base;
+}
+
+const MipLevel &MipStreaming::getLevel(TextureHandle texture, uint32_t level) const
+{
+    if(level == 0 || level >= getLevelCount(texture))
+        throw std::out_of_range("failed to get texture mip level!");
+
+    return entries[texture].levels[level - 1];
+}
+
+void MipStreaming::addFeedback(const uint32_t *requestedSizes, size_t count, uint64_t frame)
+{
+    count = std::min(count, entries.size());
+
+    for(size_t texture = 0; texture < count; texture++)
+    {
+        Entry &entry = entries[texture];
+        if(!entry.streaming || requestedSizes[texture] == 0)
+            continue;
+
+        uint32_t base = findRequestedBase(std::max(entry.width, entry.height),
+                                          getLevelCount(static_cast<TextureHandle>(texture)),
+                                          requestedSizes[texture]);
+
+        //     ,    
+        if(base <= entry.requestedBase || frame - entry.requestFrame > dropDelay)
+        {
+            entry.requestedBase = base;
+            entry.requestFrame  = frame;
+        }
+    }
+}
+
+void MipStreaming::chooseChanges(std::vector<Change> &changes) const
+{
+    changes.clear();
+
+    for(TextureHandle texture = 0; texture < entries.size(); texture++)
+    {
+        const Entry &entry = entries[texture];
+        //      requestedBase   dropDelay 
+        //  ,       
+        if(!entry.streaming || entry.requestedBase == entry.residentBase)
+            continue;
+
+        changes.push_back(Change{texture, entry.requestedBase});
+    }
+}
+
+MipStreaming::Stats MipStreaming::getStats() const
+{
+    Stats stats{};
+    stats.refinements = refinements;
+    stats.drops       = drops;
+
+    for(TextureHandle texture = 0; texture < entries.size(); texture++)
+    {
+        stats.totalLevels    += getLevelCount(texture);
+        stats.residentLevels += getLevelCount(texture) - entries[texture].residentBase;
+    }
+
+    return stats;
+}
+
+///////////////////////// MIP STREAMING END //////////////////////////////
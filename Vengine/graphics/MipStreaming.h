@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Pixel.h"
+#include "Texture.h"
+#include "Scene.h"
+
+//     
+struct MipLevel
+{
+    uint32_t           width;
+    uint32_t           height;
+    std::vector<Pixel> pixels;
+};
+
+//      ,   2x2 
+//         
+MipLevel downsampleMipLevel(const Pixel *pixels, uint32_t width, uint32_t height);
+
+/*
+*        
+*       ,    .
+*       ,      
+*    1x1.     ,    ,
+*   ,      dropDelay 
+*     ,       ,    
+*/
+class MipStreaming
+{
+public:
+    //    ,     
+    struct Change
+    {
+        TextureHandle texture;
+        uint32_t      base;
+    };
+
+    struct Stats
+    {
+        //        
+        uint32_t residentLevels;
+        uint32_t totalLevels;
+        //   
+        uint64_t refinements;
+        uint64_t drops;
+    };
+
+    //   .         startSize,
+    //    ,      
+    void setTexture(TextureHandle texture, Texture &source, bool streaming);
+    void clear();
+
+    uint32_t getLevelCount  (TextureHandle texture) const;
+    uint32_t getResidentBase(TextureHandle texture) const;
+    void     setResidentBase(TextureHandle texture, uint32_t base);
+
+    //  1  .  0 -   
+    const MipLevel &getLevel(TextureHandle texture, uint32_t level) const;
+
+    // requestedSizes[i] -     i, 0 -   
+    void addFeedback(const uint32_t *requestedSizes, size_t count, uint64_t frame);
+
+    // ,          
+    void chooseChanges(std::vector<Change> &changes) const;
+
+    Stats getStats() const;
+
+private:
+    struct Entry
+    {
+        bool                  streaming     = false;
+        uint32_t              width         = 0;
+        uint32_t              height        = 0;
+        // levels[i] -  i + 1
+        std::vector<MipLevel> levels;
+        uint32_t              residentBase  = 0;
+        //   ,     requestFrame
+        uint32_t              requestedBase = 0;
+        uint64_t              requestFrame  = 0;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t           refinements = 0;
+    uint64_t           drops       = 0;
+};
@@ -0,0 +1,265 @@
+#include "Profiler.h"
+
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+using Clock = Profiler::Clock;
+
+//      .   
+static const uint64_t eventsPerThread = 65536;
+
+struct ProfileEvent
+{
+    const char        *name;
+    Clock::time_point  begin;
+    Clock::time_point  end;
+};
+
+/*
+*     . sequence   seqlock:   -
+*  , 2 * (  + 1) -       
+*  ,        ,   
+*/
+struct ProfileSlot
+{
+    std::atomic<uint64_t>     sequence{0};
+    std::atomic<const char *> name{nullptr};
+    std::atomic<Clock::rep>   begin{0};
+    std::atomic<Clock::rep>   end{0};
+};
+
+/*
+*     ,   .      
+*   ,     
+*/
+struct ThreadEvents
+{
+    uint32_t                  threadId;
+    std::vector<ProfileSlot>  slots;
+    std::atomic<uint64_t>     written{0};
+
+    ThreadEvents() : slots(eventsPerThread) {}
+};
+
+static std::atomic<bool>                          enabled{false};
+static const Clock::time_point                    traceEpoch = Clock::now();
+
+//     .     
+static std::mutex                                 threadsMutex;
+static std::vector<std::unique_ptr<ThreadEvents>> threads;
+//   .     ,  
+//  ,  ,    
+static std::vector<ThreadEvents *>                freeThreads;
+
+//    freeThreads,    .      
+struct ThreadEventsOwner
+{
+    ThreadEvents *threadEvents = nullptr;
+
+    ~ThreadEventsOwner()
+    {
+        if(!threadEvents)
+            return;
+
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        freeThreads.push_back(threadEvents);
+    }
+};
+
+static ThreadEvents &getThreadEvents()
+{
+    thread_local ThreadEventsOwner owner;
+
+    if(!owner.threadEvents)
+    {
+        {
+            std::lock_guard<std::mutex> lock(threadsMutex);
+
+            if(!freeThreads.empty())
+            {
+                owner.threadEvents = freeThreads.back();
+                freeThreads.pop_back();
+                return *owner.threadEvents;
+            }
+        }
+
+        //  ,    
+        std::unique_ptr<ThreadEvents> newEvents(new ThreadEvents());
+
+        std::lock_guard<std::mutex> lock(threadsMutex);
+
+        newEvents->threadId = static_cast<uint32_t>(threads.size() + 1);
+        owner.threadEvents  = newEvents.get();
+        threads.push_back(std::move(newEvents));
+    }
+
+    return *owner.threadEvents;
+}
+
+static std::vector<ProfileEvent> copyEvents(const ThreadEvents &threadEvents)
+{
+    uint64_t written = threadEvents.written.load(std::memory_order_acquire);
+    uint64_t first   = written > eventsPerThread ? written - eventsPerThread : 0;
+
+    std::vector<ProfileEvent> events;
+    for(uint64_t i = first; i < written; i++)
+    {
+        const ProfileSlot &slot = threadEvents.slots[i % eventsPerThread];
+
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+        ProfileEvent event;
+        event.name  = slot.name.load(std::memory_order_relaxed);
+        event.begin = Clock::time_point(Clock::duration(slot.begin.load(std::memory_order_relaxed)));
+        event.end   = Clock::time_point(Clock::duration(slot.end.load(std::memory_order_relaxed)));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        //   ,          
+        if(sequence != 2 * i + 2 || slot.sequence.load(std::memory_order_relaxed) != sequence)
+            continue;
+
+        events.push_back(event);
+    }
+
+    return events;
+}
+
+static double toTraceMicroseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+static std::string escapeJson(const std::string &text)
+{
+    std::string escaped;
+    for(char symbol : text)
+    {
+        if(symbol == '"' || symbol == '\\')
+            escaped += '\\';
+
+        escaped += symbol;
+    }
+
+    return escaped;
+}
+
+static void writeEvent(std::ofstream     &file,
+                       const std::string &name,
+                       const char        *category,
+                       uint32_t           threadId,
+                       Clock::time_point  begin,
+                       Clock::duration    duration)
+{
+    file << ",\n{\"name\":\"" << escapeJson(name) << "\","
+         << "\"cat\":\"" << category << "\","
+         << "\"ph\":\"X\","
+         << "\"ts\":"  << toTraceMicroseconds(begin - traceEpoch) << ","
+         << "\"dur\":" << toTraceMicroseconds(duration) << ","
+         << "\"pid\":1,\"tid\":" << threadId << "}";
+}
+
+static void writeThreadName(std::ofstream     &file,
+                            uint32_t           threadId,
+                            const std::string &name)
+{
+    file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId
+         << ",\"args\":{\"name\":\"" << name << "\"}}";
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// PROFILER BEG //////////////////////////////
+
+namespace Profiler
+{
+    void setEnabled(bool value)
+    {
+        enabled.store(value, std::memory_order_relaxed);
+    }
+
+    bool isEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    void record(const char        *name,
+                Clock::time_point  begin,
+                Clock::time_point  end)
+    {
+        ThreadEvents &threadEvents = getThreadEvents();
+
+        uint64_t     index = threadEvents.written.load(std::memory_order_relaxed);
+        ProfileSlot &slot  = threadEvents.slots[index % eventsPerThread];
+
+        //  seqlock:        
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.begin.store(begin.time_since_epoch().count(), std::memory_order_relaxed);
+        slot.end.store(end.time_since_epoch().count(), std::memory_order_relaxed);
+
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        threadEvents.written.store(index + 1, std::memory_order_release);
+    }
+
+    void writeChromeTrace(const std::string                &path,
+                          const std::vector<GpuTraceEvent> &gpuEvents)
+    {
+        std::ofstream file(path);
+        if(!file.is_open())
+            throw std::runtime_error("failed to open trace file!");
+
+        file << std::fixed << std::setprecision(3);
+
+        //     ,     
+        file << "{\"traceEvents\":[\n"
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"gpu\"}}";
+
+        for(const GpuTraceEvent &event : gpuEvents)
+            writeEvent(file, event.name, "gpu", 0, event.begin, event.duration);
+
+        std::lock_guard<std::mutex> lock(threadsMutex);
+
+        for(const std::unique_ptr<ThreadEvents> &threadEvents : threads)
+        {
+            writeThreadName(file, threadEvents->threadId, "cpu thread " + std::to_string(threadEvents->threadId));
+
+            for(const ProfileEvent &event : copyEvents(*threadEvents))
+                writeEvent(file, event.name, "cpu", threadEvents->threadId, event.begin, event.end - event.begin);
+        }
+
+        file << "\n]}\n";
+    }
+}
+
+///////////////////////// PROFILER END //////////////////////////////
+
+
+///////////////////////// PROFILE ZONE BEG //////////////////////////////
+
+ProfileZone::ProfileZone(const char *name)
+{
+    this->name = name;
+    active     = Profiler::isEnabled();
+
+    if(active)
+        begin = Clock::now();
+}
+
+ProfileZone::~ProfileZone()
+{
+    if(active)
+        Profiler::record(name, begin, Clock::now());
+}
+
+///////////////////////// PROFILE ZONE END //////////////////////////////
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "vulkanWrapper/gpuProfiler.h"
+
+/*
+*  
+*    PROFILE_ZONE("")       
+*  .         
+*  JSON  Chrome trace_event,    chrome://tracing  Perfetto
+*   ,     
+*/
+namespace Profiler
+{
+    using Clock = std::chrono::steady_clock;
+
+    void setEnabled(bool enabled);
+    bool isEnabled();
+
+    // name       .    
+    void record(const char        *name,
+                Clock::time_point  begin,
+                Clock::time_point  end);
+
+    //       . gpuEvents   
+    void writeChromeTrace(const std::string                &path,
+                          const std::vector<GpuTraceEvent> &gpuEvents);
+}
+
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char *name);
+    ~ProfileZone();
+
+private:
+    const char                  *name;
+    bool                         active;
+    Profiler::Clock::time_point  begin;
+};
+
+#define PROFILE_CONCAT_IMPL(first, second) first##second
+#define PROFILE_CONCAT(first, second)      PROFILE_CONCAT_IMPL(first, second)
+
+//      
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
\ No newline at end of file
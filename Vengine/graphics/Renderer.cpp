@@ -1,9 +1,21 @@
 #include "Renderer.h"
 
 #include <chrono>
+#include <algorithm>
+#include <filesystem>
+#include <cstdio>
+#include <cstring>
+#include <future>
     
 ///////////////////////// STATIC BEG //////////////////////////////
 
+//        ,  
+//    ,       
+static const uint64_t mipStreamingInterval = 8;
+
+//    SPIR-V
+static const uint32_t spirvMagic = 0x07230203;
+
 static bool endsWith(std::string str1, std::string str2)
 {
     size_t len1 = str1.length();
@@ -25,6 +37,10 @@ static void framebufferResizeCallback(GLFWwindow *window, int width, int height)
 static void glfwKeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods)
 {
     Renderer *app = reinterpret_cast<Renderer *>(glfwGetWindowUserPointer(window));
+
+    if(app->settings.measureLatency && action != GLFW_RELEASE)
+        app->frameStats.registerInput();
+
     if(app->interfaceCallback)
         app->interfaceCallback(key, action, mods, app);
 }
@@ -38,7 +54,7 @@ static void drop_callback(GLFWwindow* window, int count, const char** paths)
     {
         Mesh mesh(path);
         app->setMesh(mesh);
-        app->pushMesh();
+        app->pushMesh(app->getSelectedObject().mesh);
     } 
     else if(endsWith(path, ".png") ||
             endsWith(path, ".jpg") ||
@@ -46,10 +62,88 @@ static void drop_callback(GLFWwindow* window, int count, const char** paths)
     {
         Texture texture(path);
         app->setTexture(texture);
-        app->pushTexture();
+        app->pushTexture(app->getSelectedObject().texture);
     }
 }
 
+//       
+static float getMaxScale(const glm::mat4 &transform)
+{
+    return std::max(glm::length(glm::vec3(transform[0])),
+           std::max(glm::length(glm::vec3(transform[1])),
+                    glm::length(glm::vec3(transform[2]))));
+}
+
+//      .     ,
+//       
+static glm::vec4 getWorldSphere(const glm::mat4      &transform,
+                                const BoundingSphere &sphere)
+{
+    glm::vec3 center = glm::vec3(transform * glm::vec4(sphere.center, 1.0f));
+
+    return glm::vec4(center, sphere.radius * getMaxScale(transform));
+}
+
+//              
+// modelCamera -     .      
+//       ,    ,     
+static bool isClusterVisible(const Meshlet   &cluster,
+                             const glm::mat4 &transform,
+                             float            scale,
+                             const glm::vec3 &modelCamera,
+                             const Frustum   *frustum)
+{
+    glm::vec3 direction = cluster.sphere.center - modelCamera;
+    float     distance  = glm::length(direction);
+
+    if(glm::dot(direction, cluster.coneAxis) >= cluster.coneCutoff * distance + cluster.sphere.radius)
+        return false;
+
+    if(!frustum)
+        return true;
+
+    glm::vec3 center = glm::vec3(transform * glm::vec4(cluster.sphere.center, 1.0f));
+    float     radius = cluster.sphere.radius * scale;
+
+    for(const glm::vec4 &plane : frustum->planes)
+        if(glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+            return false;
+
+    return true;
+}
+
+static ShaderReflection reflectSceneShaders(const Shader &vertexShader, const Shader &fragmentShader)
+{
+    return mergeReflections({reflectShader(vertexShader.binaryCode,   VK_SHADER_STAGE_VERTEX_BIT),
+                             reflectShader(fragmentShader.binaryCode, VK_SHADER_STAGE_FRAGMENT_BIT)});
+}
+
+//      ,       
+static ShaderReflection reflectCullingShaders(const Shader &cullShader,
+                                              const Shader &compactShader,
+                                              const Shader &clusterShader)
+{
+    return mergeReflections({reflectShader(cullShader.binaryCode,    VK_SHADER_STAGE_COMPUTE_BIT),
+                             reflectShader(compactShader.binaryCode, VK_SHADER_STAGE_COMPUTE_BIT),
+                             reflectShader(clusterShader.binaryCode, VK_SHADER_STAGE_COMPUTE_BIT)});
+}
+
+static bool isSameAttributes(const std::vector<VkVertexInputAttributeDescription> &a,
+                             const std::vector<VkVertexInputAttributeDescription> &b)
+{
+    if(a.size() != b.size())
+        return false;
+
+    for(size_t i = 0; i < a.size(); i++)
+        if(a[i].location != b[i].location ||
+           a[i].binding  != b[i].binding  ||
+           a[i].format   != b[i].format   ||
+           a[i].offset   != b[i].offset)
+            return false;
+
+    return true;
+}
+
 ///////////////////////// STATIC END //////////////////////////////
 
 
@@ -71,8 +165,24 @@ void Renderer::loadShader(Shader shader)
     }
 }
 
+void Renderer::loadCullingShaders(Shader cullShader, Shader compactShader, Shader clusterShader)
+{
+    this->cullShader    = cullShader;
+    this->compactShader = compactShader;
+    this->clusterShader = clusterShader;
+}
+
+void Renderer::markObjectsChanged()
+{
+    objectsVersion++;
+}
+
 void Renderer::setFillMode(FillMode fillMode)
 {
+    //     pipelineFixedFunctions,    
+    vkDeviceWaitIdle(device.handle);
+    finishShaderRebuild(true);
+
     if (fillMode == FillMode::FILL)
         pipelineFixedFunctions.rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
 
@@ -81,27 +191,44 @@ void Renderer::setFillMode(FillMode fillMode)
 
     if (fillMode == FillMode::POINT)
         pipelineFixedFunctions.rasterizer.polygonMode = VK_POLYGON_MODE_POINT;
-    
-    vkDeviceWaitIdle(device.handle);
 
     setupPipeline();
 
     writeCommandsForDrawing();
 }
 
+void Renderer::setScene(Scene scene)
+{
+    this->scene    = scene;
+    selectedObject = 0;
+}
+
 void Renderer::setModel(Model model) 
 {
-    this->model = model;
+    scene.clear();
+    scene.addModel(model);
+    selectedObject = 0;
 }
 
 void Renderer::setMesh(Mesh mesh) 
 {
-    this->model.mesh = mesh;
+    scene.meshes[getSelectedObject().mesh] = mesh;
 }
 
 void Renderer::setTexture(Texture texture) 
 {
-    this->model.texture = texture;
+    scene.textures[getSelectedObject().texture] = texture;
+}
+
+SceneObject &Renderer::getSelectedObject()
+{
+    if(scene.empty())
+        scene.addModel(Model());
+
+    if(selectedObject >= scene.objects.size())
+        selectedObject = 0;
+
+    return scene.objects[selectedObject];
 }
 
 void Renderer::setInterfaceCallback(void (*interfaceCallbackFun)(int, int, int, Renderer *))
@@ -109,104 +236,325 @@ void Renderer::setInterfaceCallback(void (*interfaceCallbackFun)(int, int, int,
     this->interfaceCallback = interfaceCallbackFun;
 }
 
+void Renderer::setPresentationSettings(VkPresentModeKHR presentMode,
+                                       uint32_t         swapchainImageCount,
+                                       uint32_t         framesInFlight)
+{
+    settings.presentMode         = presentMode;
+    settings.swapchainImageCount = swapchainImageCount;
+    settings.framesInFlight      = std::max(framesInFlight, 1u);
+
+    //   vulkan        initVulkan
+    if(swapChain.isCreated())
+        applyPresentationSettings();
+}
+
+void Renderer::setInstancing(bool enabled)
+{
+    settings.instancing = enabled;
+
+    if(!swapChain.isCreated())
+        return;
+
+    //     ,       
+    vkDeviceWaitIdle(device.handle);
+    writeCommandsForDrawing();
+}
+
+const GpuProfiler &Renderer::getGpuProfiler() const
+{
+    return gpuProfiler;
+}
+
+const FrameStats &Renderer::getFrameStats() const
+{
+    return frameStats;
+}
+
+void Renderer::captureFrame(ReadbackCallback callback)
+{
+    captureRequests.push_back(callback);
+}
+
+void Renderer::setFrameCapture(ReadbackCallback callback)
+{
+    frameCapture = callback;
+}
 
-void Renderer::pushModel() 
+uint64_t Renderer::getDroppedCaptures() const
 {
-    pushMesh(false);
-    pushTexture();
+    return droppedCaptures;
 }
 
-void Renderer::pushMesh(bool rewriteCommandBuffers) 
-{      
-    if(model.mesh.vertices.empty())
+void Renderer::saveScreenshot(const std::string &path)
+{
+    captureFrame([path](const ReadbackImage &image)
     {
-        const std::vector<Vertex> vertices = {
-            {{1.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}, {1.0f, 1.0f}},
-            {{-1.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 1.0f}},
-            {{1.0f, 0.0f, -1.0f}, {1.0f, 1.0f, 1.0f}, {1.0f, 0.0f}},
-            {{-1.0f, 0.0f, -1.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 0.0f}}
-        };
+        //         BGRA
+        bool bgra = image.format == VK_FORMAT_B8G8R8A8_SRGB ||
+                    image.format == VK_FORMAT_B8G8R8A8_UNORM;
+
+        std::vector<Pixel> pixels(image.width * image.height);
+
+        for(uint32_t y = 0; y < image.height; y++)
+        {
+            const Pixel *row = reinterpret_cast<const Pixel *>(static_cast<const char *>(image.pixels) + y * image.rowPitch);
+
+            for(uint32_t x = 0; x < image.width; x++)
+            {
+                Pixel pixel = row[x];
+                if(bgra)
+                    std::swap(pixel.r, pixel.b);
+
+                pixels[y * image.width + x] = pixel;
+            }
+        }
+
+        VengineTools::saveImage(path, image.width, image.height, pixels);
+        std::cout << "\nscreenshot saved to " << path << "\n";
+    });
+}
+
+void Renderer::setCameraPath(CameraPath path)
+{
+    cameraPath = path;
+}
+
+void Renderer::writeTrace(const std::string &path)
+{
+    Profiler::writeChromeTrace(path, gpuProfiler.getTraceEvents());
+
+    std::cout << "\ntrace written to " << path << "\n";
+}
+
+
+void Renderer::pushScene() 
+{
+    if(scene.empty())
+        scene.addModel(Model());
+
+    // ,          
+    uploadBatch.begin(commandPool);
+    pushMeshes(false);
+    pushTextures(false);
+    uploadBatch.submit();
+    geometryPool.releaseRetiredBuffers();
+
+    pushObjects();
+}
+
+void Renderer::pushMeshes(bool rewriteCommandBuffers) 
+{
+    PROFILE_ZONE("pushMeshes");
+
+    if(settings.reportLod)
+        std::cout << "\nmesh levels of detail:\n";
+
+    //      ,   
+    vkDeviceWaitIdle(device.handle);
 
-        model.mesh.vertices = vertices;
+    //  pushScene        
+    bool ownUpload = !uploadBatch.isRecording();
+    if(ownUpload)
+        uploadBatch.begin(commandPool);
 
-        std::vector<uint32_t> indices = {2, 3, 0, 0, 3, 1};
-        model.mesh.indices = indices;
+    //        ,  
+    //     ,     
+    for(const MeshRange &range : meshRanges)
+        geometryPool.remove(range.allocation);
+
+    meshRanges.clear();
+    meshRanges.resize(scene.meshes.size());
+    for(MeshHandle mesh = 0; mesh < scene.meshes.size(); mesh++)
+        uploadMesh(mesh);
+
+    finishMeshUpload(ownUpload);
+
+    if(rewriteCommandBuffers)
+        writeCommandsForDrawing();
+}
+
+void Renderer::pushMesh(MeshHandle mesh)
+{
+    PROFILE_ZONE("pushMesh");
+
+    //    ,     ,   
+    vkDeviceWaitIdle(device.handle);
+
+    uploadBatch.begin(commandPool);
+
+    //       .    
+    //        
+    if(mesh >= meshRanges.size())
+    {
+        size_t uploadedCount = meshRanges.size();
+        meshRanges.resize(scene.meshes.size());
+
+        for(MeshHandle newMesh = uploadedCount; newMesh < meshRanges.size(); newMesh++)
+            uploadMesh(newMesh);
+    }
+    else
+    {
+        //      
+        geometryPool.remove(meshRanges[mesh].allocation);
+        uploadMesh(mesh);
     }
 
+    finishMeshUpload(true);
+
+    // firstIndex  vertexOffset    
+    writeCommandsForDrawing();
+}
+
+void Renderer::pushTextures(bool rewriteCommandBuffers) 
+{
+    PROFILE_ZONE("pushTextures");
+
     vkDeviceWaitIdle(device.handle);
 
-    if(!vertexBuffer.device)
-        vertexBuffer.setDevice(&device);
+    flushTextureSets();
+    destroyTextures();
+
+    uint32_t textureCount = static_cast<uint32_t>(scene.textures.size());
+    if(textureCount > textureTableSize)
+        throw std::runtime_error("failed to fit scene textures into the texture table!");
+
+    //      ,   
+    //       
+    textures.reserve(textureTableSize);
+    textures.resize(textureCount);
 
-    if(!indexBuffer.device)
-        indexBuffer.setDevice(&device);
+    mipStreaming.clear();
 
-    vertexBuffer.destroy();
-    indexBuffer.destroy();
+    bool ownUpload = !uploadBatch.isRecording();
+    if(ownUpload)
+        uploadBatch.begin(commandPool);
 
-    createVertexBuffer(commandPool,
-                       model.mesh.vertices,
-                       vertexBuffer);
-            
-    createIndexBuffer(commandPool,
-                      model.mesh.indices,
-                      indexBuffer);
+    for(TextureHandle texture = 0; texture < textureCount; texture++)
+        placeTexture(texture);
+    uploadAtlasPages();
+
+    if(ownUpload)
+        uploadBatch.submit();
 
     if(rewriteCommandBuffers)
         writeCommandsForDrawing();
 }
 
-void Renderer::pushTexture(bool rewriteCommandBuffers) 
+void Renderer::pushTexture(TextureHandle texture)
 {
-    if(model.texture.pixels.empty())
+    PROFILE_ZONE("pushTexture");
+
+    //       .    
+    //  ,       
+    if(texture >= textures.size())
     {
-        model.texture.pixels.push_back(Pixel{255, 255, 255, 255});
-        model.texture.width    = 1;
-        model.texture.height   = 1;
-        model.texture.channels = 4;
+        if(scene.textures.size() > textureTableSize)
+            throw std::runtime_error("failed to fit scene textures into the texture table!");
+
+        size_t uploadedCount = textures.size();
+        textures.resize(scene.textures.size());
+
+        uploadBatch.begin(commandPool);
+        for(TextureHandle newTexture = uploadedCount; newTexture < textures.size(); newTexture++)
+            placeTexture(newTexture);
+        uploadAtlasPages();
+        uploadBatch.submit();
+
+        //        
+        vkDeviceWaitIdle(device.handle);
+        writeCommandsForDrawing();
+        return;
     }
 
-    VkExtent3D textureExtent{
-        model.texture.getWidth(),
-        model.texture.getHeight(),
-        1
-    };
+    //     ,   
     vkDeviceWaitIdle(device.handle);
 
-    if(!textureImage.device)
-        textureImage.setDevice(&device);
+    flushTextureSets();
 
-    vkDestroyImageView(device.handle, textureImageView, nullptr);
-    textureImage.destroy();
+    vkDestroyImageView(device.handle, textures[texture].view, nullptr);
+    textures[texture].view = VK_NULL_HANDLE;
+    textures[texture].image.destroy();
+    textureSlotViews[texture] = VK_NULL_HANDLE;
+    textureResidency.forget(texture);
 
-    createTextureImage(model.texture.pixels.data(),
-                       model.texture.getChannels(),
-                       textureExtent,
-                       commandPool,
-                       textureImage);
-    createTextureImageView(device, textureImage, textureImageView);
+    bool wasInAtlas = atlas.contains(texture);
 
-    if(descriptorSets.data())
-        vkResetDescriptorPool(device.handle, descriptorPool, 0);
+    uploadBatch.begin(commandPool);
+    placeTexture(texture);
+    uploadAtlasPages();
+    uploadBatch.submit();
 
-    createDescriptorSets(device,
-                         descriptorPool,
-                         descriptorSetLayout,
-                         descriptorSets,
-                         uniformBuffers,
-                         textureImageView,
-                         textureSampler,
-                         swapChain.images.size());
+    //      ,   
+    //  ,         
+    if(wasInAtlas || atlas.contains(texture))
+        writeCommandsForDrawing();
+}
+
+void Renderer::pushObjects(bool rewriteCommandBuffers) 
+{
+    vkDeviceWaitIdle(device.handle);
+
+    reserveFrameResources();
+
+    pushedObjectCount = scene.objects.size();
 
     if(rewriteCommandBuffers)
         writeCommandsForDrawing();
 }
 
+void Renderer::reserveFrameResources()
+{
+    uint32_t objectCount  = static_cast<uint32_t>(std::max<size_t>(scene.objects.size(), 1));
+    uint32_t clusterCount = 0;
+
+    for(const SceneObject &object : scene.objects)
+        if(object.mesh < meshRanges.size())
+            clusterCount += static_cast<uint32_t>(meshRanges[object.mesh].clusters.size());
+
+    if(objectCount <= instanceCapacity && clusterCount <= clusterCapacity)
+        return;
+
+    //    ,     
+    //        
+    if(objectCount > instanceCapacity)
+        instanceCapacity = std::max(objectCount, instanceCapacity * 2);
+
+    if(clusterCount > clusterCapacity)
+        clusterCapacity = std::max(clusterCount, clusterCapacity * 2);
+
+    destroyFrameResources();
+    setupFrameResources();
+}
+
 void Renderer::run()
 {
-    initWindow();
+    Profiler::setEnabled(!settings.tracePath.empty());
+
+    //       
+    if(settings.offlineFrames > 0 || !settings.servicePath.empty())
+        settings.headless = true;
+
+    //       
+    if(settings.headless && settings.measureLatency)
+    {
+        std::cout << "\nlatency measurement is not available in headless mode\n";
+        settings.measureLatency = false;
+    }
+
+    if(!settings.headless)
+        initWindow();
+
     initVulkan();
-    mainLoop();
+
+    if(settings.servicePath.empty())
+        mainLoop();
+    else
+        ThumbnailService(*this).serve(settings.servicePath);
+
+    if(!settings.tracePath.empty())
+        writeTrace(settings.tracePath);
+
     cleanup();
 }
 
@@ -237,53 +585,146 @@ void Renderer::initWindow()
 void Renderer::initVulkan()
 {
     instance = createInstance(settings.validationLayers,
-                              settings.instanceExtensions);
+                              settings.instanceExtensions,
+                              !settings.headless);
 
     debugMessenger = setupDebugMessenger(instance);
     
-    if(glfwCreateWindowSurface(instance, pWindow, nullptr, &surface) != VK_SUCCESS)
+    if(!settings.headless && glfwCreateWindowSurface(instance, pWindow, nullptr, &surface) != VK_SUCCESS)
         std::runtime_error("failed to create window surface");
 
     setupLogicalDevice();
 
     setupSwapchain();
-    createUniformBuffers(device,
-                         uniformBuffers,
-                         swapChain.images.size());
 
     setupShaderModules();
 
-    descriptorSetLayout = createDescriptorSetLayout(device.handle);
-    pipelineLayout      = createPipelineLayout(device.handle, descriptorSetLayout);
+    textureTableSize = std::min(settings.maxTextureCount, getMaxUpdateAfterBindImages(device.physicalDevice));
+    atlas.setMaxTextureSize(settings.atlasMaxTextureSize);
+
+    workerPool.start();
+    culler.setWorkerPool(&workerPool);
+    drawSorter.setWorkerPool(&workerPool);
+
+    //           
+    //    ,      
+    frameDescriptorCache.create(&device, {{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1},
+                                          {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1}}, 4);
+    cullingDescriptorCache.create(&device, {{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1},
+                                            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 6}}, 4);
+
+    //    ,   .   -   
+    layoutCache.create(&device);
+
+    ShaderReflection sceneReflection = reflectSceneShaders(vertexShader, fragmentShader);
+    if(sceneReflection.pushConstants.size < sizeof(DrawPushConstants))
+        throw std::runtime_error("scene shaders don't declare draw push constants!");
+
+    frameDescriptorSetLayout   = layoutCache.getSetLayout(sceneReflection, 0, textureTableSize);
+    textureDescriptorSetLayout = layoutCache.getSetLayout(sceneReflection, 1, textureTableSize);
+    pipelineLayout             = layoutCache.getPipelineLayout(sceneReflection, textureTableSize);
+
+    pipelineCache = createPipelineCache(device);
+
+    if(settings.gpuCulling)
+        setupCullingPipelines();
 
-    pipelineFixedFunctions.setup(swapChain.extent);
+    setupRenderGraph();
+
+    if(settings.gpuProfiling)
+    {
+        RenderGraphStats graphStats = renderGraph.getStats();
+
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "\nrender graph: " << graphStats.passCount << " passes (" << graphStats.culledPassCount << " culled), "
+                  << graphStats.barrierCount << " barriers per frame with " << graphStats.imageBarrierCount << " layout transitions, "
+                  << "transient memory " << graphStats.transientMemory / 1048576.0 << " MB ("
+                  << graphStats.unaliasedTransientMemory / 1048576.0 << " MB without aliasing)\n";
+        std::cout.unsetf(std::ios_base::floatfield);
+    }
+
+    pipelineFixedFunctions.setup(swapChain.extent, sceneReflection);
     setupPipeline();
 
     setupCommandPool();
+    geometryPool.create(&device);
+
+    mipCommandPool.setDevice(&this->device);
+    mipCommandPool.create();
+
+    //      ,   
+    if(settings.gpuProfiling || !settings.tracePath.empty())
+    {
+        gpuProfiler.create(&device, settings.measurementFrames);
+        gpuProfiler.calibrate(commandPool.handle);
+        commandPool.profiler = &gpuProfiler;
+    }
+
+    //       ,      
+    readback.create(commandPool, std::max(settings.readbackSlots, settings.framesInFlight + 1));
 
-    createDepthResources(commandPool,
-                         swapChain.extent,
-                         depthImage,
-                         depthImageView);
-    
     createTextureSampler(device, textureSampler);
 
-    swapChain.createFrameBuffers(renderPass, depthImageView);
-    
-    descriptorPool = createDescriptorPool(device, swapChain.images.size());
-    pushModel();
+    //     setupFrameResources.    
+    //  ,  textureSlotViews       
+    textureSlotViews.assign(textureTableSize, VK_NULL_HANDLE);
+    createFallbackTexture();
 
-    createSyncObjects(device,
-                      MAX_FRAMES_IN_FLIGHT,
-                      swapChain,
-                      imageAvailableSemaphores,
-                      renderFinishedSemaphores,
-                      inFlightFences,
-                      imagesInFlight);
+    if(scene.empty())
+        scene.addModel(Model());
+
+    instanceCapacity = static_cast<uint32_t>(scene.objects.size());
+    setupFrameResources();
+
+    pushScene();
+
+    setupSyncObjects();
+
+    if(settings.measureLatency)
+        startLatencyMeasurement();
+
+    if(settings.compareInstancing)
+        startInstancingComparison();
+
+    //       ,      
+    if(settings.shaderHotReload && !settings.headless && !vertexShader.filename.empty())
+        shaderWatcher.start(std::filesystem::path(vertexShader.filename).parent_path().string());
 }
 
 void Renderer::mainLoop()
 {    
+    if(settings.offlineFrames > 0)
+    {
+        renderOffline();
+        return;
+    }
+
+    if(settings.headless)
+    {
+        //      ,     
+        uint32_t warmupFrames = static_cast<uint32_t>(swapChain.images.size());
+        for(uint32_t frame = 0; frame < warmupFrames; frame++)
+            drawFrame();
+
+        frameStats.reset();
+
+        for(uint32_t frame = 0; frame < settings.headlessFrames; frame++)
+        {
+            //       
+            if(frame + 1 == settings.headlessFrames && !settings.screenshotPath.empty())
+                saveScreenshot(settings.screenshotPath);
+
+            frameStats.beginFrame();
+            drawFrame();
+        }
+
+        vkDeviceWaitIdle(device.handle);
+        readback.flush();
+
+        frameStats.print("headless, " + std::to_string(swapChain.extent.width) + "x" + std::to_string(swapChain.extent.height));
+        return;
+    }
+
     int tick = 0;
     static float lastTime = 0;
     while(!glfwWindowShouldClose(pWindow))
@@ -300,6 +741,20 @@ void Renderer::mainLoop()
 
 void Renderer::drawFrame()
 {
+    PROFILE_ZONE("drawFrame");
+
+    if(settings.measureLatency)
+        frameStats.beginFrame();
+
+    if(settings.compareInstancing)
+        instancingStats.beginFrame();
+
+    //       pushObjects
+    if(scene.objects.size() != pushedObjectCount)
+        pushObjects();
+
+    updateShaderReload();
+
     //        
     //         4-  
     //     ,   
@@ -307,24 +762,38 @@ void Renderer::drawFrame()
     //        .      VK_TIMEOUT
     //  VK_SUCCESS
     //  UINT64_MAX      
-    vkWaitForFences(device.handle, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+    {
+        PROFILE_ZONE("waitForFrameFence");
+        vkWaitForFences(device.handle, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+    }
+
+    //    ,    
+    readback.poll();
 
     // ,     swapChainImages 
     //  
     uint32_t imageIndex;
-    VkResult result = vkAcquireNextImageKHR(device.handle,
-                                            swapChain.handle,
-                                            //   ,  
-                                            //   .  UINT64_MAX -  
-                                            UINT64_MAX,
-                                            // ,          
-                                            imageAvailableSemaphores[currentFrame],
-                                            // , .    . 
-                                            //     
-                                            VK_NULL_HANDLE,
-                                            //  imageIndex    , 
-                                            //  
-                                            &imageIndex);
+    VkResult result = VK_SUCCESS;
+
+    if(settings.headless)
+    {
+        imageIndex         = nextOffscreenImage;
+        nextOffscreenImage = (nextOffscreenImage + 1) % swapChain.images.size();
+    }
+    else
+        result = vkAcquireNextImageKHR(device.handle,
+                                       swapChain.handle,
+                                       //   ,  
+                                       //   .  UINT64_MAX -  
+                                       UINT64_MAX,
+                                       // ,          
+                                       imageAvailableSemaphores[currentFrame],
+                                       // , .    . 
+                                       //     
+                                       VK_NULL_HANDLE,
+                                       //  imageIndex    , 
+                                       //  
+                                       &imageIndex);
     
     //  vkAcquireNextImageKHR  VK_ERROR_OUT_OF_DATE_KHR
     //              
@@ -346,19 +815,62 @@ void Renderer::drawFrame()
     //        ,        
     //   
     if(imagesInFlight[imageIndex] != VK_NULL_HANDLE)
+    {
+        PROFILE_ZONE("waitForImageFence");
         vkWaitForFences(device.handle, 1, &imagesInFlight[imageIndex], VK_TRUE, UINT64_MAX);
+    }
+
+    //       ,     
+    if(gpuProfiler.collect(imageIndex) && settings.gpuProfiling)
+        updateGpuProfileReport();
+
+    collectMipFeedback(imageIndex);
+
+    //           
+    refreshTextureSet(imageIndex);
     
     //  ,      ,  
     //        
     imagesInFlight[imageIndex] = inFlightFences[currentFrame];
 
-    updateUniformBuffer(device.handle,
-                        imageIndex,
-                        swapChain.extent,
-                        model.position,
-                        model.rotation,
-                        model.scale,
-                        uniformBuffers);
+    UniformBufferObject ubo{};
+    ubo.view = camera.getView();
+    ubo.proj = camera.getProjection(swapChain.extent);
+
+    ubo.lodParameters = getLodParameters();
+
+    Frustum frustum;
+    frustum.setFromMatrix(ubo.proj * ubo.view);
+
+    //  (0, 0, 0, 1)   
+    for(int i = 0; i < 6; i++)
+        ubo.frustumPlanes[i] = settings.frustumCulling ? frustum.planes[i] : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+
+    {
+        PROFILE_ZONE("updateUniformBuffer");
+        updateUniformBuffer(device.handle,
+                            imageIndex,
+                            ubo,
+                            uniformBuffers);
+    }
+
+    if(settings.gpuCulling)
+    {
+        updateCullingObjects(imageIndex);
+
+        //   ,     ,   
+        //      ,   .  
+        //    ,    -   
+        cullVisibleSlots(frustum);
+    }
+    else
+        updateInstanceBuffer(imageIndex, frustum);
+
+    updateTextureResidency();
+    updateMipStreaming();
+
+    if(settings.reportLod)
+        updateLodReport();
 
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -375,15 +887,22 @@ void Renderer::drawFrame()
     submitInfo.pWaitSemaphores        = waitSemaphores;
     submitInfo.pWaitDstStageMask      = waitStages;
 
+    //          
+    if(settings.headless)
+        submitInfo.waitSemaphoreCount = 0;
+
     submitInfo.commandBufferCount = 1;
     //       -
     //        .    ,
     //        
     submitInfo.pCommandBuffers = &commandBuffers[imageIndex];
 
+    //   ,     ,   
+    bool capture = isCapturePending();
+
     //         
     VkSemaphore signalSemaphores[]  = {renderFinishedSemaphores[currentFrame]};
-    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.signalSemaphoreCount = settings.headless || capture ? 0 : 1;
     submitInfo.pSignalSemaphores    = signalSemaphores;
 
     //        
@@ -393,46 +912,210 @@ void Renderer::drawFrame()
     //    
     //    ,       
     //    
-    if(vkQueueSubmit(device.graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS)
-        throw std::runtime_error("failed to submit draw command buffer!");
-
-    //              
-    //    
-    VkPresentInfoKHR presentInfo{};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    {
+        PROFILE_ZONE("vkQueueSubmit");
+        if(vkQueueSubmit(device.graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS)
+            throw std::runtime_error("failed to submit draw command buffer!");
+    }
 
-    //  ,            
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores    = signalSemaphores;
+    gpuProfiler.markSubmitted(imageIndex);
 
-    //       ,         
-    //     
-    VkSwapchainKHR swapChains[] = {swapChain.handle};
-    presentInfo.swapchainCount  = 1;
-    presentInfo.pSwapchains     = swapChains;
-    presentInfo.pImageIndices   = &imageIndex;
+    if(capture)
+        submitCapture(imageIndex, settings.headless ? VK_NULL_HANDLE : renderFinishedSemaphores[currentFrame]);
 
-    //       VkResult ,     
-    //         
-    //          
-    //   ,     vkQueuePresentKHR   VkResult    
-    //  
-    presentInfo.pResults = nullptr; 
+    //       
+    if(!settings.headless)
+        presentImage(imageIndex);
 
-    result = vkQueuePresentKHR(device.presentQueue, &presentInfo);
+    currentFrame = (currentFrame + 1) % inFlightFences.size();
 
-    //             ,
-    //  vkQueuePresentKHR         
-    //    
-    if(result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized)
+    if(settings.measureLatency)
     {
-        framebufferResized = false;
-        recreateSwapChain();
+        frameStats.framePresented();
+        updateLatencyMeasurement();
     }
-    else if(result != VK_SUCCESS)
-        throw std::runtime_error("failed to present swap chain image!");
 
-    currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+    if(settings.compareInstancing)
+        updateInstancingComparison();
+}
+
+/*
+*    :     ,  
+*       .   , 
+*     ,   ,   
+*/
+void Renderer::renderOffline()
+{
+    using Clock = std::chrono::steady_clock;
+
+    CameraPath path = cameraPath ? cameraPath : makeTurntablePath(glm::vec3(0.0f), 2.0f, 1.0f);
+
+    std::filesystem::path directory = std::filesystem::path(settings.offlinePath).parent_path();
+    if(!directory.empty())
+        std::filesystem::create_directories(directory);
+
+    //        ,    
+    ImageEncoderPool encoder;
+    encoder.start(settings.encodeThreads, std::max(settings.readbackSlots, settings.framesInFlight + 1) * 2);
+
+    double readbackWaitSeconds = 0.0;
+    double copySeconds         = 0.0;
+
+    frameStats.reset();
+    Clock::time_point begin = Clock::now();
+
+    for(uint32_t frame = 0; frame < settings.offlineFrames; frame++)
+    {
+        path(frame, settings.offlineFrames, camera);
+
+        //   ,     ,    
+        Clock::time_point waitBegin = Clock::now();
+        readback.waitForFreeSlot();
+        readbackWaitSeconds += std::chrono::duration<double>(Clock::now() - waitBegin).count();
+
+        std::vector<char> fileName(settings.offlinePath.size() + 32);
+        snprintf(fileName.data(), fileName.size(), settings.offlinePath.c_str(), frame);
+
+        std::string filePath = fileName.data();
+
+        captureFrame([&encoder, &copySeconds, filePath](const ReadbackImage &image)
+        {
+            Clock::time_point copyBegin = Clock::now();
+
+            //       RGBA,   
+            std::vector<Pixel> pixels(image.width * image.height);
+            memcpy(pixels.data(), image.pixels, pixels.size() * sizeof(Pixel));
+
+            copySeconds += std::chrono::duration<double>(Clock::now() - copyBegin).count();
+
+            encoder.push(filePath, image.width, image.height, std::move(pixels));
+        });
+
+        frameStats.beginFrame();
+        drawFrame();
+    }
+
+    vkDeviceWaitIdle(device.handle);
+    readback.flush();
+    encoder.finish();
+
+    double totalSeconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    FrameStats::Summary     frames = frameStats.getFrameTimeSummary();
+    ImageEncoderPool::Stats encode = encoder.getStats();
+
+    double frameCount = std::max(settings.offlineFrames, 1u);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\n[offline, " << settings.offlineFrames << " frames, "
+              << swapChain.extent.width << "x" << swapChain.extent.height << "]\n";
+    std::cout << "total        : " << totalSeconds << " s, " << settings.offlineFrames / totalSeconds << " frames/s\n";
+    std::cout << "frame        : avg " << frames.avg << " ms, p99 " << frames.p99 << " ms\n";
+    std::cout << "readback wait: " << readbackWaitSeconds * 1000.0 / frameCount << " ms per frame\n";
+    std::cout << "pixel copy   : " << copySeconds * 1000.0 / frameCount << " ms per frame\n";
+    std::cout << "encoder wait : " << encode.pushWaitSeconds * 1000.0 / frameCount << " ms per frame\n";
+    std::cout << "encode       : " << encode.encodeSeconds * 1000.0 / std::max<double>(encode.images, 1) << " ms per image, "
+              << encode.bytes / std::max(encode.encodeSeconds, 1e-9) / (1024.0 * 1024.0) << " MB/s on "
+              << encoder.getThreadCount() << " threads\n";
+
+    //    ,    -  
+    if(encode.pushWaitSeconds > readbackWaitSeconds)
+        std::cout << "encoding is the bottleneck: add encode threads or write .raw files\n";
+
+    std::cout.unsetf(std::ios_base::floatfield);
+}
+
+bool Renderer::isCapturePending()
+{
+    if(captureRequests.empty() && !frameCapture)
+        return false;
+
+    if(!(swapChain.imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT))
+    {
+        std::cout << "\nframe capture is not supported by the swapchain images\n";
+        captureRequests.clear();
+        frameCapture = nullptr;
+        return false;
+    }
+
+    //    ,   
+    //      
+    if(!readback.hasFreeSlot())
+    {
+        if(frameCapture)
+            droppedCaptures++;
+
+        return false;
+    }
+
+    return true;
+}
+
+void Renderer::submitCapture(uint32_t    imageIndex,
+                             VkSemaphore signalSemaphore)
+{
+    PROFILE_ZONE("submitCapture");
+
+    std::vector<ReadbackCallback> callbacks;
+    callbacks.swap(captureRequests);
+
+    if(frameCapture)
+        callbacks.push_back(frameCapture);
+
+    readback.submitCopy(device.graphicsQueue,
+                        swapChain.images[imageIndex],
+                        settings.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                        swapChain.imageFormat,
+                        swapChain.extent,
+                        signalSemaphore,
+                        [callbacks](const ReadbackImage &image)
+                        {
+                            for(const ReadbackCallback &callback : callbacks)
+                                callback(image);
+                        });
+}
+
+void Renderer::presentImage(uint32_t imageIndex)
+{
+    //              
+    //    
+    VkPresentInfoKHR presentInfo{};
+    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+
+    //  ,            
+    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pWaitSemaphores    = &renderFinishedSemaphores[currentFrame];
+
+    //       ,         
+    //     
+    VkSwapchainKHR swapChains[] = {swapChain.handle};
+    presentInfo.swapchainCount  = 1;
+    presentInfo.pSwapchains     = swapChains;
+    presentInfo.pImageIndices   = &imageIndex;
+
+    //       VkResult ,     
+    //         
+    //          
+    //   ,     vkQueuePresentKHR   VkResult    
+    //  
+    presentInfo.pResults = nullptr; 
+
+    VkResult result;
+    {
+        PROFILE_ZONE("vkQueuePresentKHR");
+        result = vkQueuePresentKHR(device.presentQueue, &presentInfo);
+    }
+
+    //             ,
+    //  vkQueuePresentKHR         
+    //    
+    if(result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized)
+    {
+        framebufferResized = false;
+        recreateSwapChain();
+    }
+    else if(result != VK_SUCCESS)
+        throw std::runtime_error("failed to present swap chain image!");
 }
 
 void Renderer::setupShaderModules()
@@ -460,25 +1143,79 @@ void Renderer::setupShaderModules()
 
 void Renderer::setupLogicalDevice()
 {
+    std::vector<const char *> deviceExtensions = settings.deviceExtensions;
+
+    //      .   vulkan
+    //      
+    if(settings.headless)
+        deviceExtensions.erase(std::remove_if(deviceExtensions.begin(),
+                                              deviceExtensions.end(),
+                                              [](const char *extension) 
+                                              { 
+                                                  return std::string(extension) == VK_KHR_SWAPCHAIN_EXTENSION_NAME; 
+                                              }),
+                               deviceExtensions.end());
+
     VkPhysicalDevice physicalDevice;
     physicalDevice = pickPhysicalDevice(instance, 
                                         surface, 
-                                        settings.deviceExtensions);
+                                        deviceExtensions);
+
+    //  VK_KHR_draw_indirect_count      ,
+    //      
+
+    bool indirectCountSupported = settings.gpuCulling &&
+                                  isDeviceExtensionSupported(physicalDevice, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    if(indirectCountSupported)
+        deviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+
+    //  VK_EXT_memory_budget        
+    memoryBudgetSupported = isDeviceExtensionSupported(physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    if(memoryBudgetSupported)
+        deviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
 
     device = createLogicalDevice(instance,
                                  physicalDevice,
                                  surface, 
-                                 settings.deviceExtensions);
+                                 deviceExtensions);
+
+    if(indirectCountSupported)
+        drawIndexedIndirectCount = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+            vkGetDeviceProcAddr(device.handle, "vkCmdDrawIndexedIndirectCountKHR"));
 }
 
 void Renderer::setupSwapchain()
 {    
+    if(settings.headless)
+    {
+        createSwapchain({static_cast<uint32_t>(settings.windowWidth), 
+                         static_cast<uint32_t>(settings.windowHeight)});
+        return;
+    }
+
     int width, height;
     glfwGetFramebufferSize(pWindow, &width, &height);
 
-    VkExtent2D swapChainExtent {width, height};
+    createSwapchain({static_cast<uint32_t>(width), static_cast<uint32_t>(height)});
+}
+
+void Renderer::createSwapchain(VkExtent2D extent)
+{
+    if(!settings.headless)
+    {
+        swapChain.create(device,
+                         surface,
+                         extent,
+                         settings.presentMode,
+                         settings.swapchainImageCount);
+        return;
+    }
+
+    //    ,    ,     
+    uint32_t imageCount = settings.swapchainImageCount != 0 ? settings.swapchainImageCount 
+                                                            : std::max(settings.framesInFlight, 1u) + 1;
 
-    swapChain.create(device, surface, swapChainExtent);
+    swapChain.createOffscreen(device, extent, imageCount);
 }
 
 void Renderer::setupCommandPool()
@@ -492,11 +1229,77 @@ void Renderer::setupCommandPool()
                                        commandBuffers.data());
 }
 
+void Renderer::setupRenderGraph()
+{
+    renderGraph.create(&device);
+
+    //     ,    
+    //    .        ,    
+    RenderResource color = renderGraph.importImage("swapchain image",
+                                                   swapChain.images,
+                                                   swapChain.imageViews,
+                                                   swapChain.imageFormat,
+                                                   swapChain.extent,
+                                                   VK_IMAGE_LAYOUT_UNDEFINED,
+                                                   VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                                   settings.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+                                                                     : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+
+    RenderResource depth = renderGraph.createImage("depth",
+                                                   findDepthFormat(device.physicalDevice),
+                                                   swapChain.extent);
+
+    //       ,     
+    RenderResource instances = renderGraph.importBuffer("instances");
+    RenderResource commands  = renderGraph.importBuffer("indirect commands");
+    RenderResource counters  = renderGraph.importBuffer("counters");
+
+    //      
+    RenderResource feedback  = renderGraph.importBuffer("texture feedback");
+    renderGraph.markOutput(feedback);
+
+    if(settings.gpuCulling)
+    {
+        uint32_t resetPass = renderGraph.addPass("reset counters", false, [this](VkCommandBuffer commandBuffer, uint32_t imageIndex)
+        {
+            if(!draws.empty())
+                writeCounterResetCommands(commandBuffer, imageIndex, cullingDispatch);
+        });
+        renderGraph.use(resetPass, counters, ResourceUsage::TRANSFER_WRITE);
+
+        uint32_t cullPass = renderGraph.addPass("cull", false, [this](VkCommandBuffer commandBuffer, uint32_t imageIndex)
+        {
+            if(!draws.empty())
+                writeCullCommands(commandBuffer, imageIndex, cullingDispatch);
+        });
+        renderGraph.use(cullPass, counters,  ResourceUsage::STORAGE_WRITE);
+        renderGraph.use(cullPass, instances, ResourceUsage::STORAGE_WRITE);
+
+        uint32_t compactPass = renderGraph.addPass("compact", false, [this](VkCommandBuffer commandBuffer, uint32_t imageIndex)
+        {
+            if(!draws.empty())
+                writeCompactCommands(commandBuffer, imageIndex, cullingDispatch);
+        });
+        renderGraph.use(compactPass, counters, ResourceUsage::STORAGE_WRITE);
+        renderGraph.use(compactPass, commands, ResourceUsage::STORAGE_WRITE);
+    }
+
+    scenePass = renderGraph.addPass("render pass", true, [this](VkCommandBuffer commandBuffer, uint32_t imageIndex)
+    {
+        writeDrawCommands(commandBuffer, imageIndex, drawDispatch);
+    });
+    renderGraph.use(scenePass, color,     ResourceUsage::COLOR_ATTACHMENT);
+    renderGraph.use(scenePass, depth,     ResourceUsage::DEPTH_ATTACHMENT);
+    renderGraph.use(scenePass, instances, ResourceUsage::VERTEX_READ);
+    renderGraph.use(scenePass, commands,  ResourceUsage::INDIRECT_READ);
+    renderGraph.use(scenePass, counters,  ResourceUsage::INDIRECT_READ);
+    renderGraph.use(scenePass, feedback,  ResourceUsage::FRAGMENT_STORAGE_WRITE);
+
+    renderGraph.compile();
+}
+
 void Renderer::setupPipeline()
 {    
-    if(!renderPass)
-        renderPass = createRenderPass(device, swapChain.imageFormat);
-
     if(graphicsPipeline)
     {
         vkDestroyPipeline(device.handle, graphicsPipeline, nullptr);
@@ -506,125 +1309,1719 @@ void Renderer::setupPipeline()
     graphicsPipeline = createGraphicsPipeline(device,
                                               swapChain.extent,
                                               pipelineFixedFunctions,
-                                              renderPass,
+                                              renderGraph.getRenderPass(scenePass),
                                               vertexShaderModule,
                                               fragmentShaderModule,
-                                              descriptorSetLayout,
-                                              pipelineLayout);
+                                              frameDescriptorSetLayout,
+                                              pipelineLayout,
+                                              pipelineCache);
 }
 
-void Renderer::writeCommandsForDrawing()
+void Renderer::setupSyncObjects()
 {
-    writeCommandBuffersForDrawing(commandPool,
-                                  swapChain,
-                                  renderPass,
-                                  graphicsPipeline,
-                                  pipelineLayout,
-                                  vertexBuffer.handle,
-                                  indexBuffer.handle,
-                                  model.mesh.indices.size(),
-                                  descriptorSets,
-                                  commandBuffers);
+    createSyncObjects(device,
+                      std::max(settings.framesInFlight, 1u),
+                      swapChain,
+                      imageAvailableSemaphores,
+                      renderFinishedSemaphores,
+                      inFlightFences,
+                      imagesInFlight);
+
+    currentFrame = 0;
 }
 
-void Renderer::recreateSwapChain()
+void Renderer::setupFrameResources()
 {
-    int width  = 0, 
-        height = 0;
-    glfwGetFramebufferSize(pWindow, &width, &height);
+    uint32_t imageCount = static_cast<uint32_t>(swapChain.images.size());
 
-    //   ,  glfwGetFramebufferSize  
-    //    .          
-    //       
-    while(width == 0 || height == 0)
+    if(textureDescriptorSets.size() != imageCount)
+        createTextureDescriptorSets();
+
+    // uniform       ,     ,
+    //           
+    if(uniformBuffers.size() < imageCount)
     {
-        glfwGetFramebufferSize(pWindow, &width, &height);
-        glfwWaitEvents();
+        //      
+        frameDescriptorCache.reset();
+        destroyUniformBuffers();
+
+        createUniformBuffers(device,
+                             uniformBuffers,
+                             imageCount);
+
+        //       
+        createStorageBuffers(device,
+                             feedbackBuffers,
+                             sizeof(uint32_t) * textureTableSize,
+                             imageCount);
+
+        for(Buffer &feedbackBuffer : feedbackBuffers)
+            std::memset(feedbackBuffer.map(), 0, feedbackBuffer.size);
     }
-    vkDeviceWaitIdle(device.handle);
 
-    cleanupSwapChain();
+    //            
+    //    ,    ,     
+    //     ,      -
+    uint32_t instanceLayers = settings.gpuCulling ? Mesh::maxLodCount : 1;
+
+    createInstanceBuffers(device,
+                          instanceBuffers,
+                          std::max(instanceCapacity, 1u) * instanceLayers + clusterCapacity,
+                          imageCount);
+
+    //        ,   
+    //   Mesh::maxLodCount        
+    uint32_t drawCapacity = std::max(instanceCapacity, 1u) * Mesh::maxLodCount + clusterCapacity;
+
+    createIndirectBuffers(device,
+                          indirectBuffers,
+                          drawCapacity,
+                          imageCount);
+
+    createFrameDescriptorSets(frameDescriptorCache,
+                              frameDescriptorSetLayout,
+                              frameDescriptorSets,
+                              uniformBuffers,
+                              feedbackBuffers,
+                              imageCount);
+
+    if(!settings.gpuCulling)
+        return;
 
-    VkExtent2D swapChainExtent = {width, height};
-    swapChain.create(device, surface, swapChainExtent);
+    uint32_t capacity = std::max(instanceCapacity, 1u);
+
+    createStorageBuffers(device,
+                         cullingObjectBuffers,
+                         sizeof(CullingObject) * capacity,
+                         imageCount);
+
+    createStorageBuffers(device,
+                         cullingGroupBuffers,
+                         sizeof(CullingGroup) * drawCapacity,
+                         imageCount);
+
+    createStorageBuffers(device,
+                         cullingClusterBuffers,
+                         sizeof(CullingCluster) * std::max(clusterCapacity, 1u),
+                         imageCount);
+
+    //           .
+    //     
+    createCounterBuffers(device,
+                         counterBuffers,
+                         drawCapacity * 2,
+                         imageCount);
+
+    createCullingDescriptorSets(cullingDescriptorCache,
+                                cullingDescriptorSetLayout,
+                                cullingDescriptorSets,
+                                uniformBuffers,
+                                cullingObjectBuffers,
+                                cullingGroupBuffers,
+                                counterBuffers,
+                                instanceBuffers,
+                                indirectBuffers,
+                                cullingClusterBuffers,
+                                imageCount);
+
+    //    
+    uploadedObjectsVersion.assign(imageCount, 0);
+}
 
-    pipelineFixedFunctions.setupViewPortAndScissor(swapChain.extent);
-    setupPipeline();
+void Renderer::destroyFrameResources()
+{
+    for(size_t i = 0; i < instanceBuffers.size(); i++)
+        instanceBuffers[i].destroy();
 
-    createDepthResources(commandPool,
-                         swapChain.extent,
-                         depthImage,
-                         depthImageView);
+    for(size_t i = 0; i < indirectBuffers.size(); i++)
+        indirectBuffers[i].destroy();
 
-    swapChain.createFrameBuffers(renderPass, depthImageView);
-    
-    if(descriptorSets.data())
-        vkResetDescriptorPool(device.handle, descriptorPool, 0);
-
-    createDescriptorSets(device, 
-                         descriptorPool,
-                         descriptorSetLayout,
-                         descriptorSets,
-                         uniformBuffers,
-                         textureImageView,
-                         textureSampler,
-                         swapChain.images.size());
-
-    commandPool.allocateCommandBuffers(swapChain.images.size(),
-                                       commandBuffers.data());
-    writeCommandsForDrawing();
+    instanceBuffers.clear();
+    indirectBuffers.clear();
+
+    frameDescriptorSets.clear();
+
+    //      .  ,
+    //   ,       
+    cullingDescriptorCache.reset();
+
+    for(size_t i = 0; i < cullingObjectBuffers.size(); i++)
+    {
+        cullingObjectBuffers[i].destroy();
+        cullingGroupBuffers[i].destroy();
+        counterBuffers[i].destroy();
+        cullingClusterBuffers[i].destroy();
+    }
+
+    cullingObjectBuffers.clear();
+    cullingGroupBuffers.clear();
+    counterBuffers.clear();
+    cullingClusterBuffers.clear();
+
+    cullingDescriptorSets.clear();
 }
 
-void Renderer::cleanupSwapChain()
+void Renderer::destroyUniformBuffers()
 {
-    vkDestroyImageView(device.handle, depthImageView, nullptr);
-    depthImage.destroy();
+    for(size_t i = 0; i < uniformBuffers.size(); i++)
+    {
+        uniformBuffers[i].destroy();
+        feedbackBuffers[i].destroy();
+    }
 
-    //            
-    //           
+    uniformBuffers.clear();
+    feedbackBuffers.clear();
+}
 
-    vkResetCommandPool(device.handle, commandPool.handle, 0);
+void Renderer::uploadMesh(MeshHandle handle)
+{
+    const std::vector<Vertex> defaultVertices = {
+        {{1.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}, {1.0f, 1.0f}},
+        {{-1.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 1.0f}},
+        {{1.0f, 0.0f, -1.0f}, {1.0f, 1.0f, 1.0f}, {1.0f, 0.0f}},
+        {{-1.0f, 0.0f, -1.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 0.0f}}
+    };
+    const std::vector<uint32_t> defaultIndices = {2, 3, 0, 0, 3, 1};
 
-    swapChain.destroy();
+    Mesh      &mesh  = scene.meshes[handle];
+    MeshRange &range = meshRanges[handle];
+
+    if(mesh.vertices.empty())
+    {
+        mesh.vertices = defaultVertices;
+        mesh.indices  = defaultIndices;
+    }
+
+    //  ,  ,    
+    if(mesh.sphere.radius < 0.0f)
+        mesh.computeBounds();
+
+    //           
+    //         ,  vertexOffset   
+    std::vector<uint32_t> indices = mesh.indices;
+
+    range = MeshRange{};
+    range.sphere = mesh.sphere;
+    range.lods.push_back({0, static_cast<uint32_t>(mesh.indices.size()), 0.0f});
+
+    for(const MeshLod &lod : mesh.lods)
+    {
+        range.lods.push_back({static_cast<uint32_t>(indices.size()),
+                              static_cast<uint32_t>(lod.indices.size()),
+                              lod.error});
+        indices.insert(indices.end(), lod.indices.begin(), lod.indices.end());
+    }
+
+    range.allocation   = geometryPool.add(uploadBatch, mesh.vertices, indices);
+    range.vertexOffset = static_cast<int32_t>(range.allocation.firstVertex);
+
+    for(LodRange &lod : range.lods)
+        lod.firstIndex += range.allocation.firstIndex;
+
+    range.clusters = mesh.meshlets;
+    for(Meshlet &cluster : range.clusters)
+        cluster.firstIndex += range.allocation.firstIndex;
+
+    if(settings.reportLod)
+    {
+        std::cout << "mesh " << handle << ":";
+        for(const LodRange &lod : range.lods)
+            std::cout << " " << lod.indexCount / 3 << " triangles (error " << lod.error << ")";
+        std::cout << ", " << range.clusters.size() << " clusters\n";
+    }
 }
 
-void Renderer::cleanup()
+void Renderer::finishMeshUpload(bool submit)
 {
-    cleanupSwapChain();
+    //          
+    uploadBatch.memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+                              VK_ACCESS_TRANSFER_WRITE_BIT,
+                              VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                              VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT);
 
-    for(size_t i = 0; i < uniformBuffers.size(); i++)
-        uniformBuffers[i].destroy();
-    
-    vkDestroyPipeline(device.handle, graphicsPipeline, nullptr);
-    vkDestroyPipelineLayout(device.handle, pipelineLayout, nullptr);
-    vkDestroyRenderPass(device.handle, renderPass, nullptr);
+    if(submit)
+    {
+        uploadBatch.submit();
+        geometryPool.releaseRetiredBuffers();
+    }
 
-    vkDestroyDescriptorPool(device.handle, descriptorPool, nullptr);
+    //       
+    reserveFrameResources();
+}
 
-    vkDestroySampler(device.handle, textureSampler, nullptr);
-    vkDestroyImageView(device.handle, textureImageView, nullptr);
-    textureImage.destroy();
+void Renderer::uploadTexture(TextureHandle texture)
+{
+    PROFILE_ZONE("uploadTexture");
 
-    vkDestroyDescriptorSetLayout(device.handle, descriptorSetLayout, nullptr);
+    Texture          &source    = scene.textures[texture];
+    TextureResources &resources = textures[texture];
 
-    indexBuffer.destroy();
-    vertexBuffer.destroy();
+    //      base  1x1
+    uint32_t base       = mipStreaming.getResidentBase(texture);
+    uint32_t levelCount = mipStreaming.getLevelCount(texture);
 
-    vertexShaderModule.destroy();
-    fragmentShaderModule.destroy();
+    std::vector<TextureLevelData> levels;
+    for(uint32_t level = base; level < levelCount; level++)
+        levels.push_back(getTextureLevel(texture, level));
+
+    createTextureImage(levels,
+                       source.getChannels(),
+                       uploadBatch,
+                       resources.image);
+    createTextureImageView(device, resources.image, resources.view);
 
-    for(size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    writeTextureSlot(texture, resources.view);
+
+    textureResidency.setResident(texture, resources.image.size, residencyFrame);
+}
+
+void Renderer::destroyTextures()
+{
+    //      ,  
+    for(TextureResources &resources : textures)
     {
-        vkDestroySemaphore(device.handle, renderFinishedSemaphores[i], nullptr);
-        vkDestroySemaphore(device.handle, imageAvailableSemaphores[i], nullptr);
-        vkDestroyFence    (device.handle, inFlightFences[i],           nullptr);
+        vkDestroyImageView(device.handle, resources.view, nullptr);
+        resources.image.destroy();
     }
-    
-    vkDestroyCommandPool(device.handle, commandPool.handle, nullptr);
-    vkDestroyDevice(device.handle, nullptr);
+    textures.clear();
+    textureResidency.clear();
+    textureSlotViews.assign(textureTableSize, VK_NULL_HANDLE);
 
-    if(enableValidationLayers)
-        DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
+    for(TextureResources &resources : atlasPages)
+    {
+        vkDestroyImageView(device.handle, resources.view, nullptr);
+        resources.image.destroy();
+    }
+    atlasPages.clear();
+    atlas.clear();
+}
+
+void Renderer::createTextureDescriptorSets()
+{
+    uint32_t imageCount = static_cast<uint32_t>(swapChain.images.size());
+
+    //      ,        
+    flushTextureSets();
+
+    if(textureDescriptorPool != VK_NULL_HANDLE)
+        vkDestroyDescriptorPool(device.handle, textureDescriptorPool, nullptr);
+
+    textureDescriptorPool = createTextureDescriptorPool(device, textureTableSize, imageCount);
+
+    textureDescriptorSets.resize(imageCount);
+    for(VkDescriptorSet &descriptorSet : textureDescriptorSets)
+    {
+        descriptorSet = createTextureDescriptorSet(device,
+                                                   textureDescriptorPool,
+                                                   textureDescriptorSetLayout,
+                                                   textureSampler);
+
+        for(uint32_t slot = 0; slot < textureTableSize; slot++)
+            if(textureSlotViews[slot] != VK_NULL_HANDLE)
+                writeTextureDescriptor(device, descriptorSet, slot, textureSlotViews[slot]);
+    }
+}
+
+void Renderer::writeTextureSlot(uint32_t slot, VkImageView view)
+{
+    textureSlotViews[slot] = view;
+
+    //    VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT, 
+    // ,      ,     
+    for(VkDescriptorSet descriptorSet : textureDescriptorSets)
+        writeTextureDescriptor(device, descriptorSet, slot, view);
+}
+
+void Renderer::refreshTextureSet(uint32_t imageIndex)
+{
+    for(RetiredTexture &retired : retiredTextures)
+    {
+        if(!retired.staleSets[imageIndex])
+            continue;
+
+        writeTextureDescriptor(device,
+                               textureDescriptorSets[imageIndex],
+                               retired.slot,
+                               textureSlotViews[retired.slot]);
+        retired.staleSets[imageIndex] = false;
+    }
+
+    //        ,  ,
+    //    ,      
+    auto released = [this](RetiredTexture &retired)
+    {
+        if(std::find(retired.staleSets.begin(), retired.staleSets.end(), true) != retired.staleSets.end())
+            return false;
+
+        vkDestroyImageView(device.handle, retired.resources.view, nullptr);
+        retired.resources.image.destroy();
+        return true;
+    };
+
+    retiredTextures.erase(std::remove_if(retiredTextures.begin(), retiredTextures.end(), released),
+                          retiredTextures.end());
+}
+
+void Renderer::flushTextureSets()
+{
+    mipUpload.finish();
+    applyMipReplacements();
+
+    for(uint32_t imageIndex = 0; imageIndex < textureDescriptorSets.size(); imageIndex++)
+        refreshTextureSet(imageIndex);
+}
+
+TextureLevelData Renderer::getTextureLevel(TextureHandle texture, uint32_t level)
+{
+    if(level == 0)
+    {
+        const Texture &source = scene.textures[texture];
+
+        VkExtent3D extent{static_cast<uint32_t>(source.getWidth()),
+                          static_cast<uint32_t>(source.getHeight()),
+                          1};
+        return TextureLevelData{source.pixels.data(), extent};
+    }
+
+    const MipLevel &mip = mipStreaming.getLevel(texture, level);
+    return TextureLevelData{mip.pixels.data(), {mip.width, mip.height, 1}};
+}
+
+void Renderer::buildTextureMips(TextureHandle texture)
+{
+    PROFILE_ZONE("buildTextureMips");
+
+    Texture &source = scene.textures[texture];
+
+    if(source.pixels.empty())
+    {
+        source.pixels.push_back(Pixel{255, 255, 255, 255});
+        source.width    = 1;
+        source.height   = 1;
+        source.channels = 4;
+    }
+
+    //       ,     
+    mipStreaming.setTexture(texture, source, settings.mipStreaming && !atlas.fits(source));
+}
+
+void Renderer::placeTexture(TextureHandle texture)
+{
+    buildTextureMips(texture);
+
+    if(!atlas.add(texture, scene.textures[texture]))
+        uploadTexture(texture);
+}
+
+void Renderer::uploadAtlasPages()
+{
+    PROFILE_ZONE("uploadAtlasPages");
+
+    atlas.takeDirtyPages(dirtyAtlasPages);
+    if(dirtyAtlasPages.empty())
+        return;
+
+    //     ,  -  
+    if(textures.size() + atlas.getPageCount() > textureTableSize)
+        throw std::runtime_error("failed to fit atlas pages into the texture table!");
+
+    //     ,   
+    if(atlasPages.size() > dirtyAtlasPages.front())
+        vkDeviceWaitIdle(device.handle);
+
+    atlasPages.resize(atlas.getPageCount());
+
+    for(uint32_t page : dirtyAtlasPages)
+    {
+        TextureResources &resources = atlasPages[page];
+        vkDestroyImageView(device.handle, resources.view, nullptr);
+        resources.image.destroy();
+
+        const std::vector<Pixel> &pixels = atlas.getPagePixels(page);
+
+        std::vector<MipLevel> mips;
+        mips.reserve(TextureAtlas::pageMipLevels);
+
+        std::vector<TextureLevelData> levels;
+        levels.push_back(TextureLevelData{pixels.data(), {TextureAtlas::pageSize, TextureAtlas::pageSize, 1}});
+
+        for(uint32_t level = 1; level < TextureAtlas::pageMipLevels; level++)
+        {
+            const TextureLevelData &previous = levels.back();
+            mips.push_back(downsampleMipLevel(static_cast<const Pixel *>(previous.pixels),
+                                              previous.extent.width,
+                                              previous.extent.height));
+
+            levels.push_back(TextureLevelData{mips.back().pixels.data(), {mips.back().width, mips.back().height, 1}});
+        }
+
+        createTextureImage(levels, 4, uploadBatch, resources.image);
+        createTextureImageView(device, resources.image, resources.view);
+
+        writeTextureSlot(textureTableSize - 1 - page, resources.view);
+    }
+
+    if(settings.reportTextureResidency)
+    {
+        TextureAtlas::Stats stats = atlas.getStats();
+
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "texture atlas: " << dirtyAtlasPages.size() << " pages uploaded; "
+                  << stats.textureCount << " textures in " << stats.pageCount << " pages, "
+                  << stats.occupancy * 100.0f << "% occupied\n";
+        std::cout.unsetf(std::ios_base::floatfield);
+    }
+}
+
+uint32_t Renderer::getTextureSlot(TextureHandle texture) const
+{
+    if(atlas.contains(texture))
+        return textureTableSize - 1 - atlas.getPage(texture);
+
+    return texture;
+}
+
+glm::vec4 Renderer::getTextureUvRect(TextureHandle texture) const
+{
+    if(atlas.contains(texture))
+        return atlas.getUvRect(texture);
+
+    return glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
+}
+
+void Renderer::collectMipFeedback(uint32_t imageIndex)
+{
+    //    ,       
+    uint32_t *requestedSizes = static_cast<uint32_t *>(feedbackBuffers[imageIndex].map());
+
+    mipStreaming.addFeedback(requestedSizes, textures.size(), residencyFrame);
+
+    //        
+    std::memset(requestedSizes, 0, feedbackBuffers[imageIndex].size);
+}
+
+void Renderer::updateMipStreaming()
+{
+    if(!settings.mipStreaming)
+        return;
+
+    //    ,       
+    if(mipUpload.poll())
+        applyMipReplacements();
+
+    if(residencyFrame % mipStreamingInterval != 0 || mipUpload.isPending())
+        return;
+
+    PROFILE_ZONE("updateMipStreaming");
+
+    mipStreaming.chooseChanges(mipChanges);
+    if(mipChanges.empty())
+        return;
+
+    mipUpload.begin(mipCommandPool);
+    for(const MipStreaming::Change &change : mipChanges)
+    {
+        //       ,   
+        if(!textureResidency.isResident(change.texture))
+        {
+            mipStreaming.setResidentBase(change.texture, change.base);
+            continue;
+        }
+
+        //        .    
+        auto retiring = [&change](const RetiredTexture &retired) { return retired.slot == change.texture; };
+        if(std::any_of(retiredTextures.begin(), retiredTextures.end(), retiring))
+            continue;
+
+        mipReplacements.push_back(MipReplacement{change.texture, change.base, TextureResources{}});
+        uploadMipReplacement(mipReplacements.back());
+    }
+
+    //    :         
+    // ,   ,      ,   
+    mipUpload.submitAsync();
+
+    if(settings.reportTextureResidency)
+    {
+        MipStreaming::Stats stats = mipStreaming.getStats();
+
+        std::cout << "texture mips: " << mipChanges.size() << " textures changed, "
+                  << mipReplacements.size() << " images uploading; "
+                  << stats.residentLevels << " of " << stats.totalLevels << " levels on gpu, total "
+                  << stats.refinements << " refinements and " << stats.drops << " drops\n";
+    }
+}
+
+void Renderer::uploadMipReplacement(MipReplacement &replacement)
+{
+    PROFILE_ZONE("uploadMipReplacement");
+
+    TextureHandle     texture   = replacement.texture;
+    TextureResources &resources = textures[texture];
+
+    uint32_t oldBase    = mipStreaming.getResidentBase(texture);
+    uint32_t levelCount = mipStreaming.getLevelCount(texture);
+
+    //       oldBase,    
+    std::vector<TextureLevelData> levels;
+    for(uint32_t level = replacement.base; level < std::min(oldBase, levelCount); level++)
+        levels.push_back(getTextureLevel(texture, level));
+
+    //     .   0 -  oldBase 
+    uint32_t firstCopiedLevel = std::max(replacement.base, oldBase);
+
+    createTextureImage(levels,
+                       resources.image,
+                       firstCopiedLevel - oldBase,
+                       scene.textures[texture].getChannels(),
+                       mipUpload,
+                       replacement.resources.image);
+    createTextureImageView(device, replacement.resources.image, replacement.resources.view);
+}
+
+void Renderer::applyMipReplacements()
+{
+    for(MipReplacement &replacement : mipReplacements)
+    {
+        TextureResources &resources = textures[replacement.texture];
+
+        //            
+        //       refreshTextureSet,    
+        retiredTextures.push_back(RetiredTexture{std::move(resources),
+                                                 replacement.texture,
+                                                 std::vector<bool>(textureDescriptorSets.size(), true)});
+
+        resources = std::move(replacement.resources);
+        textureSlotViews[replacement.texture] = resources.view;
+
+        mipStreaming.setResidentBase(replacement.texture, replacement.base);
+        textureResidency.setResident(replacement.texture, resources.image.size, residencyFrame);
+    }
+
+    mipReplacements.clear();
+}
+
+void Renderer::createFallbackTexture()
+{
+    Pixel      white[] = {Pixel{255, 255, 255, 255}};
+    VkExtent3D extent{1, 1, 1};
+
+    uploadBatch.begin(commandPool);
+    createTextureImage(white, 4, extent, uploadBatch, fallbackTexture.image);
+    uploadBatch.submit();
+
+    createTextureImageView(device, fallbackTexture.image, fallbackTexture.view);
+}
+
+void Renderer::updateTextureResidency()
+{
+    PROFILE_ZONE("updateTextureResidency");
+
+    residencyFrame++;
+
+    missingTextures.clear();
+    //       ,    
+    auto useTexture = [this](TextureHandle texture)
+    {
+        if(texture >= textures.size())
+            return;
+
+        if(!textureResidency.isResident(texture))
+            missingTextures.push_back(texture);
+        textureResidency.markUsed(texture, residencyFrame);
+    };
+
+    for(uint32_t slot : visibleSlots)
+        useTexture(getTextureSlot(scene.objects[drawOrder[slot]].texture));
+
+    std::sort(missingTextures.begin(), missingTextures.end());
+    missingTextures.erase(std::unique(missingTextures.begin(), missingTextures.end()), missingTextures.end());
+
+    //         ,     
+    //   .         
+    if(!missingTextures.empty())
+    {
+        uploadBatch.begin(commandPool);
+        for(TextureHandle texture : missingTextures)
+            uploadTexture(texture);
+        uploadBatch.submit();
+    }
+
+    uint64_t bytesOverBudget = getTextureBytesOverBudget();
+    std::vector<TextureHandle> evictions;
+
+    if(bytesOverBudget > 0)
+    {
+        //  residencyFrame - inFlightFences.size()  :      drawFrame
+        uint64_t framesInFlight = inFlightFences.size();
+        uint64_t lastSafeFrame  = residencyFrame > framesInFlight ? residencyFrame - framesInFlight : 0;
+
+        evictions = textureResidency.chooseEvictions(bytesOverBudget, lastSafeFrame);
+        for(TextureHandle texture : evictions)
+            evictTexture(texture);
+    }
+
+    if(settings.reportTextureResidency && (!missingTextures.empty() || !evictions.empty()))
+    {
+        TextureResidency::Stats stats = textureResidency.getStats();
+
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "textures: " << missingTextures.size() << " streamed, " << evictions.size() << " evicted; "
+                  << stats.residentCount << " resident (" << stats.residentBytes / 1048576.0 << " MB), "
+                  << stats.evictedCount << " evicted, total " << stats.streams << " streams and "
+                  << stats.evictions << " evictions\n";
+        std::cout.unsetf(std::ios_base::floatfield);
+    }
+}
+
+void Renderer::evictTexture(TextureHandle texture)
+{
+    //        
+    auto replaced = [texture](const MipReplacement &replacement) { return replacement.texture == texture; };
+    if(std::any_of(mipReplacements.begin(), mipReplacements.end(), replaced))
+    {
+        mipUpload.finish();
+        applyMipReplacements();
+    }
+
+    TextureResources &resources = textures[texture];
+
+    //        ,     
+    writeTextureSlot(texture, fallbackTexture.view);
+
+    vkDestroyImageView(device.handle, resources.view, nullptr);
+    resources.view = VK_NULL_HANDLE;
+    resources.image.destroy();
+
+    //   ,   ,    
+    auto evicted = [this, texture](RetiredTexture &retired)
+    {
+        if(retired.slot != texture)
+            return false;
+
+        vkDestroyImageView(device.handle, retired.resources.view, nullptr);
+        retired.resources.image.destroy();
+        return true;
+    };
+
+    retiredTextures.erase(std::remove_if(retiredTextures.begin(), retiredTextures.end(), evicted),
+                          retiredTextures.end());
+
+    textureResidency.setEvicted(texture);
+}
+
+uint64_t Renderer::getTextureBytesOverBudget() const
+{
+    uint64_t residentBytes = textureResidency.getResidentBytes();
+
+    if(settings.textureBudgetMB > 0)
+    {
+        uint64_t limit = uint64_t(settings.textureBudgetMB) * 1024 * 1024;
+        return residentBytes > limit ? residentBytes - limit : 0;
+    }
+
+    DeviceMemoryBudget memory = queryDeviceMemoryBudget(device.physicalDevice, memoryBudgetSupported);
+
+    // budget ,     . 
+    //  10%   ,     
+    if(memory.measured)
+    {
+        uint64_t limit = memory.budget / 10 * 9;
+        return memory.usage > limit ? memory.usage - limit : 0;
+    }
+
+    uint64_t limit = memory.heapSize / 10 * 8;
+    return residentBytes > limit ? residentBytes - limit : 0;
+}
+
+void Renderer::buildDraws()
+{
+    PROFILE_ZONE("buildDraws");
+
+    drawOrder.clear();
+    for(uint32_t i = 0; i < scene.objects.size(); i++)
+    {
+        const SceneObject &object = scene.objects[i];
+
+        //       
+        if(object.mesh >= meshRanges.size() || object.texture >= textures.size())
+            continue;
+
+        drawOrder.push_back(i);
+    }
+
+    if(drawOrder.size() > instanceCapacity)
+        drawOrder.resize(instanceCapacity);
+
+    unsortedTextureChanges = 0;
+    for(uint32_t i = 0; i < drawOrder.size(); i++)
+        if(i == 0 || getTextureSlot(scene.objects[drawOrder[i]].texture) !=
+                     getTextureSlot(scene.objects[drawOrder[i - 1]].texture))
+            unsortedTextureChanges++;
+
+    //      ,    
+    //    ,       
+    //       .  
+    //         .
+    //   ,       
+    // ,         
+    //      ,     
+    auto sortStart = std::chrono::steady_clock::now();
+
+    drawKeys.resize(drawOrder.size());
+    for(uint32_t i = 0; i < drawOrder.size(); i++)
+    {
+        const SceneObject &object = scene.objects[drawOrder[i]];
+
+        drawKeys[i] = DrawKey::pack(0,
+                                    getTextureSlot(object.texture),
+                                    object.mesh,
+                                    glm::length(object.position - camera.position));
+    }
+
+    drawSorter.sort(drawKeys, drawOrder);
+
+    drawSortSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - sortStart).count();
+
+    draws.clear();
+    slotDraws.resize(drawOrder.size());
+    slotUvRects.resize(drawOrder.size());
+    for(uint32_t i = 0; i < drawOrder.size(); i++)
+    {
+        const SceneObject &object = scene.objects[drawOrder[i]];
+        uint32_t           slot   = getTextureSlot(object.texture);
+
+        slotUvRects[i] = getTextureUvRect(object.texture);
+
+        //            
+        //  ,    instanceCount  
+        if(settings.instancing && i > 0)
+        {
+            const SceneObject &previous = scene.objects[drawOrder[i - 1]];
+
+            if(previous.mesh == object.mesh && getTextureSlot(previous.texture) == slot)
+            {
+                draws[slotDraws[i - 1]].instanceCount++;
+                slotDraws[i] = slotDraws[i - 1];
+                continue;
+            }
+        }
+
+        const MeshRange &range = meshRanges[object.mesh];
+
+        uint32_t textureRun = 0;
+        if(!draws.empty())
+        {
+            const IndexedDraw &previous = draws.back();
+
+            textureRun = previous.textureRun;
+            if(previous.textureIndex != slot)
+                textureRun++;
+        }
+
+        slotDraws[i] = static_cast<uint32_t>(draws.size());
+
+        //    -  ,   
+        //    .       
+        for(uint32_t lod = 0; lod < range.lods.size(); lod++)
+        {
+            IndexedDraw draw{};
+            draw.indexCount           = range.lods[lod].indexCount;
+            draw.instanceCount        = lod == 0 ? 1 : 0;
+            draw.firstIndex           = range.lods[lod].firstIndex;
+            draw.vertexOffset         = range.vertexOffset;
+            draw.firstInstance        = lod * instanceCapacity + i;
+            draw.textureRun           = textureRun;
+            draw.textureIndex         = slot;
+
+            draws.push_back(draw);
+        }
+
+        //        .
+        //  ,    ,    
+        for(const Meshlet &cluster : range.clusters)
+        {
+            IndexedDraw draw{};
+            draw.indexCount           = cluster.triangleCount * 3;
+            draw.instanceCount        = 0;
+            draw.firstIndex           = cluster.firstIndex;
+            draw.vertexOffset         = range.vertexOffset;
+            draw.textureRun           = textureRun;
+            draw.textureIndex         = slot;
+
+            draws.push_back(draw);
+        }
+    }
+
+    //           
+    //      
+    uint32_t instanceLayers  = settings.gpuCulling ? Mesh::maxLodCount : 1;
+    uint32_t clusterInstance = std::max(instanceCapacity, 1u) * instanceLayers;
+
+    clusterWorkCount = 0;
+    for(uint32_t i = 0; i < drawOrder.size(); i++)
+    {
+        const MeshRange &range = meshRanges[scene.objects[drawOrder[i]].mesh];
+
+        clusterWorkCount += static_cast<uint32_t>(range.clusters.size());
+
+        if(i > 0 && slotDraws[i] == slotDraws[i - 1])
+            continue;
+
+        uint32_t firstClusterDraw = slotDraws[i] + static_cast<uint32_t>(range.lods.size());
+        for(uint32_t cluster = 0; cluster < range.clusters.size(); cluster++)
+        {
+            draws[firstClusterDraw + cluster].firstInstance = clusterInstance;
+            clusterInstance += draws[slotDraws[i]].instanceCount;
+        }
+    }
+
+    if(settings.gpuCulling)
+    {
+        writeCullingGroups();
+        //       drawOrder
+        markObjectsChanged();
+    }
+}
+
+void Renderer::cullVisibleSlots(const Frustum &frustum)
+{
+    PROFILE_ZONE("cullVisibleSlots");
+
+    size_t slotCount = drawOrder.size();
+
+    transforms.resize(slotCount);
+    cullingSpheres.resize(slotCount);
+
+    for(size_t i = 0; i < slotCount; i++)
+    {
+        const SceneObject &object = scene.objects[drawOrder[i]];
+
+        transforms[i] = object.getTransform();
+
+        glm::vec4 sphere = getWorldSphere(transforms[i], meshRanges[object.mesh].sphere);
+        cullingSpheres.set(i, glm::vec3(sphere), sphere.w);
+    }
+
+    if(settings.frustumCulling)
+        culler.cull(frustum, cullingSpheres, visibleSlots);
+    else
+    {
+        visibleSlots.resize(slotCount);
+        for(uint32_t i = 0; i < slotCount; i++)
+            visibleSlots[i] = i;
+    }
+}
+
+void Renderer::updateInstanceBuffer(uint32_t imageIndex, const Frustum &frustum)
+{
+    PROFILE_ZONE("updateInstanceBuffer");
+
+    cullVisibleSlots(frustum);
+
+    //     ,      
+    //          
+    InstanceData                 *instances = static_cast<InstanceData *>(instanceBuffers[imageIndex].map());
+    VkDrawIndexedIndirectCommand *commands  = static_cast<VkDrawIndexedIndirectCommand *>(indirectBuffers[imageIndex].map());
+
+    glm::vec4 lodParameters = getLodParameters();
+
+    //     ,       
+    visibleInstances.clear();
+    drawInstanceCounts.assign(draws.size(), 0);
+
+    for(uint32_t slot : visibleSlots)
+    {
+        const MeshRange &range = meshRanges[scene.objects[drawOrder[slot]].mesh];
+        float            scale = getMaxScale(transforms[slot]);
+
+        uint32_t lod = selectLod(range,
+                                 glm::vec4(cullingSpheres.centerX[slot],
+                                           cullingSpheres.centerY[slot],
+                                           cullingSpheres.centerZ[slot],
+                                           cullingSpheres.radius[slot]),
+                                 scale,
+                                 lodParameters);
+
+        if(settings.reportLod)
+            lodFullTriangles += range.lods[0].indexCount / 3;
+
+        if(lod == 0 && !range.clusters.empty())
+        {
+            glm::vec3 modelCamera      = glm::vec3(glm::inverse(transforms[slot]) * glm::vec4(camera.position, 1.0f));
+            uint32_t  firstClusterDraw = slotDraws[slot] + static_cast<uint32_t>(range.lods.size());
+
+            for(uint32_t cluster = 0; cluster < range.clusters.size(); cluster++)
+            {
+                if(!isClusterVisible(range.clusters[cluster],
+                                     transforms[slot],
+                                     scale,
+                                     modelCamera,
+                                     settings.frustumCulling ? &frustum : nullptr))
+                    continue;
+
+                visibleInstances.push_back({slot, firstClusterDraw + cluster});
+                drawInstanceCounts[firstClusterDraw + cluster]++;
+
+                if(settings.reportLod)
+                    lodDrawnTriangles += range.clusters[cluster].triangleCount;
+            }
+
+            continue;
+        }
+
+        visibleInstances.push_back({slot, slotDraws[slot] + lod});
+        drawInstanceCounts[slotDraws[slot] + lod]++;
+
+        if(settings.reportLod)
+            lodDrawnTriangles += range.lods[lod].indexCount / 3;
+    }
+
+    //        
+    uint32_t instanceCount = 0;
+    for(size_t i = 0; i < draws.size(); i++)
+    {
+        commands[i].indexCount    = draws[i].indexCount;
+        commands[i].instanceCount = drawInstanceCounts[i];
+        commands[i].firstIndex    = draws[i].firstIndex;
+        commands[i].vertexOffset  = draws[i].vertexOffset;
+        commands[i].firstInstance = instanceCount;
+
+        instanceCount += drawInstanceCounts[i];
+
+        //         
+        drawInstanceCounts[i] = commands[i].firstInstance;
+    }
+
+    //         
+    for(const VisibleInstance &visible : visibleInstances)
+    {
+        uint32_t instance = drawInstanceCounts[visible.draw]++;
+
+        instances[instance].model  = transforms[visible.slot];
+        instances[instance].tint   = scene.objects[drawOrder[visible.slot]].tint;
+        instances[instance].uvRect = slotUvRects[visible.slot];
+    }
+}
+
+glm::vec4 Renderer::getLodParameters() const
+{
+    if(!settings.lod)
+        return glm::vec4(camera.position, 0.0f);
+
+    return glm::vec4(camera.position, camera.getPixelsPerUnit(swapChain.extent) / settings.lodErrorPixels);
+}
+
+uint32_t Renderer::selectLod(const MeshRange &range,
+                             const glm::vec4 &sphere,
+                             float            scale,
+                             const glm::vec4 &lodParameters) const
+{
+    if(lodParameters.w <= 0.0f)
+        return 0;
+
+    //        .    ,
+    //        ,     
+    float distance = glm::length(glm::vec3(sphere) - glm::vec3(lodParameters)) - sphere.w;
+    if(distance <= 0.0f)
+        return 0;
+
+    //       error * scale * pixelsPerUnit / distance
+    for(uint32_t lod = static_cast<uint32_t>(range.lods.size()) - 1; lod > 0; lod--)
+        if(range.lods[lod].error * scale * lodParameters.w <= distance)
+            return lod;
+
+    return 0;
+}
+
+void Renderer::updateLodReport()
+{
+    //       ,      
+    if(settings.gpuCulling)
+    {
+        std::cout << "\nlod report is not available with gpu culling\n";
+        settings.reportLod = false;
+        return;
+    }
+
+    lodReportFrames++;
+    if(lodReportFrames < settings.measurementFrames)
+        return;
+
+    double drawn = static_cast<double>(lodDrawnTriangles) / lodReportFrames;
+    double full  = static_cast<double>(lodFullTriangles)  / lodReportFrames;
+    double saved = full > 0.0 ? 100.0 * (1.0 - drawn / full) : 0.0;
+
+    std::cout << "\nlod " << (settings.lod ? "on" : "off")
+              << ", triangles per frame: " << static_cast<uint64_t>(drawn)
+              << ", full detail: "         << static_cast<uint64_t>(full)
+              << ", saved: "               << saved << "%\n";
+
+    lodDrawnTriangles = 0;
+    lodFullTriangles  = 0;
+    lodReportFrames   = 0;
+}
+
+void Renderer::updateGpuProfileReport()
+{
+    gpuProfileFrames++;
+    if(gpuProfileFrames < settings.measurementFrames)
+        return;
+
+    gpuProfiler.print();
+
+    gpuProfileFrames = 0;
+}
+
+void Renderer::setupCullingPipelines()
+{
+    if(cullShader.binaryCode.empty()    || 
+       compactShader.binaryCode.empty() || 
+       clusterShader.binaryCode.empty())
+        throw std::runtime_error("gpu culling requires culling shaders!");
+
+    ShaderReflection cullingReflection = reflectCullingShaders(cullShader, compactShader, clusterShader);
+    if(cullingReflection.pushConstants.size < sizeof(CullingPushConstants))
+        throw std::runtime_error("culling shaders don't declare culling push constants!");
+
+    cullingDescriptorSetLayout = layoutCache.getSetLayout(cullingReflection, 0);
+    cullingPipelineLayout      = layoutCache.getPipelineLayout(cullingReflection);
+
+    cullShaderModule.setDevice(device);
+    compactShaderModule.setDevice(device);
+    clusterShaderModule.setDevice(device);
+
+    cullShaderModule.create(cullShader.binaryCode,
+                            VK_SHADER_STAGE_COMPUTE_BIT,
+                            cullShader.entry);
+
+    compactShaderModule.create(compactShader.binaryCode,
+                               VK_SHADER_STAGE_COMPUTE_BIT,
+                               compactShader.entry);
+
+    clusterShaderModule.create(clusterShader.binaryCode,
+                               VK_SHADER_STAGE_COMPUTE_BIT,
+                               clusterShader.entry);
+
+    cullPipeline    = createComputePipeline(device, cullShaderModule,    cullingPipelineLayout, pipelineCache);
+    compactPipeline = createComputePipeline(device, compactShaderModule, cullingPipelineLayout, pipelineCache);
+    clusterPipeline = createComputePipeline(device, clusterShaderModule, cullingPipelineLayout, pipelineCache);
+}
+
+void Renderer::destroyCullingPipelines()
+{
+    if(!cullingPipelineLayout)
+        return;
+
+    vkDestroyPipeline(device.handle, cullPipeline, nullptr);
+    vkDestroyPipeline(device.handle, compactPipeline, nullptr);
+    vkDestroyPipeline(device.handle, clusterPipeline, nullptr);
+
+    cullShaderModule.destroy();
+    compactShaderModule.destroy();
+    clusterShaderModule.destroy();
+
+    //   layoutCache
+    cullingDescriptorSetLayout = VK_NULL_HANDLE;
+    cullingPipelineLayout      = VK_NULL_HANDLE;
+}
+
+void Renderer::updateShaderReload()
+{
+    if(shaderRebuild)
+    {
+        if(shaderRebuildResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+
+        //           .
+        //    :     
+        vkDeviceWaitIdle(device.handle);
+        if(finishShaderRebuild(true))
+            writeCommandsForDrawing();
+
+        return;
+    }
+
+    if(!shaderWatcher.isRunning())
+        return;
+
+    shaderWatcher.takeChanges(changedShaderFiles);
+    if(!changedShaderFiles.empty())
+        startShaderRebuild(changedShaderFiles);
+}
+
+void Renderer::startShaderRebuild(const std::vector<std::string> &changedFiles)
+{
+    auto changed = [&changedFiles](const Shader &shader)
+    {
+        std::string name = std::filesystem::path(shader.filename).filename().string();
+
+        return !shader.filename.empty() &&
+               std::find(changedFiles.begin(), changedFiles.end(), name) != changedFiles.end();
+    };
+
+    //       ,     ,
+    //      ,   ,   
+    std::unique_ptr<ShaderRebuild> rebuild = std::make_unique<ShaderRebuild>();
+
+    if(changed(vertexShader) || changed(fragmentShader))
+    {
+        rebuild->vertexShader   = vertexShader;
+        rebuild->fragmentShader = fragmentShader;
+    }
+
+    if(cullingPipelineLayout && (changed(cullShader) || changed(compactShader) || changed(clusterShader)))
+    {
+        rebuild->cullShader    = cullShader;
+        rebuild->compactShader = compactShader;
+        rebuild->clusterShader = clusterShader;
+    }
+
+    if(rebuild->vertexShader.filename.empty() && rebuild->cullShader.filename.empty())
+        return;
+
+    shaderRebuild = std::move(rebuild);
+    shaderRebuildResult = std::async(std::launch::async, [this, target = shaderRebuild.get()]()
+    {
+        buildChangedShaders(*target);
+    });
+}
+
+void Renderer::buildChangedShaders(ShaderRebuild &rebuild)
+{
+    PROFILE_ZONE("buildChangedShaders");
+
+    //    . ,     Renderer,  
+    //  finishShaderRebuild,     vulkan     
+    auto load = [](Shader &shader)
+    {
+        std::string entry = shader.entry;
+        shader = Shader(shader.filename, shader.stage);
+        shader.entry = entry;
+
+        uint32_t magic = 0;
+        if(shader.binaryCode.size() >= sizeof(magic))
+            std::memcpy(&magic, shader.binaryCode.data(), sizeof(magic));
+
+        //      
+        if(magic != spirvMagic || shader.binaryCode.size() % sizeof(uint32_t) != 0)
+            throw std::runtime_error("failed to load " + shader.filename + ": not a SPIR-V binary!");
+    };
+
+    auto createModule = [this](ShaderModule &module, const Shader &shader, VkShaderStageFlagBits stage)
+    {
+        module.setDevice(device);
+        module.create(shader.binaryCode, stage, shader.entry);
+    };
+
+    try
+    {
+        if(!rebuild.vertexShader.filename.empty())
+        {
+            load(rebuild.vertexShader);
+            load(rebuild.fragmentShader);
+
+            //        ,
+            //         
+            ShaderReflection sceneReflection = reflectSceneShaders(rebuild.vertexShader, rebuild.fragmentShader);
+            if(layoutCache.getPipelineLayout(sceneReflection, textureTableSize) != pipelineLayout)
+                throw std::runtime_error("descriptor layout of scene shaders changed, restart required!");
+
+            PipelineFixedFunctions fixedFunctions = pipelineFixedFunctions;
+            fixedFunctions.setup(swapChain.extent, sceneReflection);
+            if(!isSameAttributes(fixedFunctions.vertexAttributes, pipelineFixedFunctions.vertexAttributes))
+                throw std::runtime_error("vertex inputs of scene shaders changed, restart required!");
+
+            createModule(rebuild.vertexShaderModule,   rebuild.vertexShader,   VK_SHADER_STAGE_VERTEX_BIT);
+            createModule(rebuild.fragmentShaderModule, rebuild.fragmentShader, VK_SHADER_STAGE_FRAGMENT_BIT);
+
+            rebuild.graphicsPipeline = createGraphicsPipeline(device,
+                                                              swapChain.extent,
+                                                              pipelineFixedFunctions,
+                                                              renderGraph.getRenderPass(scenePass),
+                                                              rebuild.vertexShaderModule,
+                                                              rebuild.fragmentShaderModule,
+                                                              frameDescriptorSetLayout,
+                                                              pipelineLayout,
+                                                              pipelineCache);
+        }
+
+        if(!rebuild.cullShader.filename.empty())
+        {
+            load(rebuild.cullShader);
+            load(rebuild.compactShader);
+            load(rebuild.clusterShader);
+
+            ShaderReflection cullingReflection = reflectCullingShaders(rebuild.cullShader, rebuild.compactShader, rebuild.clusterShader);
+            if(layoutCache.getPipelineLayout(cullingReflection) != cullingPipelineLayout)
+                throw std::runtime_error("descriptor layout of culling shaders changed, restart required!");
+
+            createModule(rebuild.cullShaderModule,    rebuild.cullShader,    VK_SHADER_STAGE_COMPUTE_BIT);
+            createModule(rebuild.compactShaderModule, rebuild.compactShader, VK_SHADER_STAGE_COMPUTE_BIT);
+            createModule(rebuild.clusterShaderModule, rebuild.clusterShader, VK_SHADER_STAGE_COMPUTE_BIT);
+
+            rebuild.cullPipeline    = createComputePipeline(device, rebuild.cullShaderModule,    cullingPipelineLayout, pipelineCache);
+            rebuild.compactPipeline = createComputePipeline(device, rebuild.compactShaderModule, cullingPipelineLayout, pipelineCache);
+            rebuild.clusterPipeline = createComputePipeline(device, rebuild.clusterShaderModule, cullingPipelineLayout, pipelineCache);
+        }
+    }
+    catch(const std::exception &error)
+    {
+        rebuild.error = error.what();
+    }
+}
+
+bool Renderer::finishShaderRebuild(bool apply)
+{
+    if(!shaderRebuild)
+        return false;
+
+    shaderRebuildResult.get();
+
+    std::unique_ptr<ShaderRebuild> rebuild = std::move(shaderRebuild);
+
+    if(!rebuild->error.empty())
+    {
+        std::cout << "shader reload failed, old shaders are kept: " << rebuild->error << "\n";
+        apply = false;
+    }
+
+    //       rebuild     
+    if(apply && rebuild->graphicsPipeline)
+    {
+        std::swap(vertexShader,   rebuild->vertexShader);
+        std::swap(fragmentShader, rebuild->fragmentShader);
+
+        std::swap(vertexShaderModule.handle,   rebuild->vertexShaderModule.handle);
+        std::swap(fragmentShaderModule.handle, rebuild->fragmentShaderModule.handle);
+
+        std::swap(graphicsPipeline, rebuild->graphicsPipeline);
+    }
+
+    if(apply && rebuild->cullPipeline)
+    {
+        std::swap(cullShader,    rebuild->cullShader);
+        std::swap(compactShader, rebuild->compactShader);
+        std::swap(clusterShader, rebuild->clusterShader);
+
+        std::swap(cullShaderModule.handle,    rebuild->cullShaderModule.handle);
+        std::swap(compactShaderModule.handle, rebuild->compactShaderModule.handle);
+        std::swap(clusterShaderModule.handle, rebuild->clusterShaderModule.handle);
+
+        std::swap(cullPipeline,    rebuild->cullPipeline);
+        std::swap(compactPipeline, rebuild->compactPipeline);
+        std::swap(clusterPipeline, rebuild->clusterPipeline);
+    }
+
+    vkDestroyPipeline(device.handle, rebuild->graphicsPipeline, nullptr);
+    vkDestroyPipeline(device.handle, rebuild->cullPipeline,     nullptr);
+    vkDestroyPipeline(device.handle, rebuild->compactPipeline,  nullptr);
+    vkDestroyPipeline(device.handle, rebuild->clusterPipeline,  nullptr);
+
+    if(apply)
+        std::cout << "shaders reloaded\n";
+
+    return apply;
+}
+
+void Renderer::writeCullingGroups()
+{
+    //       ,    vkDeviceWaitIdle,
+    //           
+    for(Buffer &groupBuffer : cullingGroupBuffers)
+    {
+        CullingGroup *groups = static_cast<CullingGroup *>(groupBuffer.map());
+
+        uint32_t runFirstDraw = 0;
+        for(uint32_t i = 0; i < draws.size(); i++)
+        {
+            if(i > 0 && draws[i].textureRun != draws[i - 1].textureRun)
+                runFirstDraw = i;
+
+            groups[i].indexCount    = draws[i].indexCount;
+            groups[i].firstIndex    = draws[i].firstIndex;
+            groups[i].vertexOffset  = draws[i].vertexOffset;
+            groups[i].firstInstance = draws[i].firstInstance;
+            groups[i].textureRun    = draws[i].textureRun;
+            groups[i].runFirstDraw  = runFirstDraw;
+            groups[i].lodError      = 0.0f;
+            groups[i].lodCount      = 1;
+            groups[i].clusterCount  = 0;
+        }
+
+        //         
+        for(uint32_t slot = 0; slot < drawOrder.size(); slot++)
+        {
+            if(slot > 0 && slotDraws[slot] == slotDraws[slot - 1])
+                continue;
+
+            const MeshRange &range = meshRanges[scene.objects[drawOrder[slot]].mesh];
+
+            for(uint32_t lod = 0; lod < range.lods.size(); lod++)
+            {
+                groups[slotDraws[slot] + lod].lodError = range.lods[lod].error;
+                groups[slotDraws[slot] + lod].lodCount = static_cast<uint32_t>(range.lods.size());
+            }
+
+            //      ,     
+            groups[slotDraws[slot]].clusterCount = static_cast<uint32_t>(range.clusters.size());
+        }
+    }
+
+    //  -      
+    for(Buffer &clusterBuffer : cullingClusterBuffers)
+    {
+        CullingCluster *clusters = static_cast<CullingCluster *>(clusterBuffer.map());
+
+        uint32_t clusterIndex = 0;
+        for(uint32_t slot = 0; slot < drawOrder.size(); slot++)
+        {
+            const MeshRange &range = meshRanges[scene.objects[drawOrder[slot]].mesh];
+
+            uint32_t firstClusterDraw = slotDraws[slot] + static_cast<uint32_t>(range.lods.size());
+            for(uint32_t cluster = 0; cluster < range.clusters.size(); cluster++)
+            {
+                const Meshlet &meshlet = range.clusters[cluster];
+
+                clusters[clusterIndex].sphere = glm::vec4(meshlet.sphere.center, meshlet.sphere.radius);
+                clusters[clusterIndex].cone   = glm::vec4(meshlet.coneAxis, meshlet.coneCutoff);
+                clusters[clusterIndex].object = slot;
+                clusters[clusterIndex].group  = firstClusterDraw + cluster;
+
+                clusterIndex++;
+            }
+        }
+    }
+}
+
+void Renderer::updateCullingObjects(uint32_t imageIndex)
+{
+    PROFILE_ZONE("updateCullingObjects");
+
+    //      ,        
+    if(uploadedObjectsVersion[imageIndex] == objectsVersion)
+        return;
+
+    CullingObject *objects = static_cast<CullingObject *>(cullingObjectBuffers[imageIndex].map());
+
+    for(size_t i = 0; i < drawOrder.size(); i++)
+    {
+        const SceneObject &object = scene.objects[drawOrder[i]];
+
+        objects[i].model  = object.getTransform();
+        objects[i].tint   = object.tint;
+        objects[i].uvRect = slotUvRects[i];
+        objects[i].sphere = getWorldSphere(objects[i].model, meshRanges[object.mesh].sphere);
+        objects[i].group  = slotDraws[i];
+        objects[i].scale  = getMaxScale(objects[i].model);
+    }
+
+    uploadedObjectsVersion[imageIndex] = objectsVersion;
+}
+
+void Renderer::writeCommandsForDrawing()
+{
+    buildDraws();
+
+    cullingDispatch.cullPipeline             = cullPipeline;
+    cullingDispatch.compactPipeline          = compactPipeline;
+    cullingDispatch.clusterPipeline          = clusterPipeline;
+    cullingDispatch.pipelineLayout           = cullingPipelineLayout;
+    cullingDispatch.descriptorSets           = &cullingDescriptorSets;
+    cullingDispatch.counterBuffers           = &counterBuffers;
+    cullingDispatch.objectCount              = static_cast<uint32_t>(drawOrder.size());
+    cullingDispatch.groupCount               = static_cast<uint32_t>(draws.size());
+    cullingDispatch.clusterCount             = clusterWorkCount;
+    cullingDispatch.drawIndexedIndirectCount = drawIndexedIndirectCount;
+
+    drawDispatch.graphicsPipeline      = graphicsPipeline;
+    drawDispatch.pipelineLayout        = pipelineLayout;
+    drawDispatch.vertexBuffer          = geometryPool.getVertexBuffer();
+    drawDispatch.indexBuffer           = geometryPool.getIndexBuffer();
+    drawDispatch.instanceBuffers       = &instanceBuffers;
+    drawDispatch.indirectBuffers       = &indirectBuffers;
+    drawDispatch.draws                 = &draws;
+    drawDispatch.descriptorSets        = &frameDescriptorSets;
+    drawDispatch.textureDescriptorSets = &textureDescriptorSets;
+    drawDispatch.culling               = settings.gpuCulling ? &cullingDispatch : nullptr;
+    drawDispatch.stateChanges          = &drawStateChanges;
+
+    PROFILE_ZONE("writeCommandBuffersForDrawing");
+
+    writeCommandBuffersForDrawing(commandPool,
+                                  renderGraph,
+                                  static_cast<uint32_t>(swapChain.images.size()),
+                                  commandBuffers,
+                                  gpuProfiler.isSupported() ? &gpuProfiler : nullptr);
+
+    if(settings.reportDrawState)
+    {
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "\ndraw state in recorded pass: " << drawStateChanges.drawCalls << " draw calls, "
+                  << drawStateChanges.pipelineBinds      << " pipeline binds, "
+                  << drawStateChanges.descriptorSetBinds << " descriptor set binds, "
+                  << drawStateChanges.vertexBufferBinds  << " vertex buffer binds, "
+                  << drawStateChanges.indexBufferBinds   << " index buffer binds, "
+                  << drawStateChanges.textureChanges     << " texture changes ("
+                  << unsortedTextureChanges << " in scene order)\n"
+                  << "sorted " << drawKeys.size() << " draw keys in " << drawSortSeconds * 1000.0 << " ms\n";
+
+        GeometryPoolStats poolStats = geometryPool.getStats();
+        std::cout << "geometry pool: " << poolStats.vertexUsed << "/" << poolStats.vertexCapacity << " vertices, "
+                  << poolStats.indexUsed << "/" << poolStats.indexCapacity << " indices, "
+                  << poolStats.freeBlockCount << " free blocks, grown " << poolStats.growCount << " times\n";
+        std::cout.unsetf(std::ios_base::floatfield);
+    }
+}
+
+void Renderer::recreateSwapChain()
+{
+    //      
+    int width  = settings.windowWidth, 
+        height = settings.windowHeight;
+
+    if(!settings.headless)
+        glfwGetFramebufferSize(pWindow, &width, &height);
+
+    //   ,  glfwGetFramebufferSize  
+    //    .          
+    //       
+    while(width == 0 || height == 0)
+    {
+        glfwGetFramebufferSize(pWindow, &width, &height);
+        glfwWaitEvents();
+    }
+    vkDeviceWaitIdle(device.handle);
+
+    //         
+    finishShaderRebuild(true);
+
+    size_t oldImageCount = swapChain.images.size();
+
+    cleanupSwapChain();
+
+    createSwapchain({static_cast<uint32_t>(width), static_cast<uint32_t>(height)});
+
+    nextOffscreenImage = 0;
+
+    //  vkDeviceWaitIdle      
+    imagesInFlight.assign(swapChain.images.size(), VK_NULL_HANDLE);
+
+    // uniform ,         
+    //   ,        
+    if(swapChain.images.size() != oldImageCount)
+    {
+        destroyFrameResources();
+        setupFrameResources();
+    }
+
+    setupRenderGraph();
+
+    pipelineFixedFunctions.setupViewPortAndScissor(swapChain.extent);
+    setupPipeline();
+
+    // writeCommandsForDrawing        
+    //      
+    writeCommandsForDrawing();
+}
+
+void Renderer::applyPresentationSettings()
+{
+    vkDeviceWaitIdle(device.handle);
+
+    destroySyncObjects(device,
+                       imageAvailableSemaphores,
+                       renderFinishedSemaphores,
+                       inFlightFences,
+                       imagesInFlight);
+
+    recreateSwapChain();
+
+    setupSyncObjects();
+}
+
+void Renderer::startLatencyMeasurement()
+{
+    userPresentation = {settings.presentMode,
+                        settings.swapchainImageCount,
+                        settings.framesInFlight};
+
+    const VkPresentModeKHR presentModes[] = {
+        VK_PRESENT_MODE_IMMEDIATE_KHR,
+        VK_PRESENT_MODE_MAILBOX_KHR,
+        VK_PRESENT_MODE_FIFO_KHR,
+        VK_PRESENT_MODE_FIFO_RELAXED_KHR
+    };
+
+    std::vector<VkPresentModeKHR> supportedModes = getSupportedPresentModes(device, surface);
+    VkSurfaceCapabilitiesKHR      capabilities   = getSurfaceCapabilities(device, surface);
+
+    measurementCombinations.clear();
+    for(VkPresentModeKHR presentMode : presentModes)
+    {
+        //       FIFO,     
+        if(std::find(supportedModes.begin(), supportedModes.end(), presentMode) == supportedModes.end())
+            continue;
+
+        for(uint32_t imageCount = capabilities.minImageCount; imageCount <= capabilities.minImageCount + 2; imageCount++)
+        {
+            if(capabilities.maxImageCount > 0 && imageCount > capabilities.maxImageCount)
+                break;
+
+            for(uint32_t framesInFlight = 1; framesInFlight <= 3; framesInFlight++)
+                measurementCombinations.push_back({presentMode, imageCount, framesInFlight});
+        }
+    }
+
+    std::cout << "\nlatency measurement: " << measurementCombinations.size() << " combinations, "
+              << settings.measurementFrames << " frames each\n";
+
+    measurementIndex = 0;
+    if(!measurementCombinations.empty())
+    {
+        const PresentationCombination &combination = measurementCombinations[measurementIndex];
+        setPresentationSettings(combination.presentMode,
+                                combination.swapchainImageCount,
+                                combination.framesInFlight);
+    }
+
+    frameStats.reset();
+}
+
+void Renderer::updateLatencyMeasurement()
+{
+    if(frameStats.getFrameCount() < settings.measurementFrames)
+        return;
+
+    std::string label = std::string("present mode: ") + presentModeToString(swapChain.presentMode) +
+                        ", swapchain images: " + std::to_string(swapChain.images.size())           +
+                        ", frames in flight: " + std::to_string(inFlightFences.size());
+
+    frameStats.print(label);
+    frameStats.reset();
+
+    measurementIndex++;
+    if(measurementIndex < measurementCombinations.size())
+    {
+        const PresentationCombination &combination = measurementCombinations[measurementIndex];
+        setPresentationSettings(combination.presentMode,
+                                combination.swapchainImageCount,
+                                combination.framesInFlight);
+        return;
+    }
+
+    //   .   ,     
+    std::cout << "\nlatency measurement finished\n";
+    settings.measureLatency = false;
+    setPresentationSettings(userPresentation.presentMode,
+                            userPresentation.swapchainImageCount,
+                            userPresentation.framesInFlight);
+}
+
+void Renderer::startInstancingComparison()
+{
+    userInstancing           = settings.instancing;
+    instancingComparisonStep = 0;
+
+    std::cout << "\ninstancing comparison: " << scene.objects.size() << " objects, "
+              << settings.measurementFrames << " frames each\n";
+
+    setInstancing(true);
+    instancingStats.reset();
+}
+
+void Renderer::updateInstancingComparison()
+{
+    if(instancingStats.getFrameCount() < settings.measurementFrames)
+        return;
+
+    std::string label = std::string(settings.instancing ? "instanced" : "one draw per object") +
+                        ", objects: "    + std::to_string(scene.objects.size()) +
+                        (settings.gpuCulling ? ", culled on gpu" : ", visible: " + std::to_string(visibleSlots.size())) +
+                        ", draw calls: " + std::to_string(draws.size());
+
+    instancingStats.print(label);
+    instancingStats.reset();
+
+    instancingComparisonStep++;
+    if(instancingComparisonStep == 1)
+    {
+        setInstancing(false);
+        return;
+    }
+
+    std::cout << "\ninstancing comparison finished\n";
+    settings.compareInstancing = false;
+    setInstancing(userInstancing);
+}
+
+void Renderer::cleanupSwapChain()
+{
+    renderGraph.destroy();
+
+    //            
+    //           
+
+    vkResetCommandPool(device.handle, commandPool.handle, 0);
+
+    swapChain.destroy();
+}
+
+void Renderer::cleanup()
+{
+    shaderWatcher.stop();
+    workerPool.stop();
+    finishShaderRebuild(false);
+
+    cleanupSwapChain();
+
+    destroyFrameResources();
+    destroyUniformBuffers();
+
+    frameDescriptorCache.destroy();
+    cullingDescriptorCache.destroy();
+    
+    vkDestroyPipeline(device.handle, graphicsPipeline, nullptr);
+
+    flushTextureSets();
+    destroyTextures();
+    vkDestroyImageView(device.handle, fallbackTexture.view, nullptr);
+    fallbackTexture.image.destroy();
+    vkDestroyDescriptorPool(device.handle, textureDescriptorPool, nullptr);
+    vkDestroySampler(device.handle, textureSampler, nullptr);
+
+    destroyCullingPipelines();
+    vkDestroyPipelineCache(device.handle, pipelineCache, nullptr);
+
+    layoutCache.destroy();
+
+    geometryPool.destroy();
+
+    vertexShaderModule.destroy();
+    fragmentShaderModule.destroy();
+
+    destroySyncObjects(device,
+                       imageAvailableSemaphores,
+                       renderFinishedSemaphores,
+                       inFlightFences,
+                       imagesInFlight);
+    
+    readback.destroy();
+    uploadBatch.destroy();
+    mipUpload.destroy();
+    vkDestroyCommandPool(device.handle, mipCommandPool.handle, nullptr);
+    vkDestroyCommandPool(device.handle, commandPool.handle, nullptr);
+    gpuProfiler.destroy();
+    vkDestroyDevice(device.handle, nullptr);
+
+    if(enableValidationLayers)
+        DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
+
+    if(settings.headless)
+    {
+        vkDestroyInstance(instance, nullptr);
+        return;
+    }
 
     vkDestroySurfaceKHR(instance, surface, nullptr);
 
@@ -3,10 +3,26 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 
+#include <future>
+#include <memory>
+
 #include "vulkanWrapper/vulkanWrapper.h"
 #include "settings.h"
 #include "Model.h"
+#include "Scene.h"
+#include "Camera.h"
+#include "WorkerPool.h"
+#include "FrustumCulling.h"
+#include "DrawSorter.h"
+#include "TextureResidency.h"
+#include "MipStreaming.h"
+#include "TextureAtlas.h"
 #include "Shader.h"
+#include "ShaderWatcher.h"
+#include "FrameStats.h"
+#include "Profiler.h"
+#include "ImageEncoderPool.h"
+#include "ThumbnailService.h"
 
 enum class FillMode
 {
@@ -23,24 +39,78 @@ public:
     vkSettings settings;
     PipelineFixedFunctions pipelineFixedFunctions;
 
-    Model   model;
+    Scene    scene;
+    Camera   camera;
+    // ,        setMesh  setTexture
+    uint32_t selectedObject = 0;
 
     Renderer();
 
     void run();
 
     void setFillMode(FillMode fillMode);
+    void setScene(Scene scene);
+    //    
     void setModel(Model model);
+    //      . 
+    //     ,      
     void setMesh(Mesh mesh);
     void setTexture(Texture texture);
     void setInterfaceCallback(void (*interfaceCallback)(int, int, int, Renderer *));
 
-    void pushModel();
-    void pushMesh   (bool rewriteCommandBuffers = true);
-    void pushTexture(bool rewriteCommandBuffers = true);
+    SceneObject &getSelectedObject();
+
+    //          
+    void pushScene();
+    void pushMeshes  (bool rewriteCommandBuffers = true);
+    //        .    
+    void pushMesh    (MeshHandle mesh);
+    void pushTextures(bool rewriteCommandBuffers = true);
+    void pushTexture (TextureHandle texture);
+    //        
+    //       ,   settings.gpuCulling
+    void pushObjects (bool rewriteCommandBuffers = true);
+    //            ,
+    //             
+    void markObjectsChanged();
 
     void loadShader(Shader shader);
-    
+    //   .    settings.gpuCulling
+    void loadCullingShaders(Shader cullShader, Shader compactShader, Shader clusterShader);
+
+    //   ,          
+    //     run(),     
+    void setPresentationSettings(VkPresentModeKHR presentMode,
+                                 uint32_t         swapchainImageCount,
+                                 uint32_t         framesInFlight);
+
+    //     
+    //         vkCmdDrawIndexed
+    void setInstancing(bool enabled);
+
+    //     .     settings.gpuProfiling
+    const GpuProfiler &getGpuProfiler() const;
+
+    //      ,   
+    const FrameStats  &getFrameStats() const;
+
+    //         Chrome trace_event
+    //       settings.tracePath
+    void writeTrace(const std::string &path);
+
+    //      . callback   drawFrame
+    //   ,    ,     
+    void captureFrame(ReadbackCallback callback);
+    //   ,     callback. ,  
+    //    ,     getDroppedCaptures
+    void setFrameCapture(ReadbackCallback callback);
+    uint64_t getDroppedCaptures() const;
+
+    //     .   ,   VengineTools::saveImage
+    void saveScreenshot(const std::string &path);
+
+    //    settings.offlineFrames.      
+    void setCameraPath(CameraPath path);
     
 
 private:
@@ -51,42 +121,235 @@ private:
     VkDebugUtilsMessengerEXT debugMessenger;
 
     GLFWwindow               *pWindow;
-    VkSurfaceKHR             surface;
+    //   VK_NULL_HANDLE
+    VkSurfaceKHR             surface = VK_NULL_HANDLE;
 
     LogicalDevice            device;
     Swapchain                swapChain;
     
-    VkRenderPass               renderPass;
-    VkDescriptorSetLayout      descriptorSetLayout;
+    //     . scenePass -   ,    
+    RenderGraph                renderGraph;
+    uint32_t                   scenePass = 0;
+    //         layoutCache
+    LayoutCache                layoutCache;
+    VkDescriptorSetLayout      frameDescriptorSetLayout;
+    VkDescriptorSetLayout      textureDescriptorSetLayout;
     VkPipelineLayout           pipelineLayout;
 
     VkPipeline                 graphicsPipeline;
+    //    .       
+    // ,      
+    VkPipelineCache            pipelineCache = VK_NULL_HANDLE;
 
     CommandPool                   commandPool;
     std::vector<VkCommandBuffer>  commandBuffers;
+    //    . pushScene      
+    UploadBatch                   uploadBatch;
+    //      ,   .  ,
+    //   cleanupSwapChain  commandPool,       
+    CommandPool                   mipCommandPool;
+    UploadBatch                   mipUpload;
 
     std::vector<VkSemaphore>    imageAvailableSemaphores;
     std::vector<VkSemaphore>    renderFinishedSemaphores;
     std::vector<VkFence>        inFlightFences;
     std::vector<VkFence>        imagesInFlight;
 
-    Buffer                      vertexBuffer;
-    Buffer                      indexBuffer;
+    //    ,     
+    struct LodRange
+    {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        float    error;
+    };
+
+    //      ,    
+    //           
+    struct MeshRange
+    {
+        std::vector<LodRange> lods;     // lods[0] -  
+        //   . firstIndex     
+        std::vector<Meshlet>  clusters;
+        int32_t               vertexOffset;
+        BoundingSphere        sphere;
+        GeometryAllocation    allocation;
+    };
+
+    //    ,   . ,   
+    //   ,        
+    struct VisibleInstance
+    {
+        uint32_t slot;
+        uint32_t draw;
+    };
+
+    struct TextureResources
+    {
+        Image           image;
+        VkImageView     view          = VK_NULL_HANDLE;
+    };
+
+    //  ,   ,       
+    // staleSets[i] -     i    
+    struct RetiredTexture
+    {
+        TextureResources  resources;
+        uint32_t          slot;
+        std::vector<bool> staleSets;
+    };
+
+    //       base,   mipUpload
+    struct MipReplacement
+    {
+        TextureHandle     texture;
+        uint32_t          base;
+        TextureResources  resources;
+    };
+
+    //            
+    GeometryPool                geometryPool;
+    std::vector<MeshRange>      meshRanges;
+
     std::vector<Buffer>         uniformBuffers;
+    //   (   )     
+    //       VK_VERTEX_INPUT_RATE_INSTANCE
+    std::vector<Buffer>         instanceBuffers;
+    //   ,       draws
+    std::vector<Buffer>         indirectBuffers;
+    uint32_t                    instanceCapacity = 0;
+    //    -  .   
+    //       
+    uint32_t                    clusterCapacity  = 0;
         
-    Image                        textureImage;
-    VkImageView                  textureImageView;
-    VkSampler                    textureSampler;
+    // textures[i]    i  
+    std::vector<TextureResources> textures;
+    VkSampler                     textureSampler;
+    uint32_t                      textureTableSize     = 0;
+    //        . ,   
+    //  ,  ,       
+    //   . textureSlotViews - ,      
+    std::vector<VkDescriptorSet>  textureDescriptorSets;
+    std::vector<VkImageView>      textureSlotViews;
+    std::vector<RetiredTexture>   retiredTextures;
+
+    //     ,      fallbackTexture
+    TextureResidency              textureResidency;
+    TextureResources              fallbackTexture;
+    std::vector<TextureHandle>    missingTextures;
+    //    textureResidency.    drawFrame
+    uint64_t                      residencyFrame        = 0;
+    bool                          memoryBudgetSupported = false;
+
+    //     .     
+    // MipStreaming::getResidentBase  1x1,      
+    MipStreaming                      mipStreaming;
+    std::vector<MipStreaming::Change> mipChanges;
+    std::vector<MipReplacement>       mipReplacements;
+    //      ,      
+    std::vector<Buffer>               feedbackBuffers;
+
+    //       .  p  
+    // textureTableSize - 1 - p ,       ,   
+    TextureAtlas                      atlas;
+    std::vector<TextureResources>     atlasPages;
+    std::vector<uint32_t>             dirtyAtlasPages;
 
-    Image                        depthImage;
-    VkImageView                  depthImageView;
+    //       uniform      
+    DescriptorCache              frameDescriptorCache;
+    VkDescriptorPool             textureDescriptorPool = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> frameDescriptorSets;
 
-    VkDescriptorPool             descriptorPool;
-    std::vector<VkDescriptorSet> descriptorSets;
+    // drawOrder[i] -   ,     i-   
+    std::vector<uint32_t>        drawOrder;
+    // slotDraws[i] -    draws,    i-  drawOrder
+    //    draws         ,
+    // slotDraws     .      
+    std::vector<uint32_t>        slotDraws;
+    // slotUvRects[i] -     i-  drawOrder, . InstanceData::uvRect
+    std::vector<glm::vec4>       slotUvRects;
+    std::vector<IndexedDraw>     draws;
+    size_t                       pushedObjectCount = 0;
+
+    //       
+    WorkerPool                   workerPool;
+
+    //  DrawKey  drawOrder.    
+    std::vector<uint64_t>        drawKeys;
+    DrawSorter                   drawSorter;
+    //          ,
+    //       .     ,    
+    DrawStateChanges             drawStateChanges{};
+    uint32_t                     unsortedTextureChanges = 0;
+    double                       drawSortSeconds        = 0.0;
+
+    //    .     drawOrder
+    std::vector<glm::mat4>       transforms;
+    SphereArray                  cullingSpheres;
+    FrustumCuller                culler;
+    std::vector<uint32_t>        visibleSlots;
+    std::vector<VisibleInstance> visibleInstances;
+    std::vector<uint32_t>        drawInstanceCounts;
+
+    //   
+    VkDescriptorSetLayout        cullingDescriptorSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout             cullingPipelineLayout      = VK_NULL_HANDLE;
+    VkPipeline                   cullPipeline               = VK_NULL_HANDLE;
+    VkPipeline                   compactPipeline            = VK_NULL_HANDLE;
+    VkPipeline                   clusterPipeline            = VK_NULL_HANDLE;
+    DescriptorCache              cullingDescriptorCache;
+    std::vector<VkDescriptorSet> cullingDescriptorSets;
+    std::vector<Buffer>          cullingObjectBuffers;
+    std::vector<Buffer>          cullingGroupBuffers;
+    std::vector<Buffer>          counterBuffers;
+    std::vector<Buffer>          cullingClusterBuffers;
+    //   -  cullingClusterBuffers
+    uint32_t                     clusterWorkCount = 0;
+    uint64_t                     objectsVersion = 1;
+    //   ,       
+    std::vector<uint64_t>        uploadedObjectsVersion;
+
+    PFN_vkCmdDrawIndexedIndirectCountKHR drawIndexedIndirectCount = nullptr;
+
+    // ,    .     
+    CullingDispatch              cullingDispatch{};
+    DrawDispatch                 drawDispatch{};
 
 
-    int MAX_FRAMES_IN_FLIGHT = 2;
     size_t currentFrame      = 0;
+    //      ,    vkAcquireNextImageKHR
+    uint32_t nextOffscreenImage = 0;
+
+    struct PresentationCombination
+    {
+        VkPresentModeKHR presentMode;
+        uint32_t         swapchainImageCount;
+        uint32_t         framesInFlight;
+    };
+
+    FrameStats                            frameStats;
+    std::vector<PresentationCombination>  measurementCombinations;
+    size_t                                measurementIndex = 0;
+    PresentationCombination               userPresentation;
+
+    //         
+    FrameStats                            instancingStats;
+    bool                                  userInstancing = true;
+    uint32_t                              instancingComparisonStep = 0;
+
+    // ,        ,   
+    uint64_t                              lodDrawnTriangles = 0;
+    uint64_t                              lodFullTriangles  = 0;
+    uint32_t                              lodReportFrames   = 0;
+
+    GpuProfiler                           gpuProfiler;
+    uint32_t                              gpuProfileFrames  = 0;
+
+    ReadbackRing                          readback;
+    std::vector<ReadbackCallback>         captureRequests;
+    ReadbackCallback                      frameCapture;
+    uint64_t                              droppedCaptures   = 0;
+
+    CameraPath                            cameraPath;
 
     Shader vertexShader;
     Shader fragmentShader;
@@ -94,20 +357,137 @@ private:
     ShaderModule vertexShaderModule;
     ShaderModule fragmentShaderModule;
 
+    Shader cullShader;
+    Shader compactShader;
+    Shader clusterShader;
+
+    ShaderModule cullShaderModule;
+    ShaderModule compactShaderModule;
+    ShaderModule clusterShaderModule;
+
+    //   ,        .
+    //    VK_NULL_HANDLE -     
+    struct ShaderRebuild
+    {
+        Shader       vertexShader;
+        Shader       fragmentShader;
+        Shader       cullShader;
+        Shader       compactShader;
+        Shader       clusterShader;
+
+        ShaderModule vertexShaderModule;
+        ShaderModule fragmentShaderModule;
+        ShaderModule cullShaderModule;
+        ShaderModule compactShaderModule;
+        ShaderModule clusterShaderModule;
+
+        VkPipeline   graphicsPipeline = VK_NULL_HANDLE;
+        VkPipeline   cullPipeline     = VK_NULL_HANDLE;
+        VkPipeline   compactPipeline  = VK_NULL_HANDLE;
+        VkPipeline   clusterPipeline  = VK_NULL_HANDLE;
+
+        // ,   
+        std::string  error;
+    };
+
+    ShaderWatcher                  shaderWatcher;
+    std::vector<std::string>       changedShaderFiles;
+    std::unique_ptr<ShaderRebuild> shaderRebuild;
+    std::future<void>              shaderRebuildResult;
+
     void initWindow();
     void initVulkan();
     void mainLoop();
     void drawFrame();
+    void presentImage(uint32_t imageIndex);
+    void renderOffline();
+    //         
+    bool isCapturePending();
+    //         signalSemaphore  
+    void submitCapture(uint32_t imageIndex, VkSemaphore signalSemaphore);
     void setupShaderModules();
     void setupLogicalDevice();
     void setupSwapchain();
+    void createSwapchain(VkExtent2D extent);
     void setupCommandPool();
+    void setupRenderGraph();
     void setupPipeline();
+    void setupSyncObjects();
+    void setupFrameResources();
+    //   ,      ,   
+    void reserveFrameResources();
+    void destroyFrameResources();
+    void destroyUniformBuffers();
+    //      uploadBatch
+    void uploadMesh(MeshHandle mesh);
+    void uploadTexture(TextureHandle texture);
+    //        
+    void finishMeshUpload(bool submit);
+    void destroyTextures();
+    void createFallbackTexture();
+    //        .    
+    void createTextureDescriptorSets();
+    //       .         
+    void writeTextureSlot(uint32_t slot, VkImageView view);
+    //     imageIndex     
+    //  ,        
+    void refreshTextureSet(uint32_t imageIndex);
+    //       .    
+    void flushTextureSets();
+    //   level .  0 -   
+    TextureLevelData getTextureLevel(TextureHandle texture, uint32_t level);
+    //    .     
+    void buildTextureMips(TextureHandle texture);
+    //    ,      ,  
+    void placeTexture(TextureHandle texture);
+    //   ,     
+    void uploadAtlasPages();
+    //  ,    ,      
+    uint32_t  getTextureSlot  (TextureHandle texture) const;
+    glm::vec4 getTextureUvRect(TextureHandle texture) const;
+    //      ,     imageIndex
+    void collectMipFeedback(uint32_t imageIndex);
+    //       ,    
+    void updateMipStreaming();
+    //   mipUpload       replacement.base
+    void uploadMipReplacement(MipReplacement &replacement);
+    //    mipUpload  
+    void applyMipReplacements();
+    //  ,    ,     ,    
+    void updateTextureResidency();
+    void evictTexture(TextureHandle texture);
+    uint64_t getTextureBytesOverBudget() const;
+    void buildDraws();
+    //  visibleSlots ,     
+    void cullVisibleSlots(const Frustum &frustum);
+    void updateInstanceBuffer(uint32_t imageIndex, const Frustum &frustum);
+    glm::vec4 getLodParameters() const;
+    uint32_t  selectLod(const MeshRange &range, const glm::vec4 &sphere, float scale, const glm::vec4 &lodParameters) const;
+    void updateLodReport();
+    void updateGpuProfileReport();
+    void setupCullingPipelines();
+    void destroyCullingPipelines();
+    //  ,    ,     
+    void updateShaderReload();
+    void startShaderRebuild(const std::vector<std::string> &changedFiles);
+    void buildChangedShaders(ShaderRebuild &rebuild);
+    //   .   ,    ,
+    //   .      
+    // true,   
+    bool finishShaderRebuild(bool apply);
+    void writeCullingGroups();
+    void updateCullingObjects(uint32_t imageIndex);
     void writeCommandsForDrawing();
+    void applyPresentationSettings();
+    void startLatencyMeasurement();
+    void updateLatencyMeasurement();
+    void startInstancingComparison();
+    void updateInstancingComparison();
     void recreateSwapChain();
     void cleanupSwapChain();
     void cleanup();
 
     friend void glfwKeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods);
+    friend class ThumbnailService;
 };
 
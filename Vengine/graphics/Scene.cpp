@@ -0,0 +1,81 @@
+#include "Scene.h"
+
+#include <stdexcept>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+///////////////////////// SCENE OBJECT BEG //////////////////////////////
+
+glm::mat4 SceneObject::getTransform() const
+{
+    glm::vec3 angles = glm::radians(rotation);
+
+    glm::mat4 transform = glm::translate(glm::mat4(1.0f), position);
+
+    transform = glm::rotate(transform, angles.x, glm::vec3(1.0f, 0.0f, 0.0f));
+    transform = glm::rotate(transform, angles.y, glm::vec3(0.0f, 1.0f, 0.0f));
+    transform = glm::rotate(transform, angles.z, glm::vec3(0.0f, 0.0f, 1.0f));
+
+    return glm::scale(transform, scale);
+}
+
+///////////////////////// SCENE OBJECT END //////////////////////////////
+
+
+///////////////////////// SCENE BEG //////////////////////////////
+
+MeshHandle Scene::addMesh(const Mesh &mesh)
+{
+    meshes.push_back(mesh);
+    return static_cast<MeshHandle>(meshes.size() - 1);
+}
+
+TextureHandle Scene::addTexture(const Texture &texture)
+{
+    textures.push_back(texture);
+    return static_cast<TextureHandle>(textures.size() - 1);
+}
+
+uint32_t Scene::addObject(MeshHandle    mesh,
+                          TextureHandle texture,
+                          glm::vec3     position,
+                          glm::vec3     rotation,
+                          glm::vec3     scale,
+                          glm::vec4     tint)
+{
+    if(mesh >= meshes.size() || texture >= textures.size())
+        throw std::runtime_error("scene object refers to a missing mesh or texture!");
+
+    SceneObject object{};
+    object.mesh     = mesh;
+    object.texture  = texture;
+    object.position = position;
+    object.rotation = rotation;
+    object.scale    = scale;
+    object.tint     = tint;
+
+    objects.push_back(object);
+    return static_cast<uint32_t>(objects.size() - 1);
+}
+
+uint32_t Scene::addModel(const Model &model)
+{
+    MeshHandle    mesh    = addMesh(model.mesh);
+    TextureHandle texture = addTexture(model.texture);
+
+    return addObject(mesh, texture, model.position, model.rotation, model.scale);
+}
+
+void Scene::clear()
+{
+    meshes.clear();
+    textures.clear();
+    objects.clear();
+}
+
+bool Scene::empty() const
+{
+    return objects.empty();
+}
+
+///////////////////////// SCENE END //////////////////////////////
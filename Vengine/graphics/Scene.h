@@ -0,0 +1,60 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEFAULT_ALIGNED_GENTYPES
+#include <glm/glm.hpp>
+
+#include <vector>
+
+#include "Mesh.h"
+#include "Texture.h"
+#include "Model.h"
+
+//   .     Scene::meshes  Scene::textures
+//            ,
+//          
+typedef uint32_t MeshHandle;
+typedef uint32_t TextureHandle;
+
+struct SceneObject
+{
+    MeshHandle    mesh;
+    TextureHandle texture;
+
+    glm::vec3 position;
+    glm::vec3 rotation; //  
+    glm::vec3 scale;
+
+    //   ,       
+    glm::vec4 tint;
+
+    glm::mat4 getTransform() const;
+};
+
+/*
+*   
+*        ,    
+*/
+class Scene
+{
+public:
+    std::vector<Mesh>        meshes;
+    std::vector<Texture>     textures;
+    std::vector<SceneObject> objects;
+
+    MeshHandle    addMesh(const Mesh &mesh);
+    TextureHandle addTexture(const Texture &texture);
+
+    uint32_t addObject(MeshHandle    mesh,
+                       TextureHandle texture,
+                       glm::vec3     position = glm::vec3(0.0f, 0.0f, 0.0f),
+                       glm::vec3     rotation = glm::vec3(0.0f, 0.0f, 0.0f),
+                       glm::vec3     scale    = glm::vec3(1.0f, 1.0f, 1.0f),
+                       glm::vec4     tint     = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+
+    //           ,   
+    uint32_t addModel(const Model &model);
+
+    void clear();
+    bool empty() const;
+};
@@ -6,6 +6,7 @@ Shader::Shader(const std::string &filename, ShaderStages stage)
 {
     this->binaryCode = VengineTools::loadShader(filename);
     this->stage      = stage;
+    this->filename   = filename;
 }
 
 ///////////////////////// SHADER BEG //////////////////////////////
\ No newline at end of file
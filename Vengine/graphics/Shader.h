@@ -7,7 +7,8 @@
 enum class ShaderStages
 {
     VERTEX_STAGE   = 0,
-    FRAGMENT_STAGE = 1
+    FRAGMENT_STAGE = 1,
+    COMPUTE_STAGE  = 2
 };
 
 class Shader
@@ -16,6 +17,8 @@ public:
     ShaderStages      stage;
     std::string       entry = "main";
     std::vector<char> binaryCode;
+    //  SPIR-V,       
+    std::string       filename;
 
     Shader() = default;
     Shader(const std::string &filename, ShaderStages stage);
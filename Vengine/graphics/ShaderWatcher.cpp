@@ -0,0 +1,156 @@
+#include "ShaderWatcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <map>
+
+#ifdef __linux__
+    #include <sys/inotify.h>
+    #include <poll.h>
+    #include <unistd.h>
+#endif
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+//         
+static const std::chrono::milliseconds pollInterval(250);
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// SHADER WATCHER BEG //////////////////////////////
+
+ShaderWatcher::ShaderWatcher()
+{
+    this->stopping = false;
+}
+
+ShaderWatcher::~ShaderWatcher()
+{
+    stop();
+}
+
+void ShaderWatcher::start(const std::string &directory)
+{
+    stop();
+
+    this->directory = directory;
+    this->stopping  = false;
+
+    worker = std::thread(&ShaderWatcher::watch, this);
+}
+
+void ShaderWatcher::stop()
+{
+    if(!worker.joinable())
+        return;
+
+    stopping = true;
+    worker.join();
+}
+
+bool ShaderWatcher::isRunning() const
+{
+    return worker.joinable();
+}
+
+void ShaderWatcher::takeChanges(std::vector<std::string> &files)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    files.clear();
+    files.swap(changes);
+}
+
+
+void ShaderWatcher::watch()
+{
+    if(!watchNotifications())
+        watchWriteTimes();
+}
+
+bool ShaderWatcher::watchNotifications()
+{
+#ifdef __linux__
+    int handle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(handle < 0)
+        return false;
+
+    if(inotify_add_watch(handle, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        ::close(handle);
+        return false;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    while(!stopping)
+    {
+        //  ,  stop     
+        pollfd descriptor{handle, POLLIN, 0};
+        if(poll(&descriptor, 1, static_cast<int>(pollInterval.count())) <= 0)
+            continue;
+
+        ssize_t length = read(handle, buffer, sizeof(buffer));
+        for(ssize_t offset = 0; offset < length;)
+        {
+            const inotify_event *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            if(event->len > 0)
+                addChange(event->name);
+
+            offset += sizeof(inotify_event) + event->len;
+        }
+    }
+
+    ::close(handle);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ShaderWatcher::watchWriteTimes()
+{
+    namespace fs = std::filesystem;
+
+    // ,       ,   .
+    //      ,       
+    std::map<std::string, fs::file_time_type> writeTimes;
+    bool                                      firstPass = true;
+
+    while(!stopping)
+    {
+        std::error_code listError;
+        for(fs::directory_iterator entry(directory, listError), end; !listError && entry != end; entry.increment(listError))
+        {
+            std::error_code fileError;
+            if(!entry->is_regular_file(fileError))
+                continue;
+
+            fs::file_time_type writeTime = entry->last_write_time(fileError);
+            if(fileError)
+                continue;
+
+            std::string name  = entry->path().filename().string();
+            auto        known = writeTimes.find(name);
+
+            if(known == writeTimes.end() ? !firstPass : known->second != writeTime)
+                addChange(name);
+
+            writeTimes[name] = writeTime;
+        }
+
+        firstPass = false;
+        std::this_thread::sleep_for(pollInterval);
+    }
+}
+
+void ShaderWatcher::addChange(const std::string &file)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if(std::find(changes.begin(), changes.end(), file) == changes.end())
+        changes.push_back(file);
+}
+
+///////////////////////// SHADER WATCHER END //////////////////////////////
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+/*
+*           ,  
+*  Linux    inotify,       
+*  ,       .   
+*       pollInterval
+*/
+class ShaderWatcher
+{
+public:
+    ShaderWatcher();
+    ~ShaderWatcher();
+
+    ShaderWatcher(const ShaderWatcher &)            = delete;
+    ShaderWatcher &operator=(const ShaderWatcher &) = delete;
+
+    void start(const std::string &directory);
+    void stop();
+
+    bool isRunning() const;
+
+    //    ,     
+    void takeChanges(std::vector<std::string> &files);
+
+private:
+    std::string              directory;
+    std::thread              worker;
+    std::atomic<bool>        stopping;
+
+    std::mutex               mutex;
+    std::vector<std::string> changes;
+
+    void watch();
+    // false,  inotify      
+    bool watchNotifications();
+    void watchWriteTimes();
+
+    void addChange(const std::string &file);
+};
@@ -18,9 +18,9 @@ Texture::Texture(std::string path)
     loadFromFile(path);
 }
 
-int Texture::getWidth()    { return width;  }
-int Texture::getHeight()   { return height; }
-int Texture::getChannels() { return channels; }
+int Texture::getWidth()    const { return width;  }
+int Texture::getHeight()   const { return height; }
+int Texture::getChannels() const { return channels; }
 
 void Texture::loadFromFile(std::string path)
 {
@@ -14,9 +14,9 @@ public:
 
     void loadFromFile(std::string path);
 
-    int getWidth();
-    int getHeight();
-    int getChannels();
+    int getWidth()    const;
+    int getHeight()   const;
+    int getChannels() const;
 
     void  setPixel(int x, int y, Pixel pixel);
     Pixel getPixel(int x, int y);
@@ -0,0 +1,294 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+static uint32_t alignUp(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// ,        [0, divider)
+static uint32_t wrap(int64_t value, uint32_t divider)
+{
+    int64_t rest = value % static_cast<int64_t>(divider);
+    return static_cast<uint32_t>(rest < 0 ? rest + divider : rest);
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// SKYLINE PACKER BEG //////////////////////////////
+
+SkylinePacker::SkylinePacker(uint32_t width, uint32_t height)
+{
+    this->pageWidth  = width;
+    this->pageHeight = height;
+    this->usedArea   = 0;
+
+    skyline.push_back(Segment{0, 0, width});
+}
+
+bool SkylinePacker::fits(size_t segment, uint32_t width, uint32_t height, uint32_t &y) const
+{
+    if(skyline[segment].x + width > pageWidth)
+        return false;
+
+    //       ,   
+    y = 0;
+    uint32_t widthLeft = width;
+    for(size_t i = segment; widthLeft > 0; i++)
+    {
+        y = std::max(y, skyline[i].y);
+        if(y + height > pageHeight)
+            return false;
+
+        widthLeft -= std::min(widthLeft, skyline[i].width);
+    }
+
+    return true;
+}
+
+bool SkylinePacker::insert(uint32_t width, uint32_t height, uint32_t &x, uint32_t &y)
+{
+    size_t   bestSegment = skyline.size();
+    uint32_t bestY       = 0;
+
+    for(size_t segment = 0; segment < skyline.size(); segment++)
+    {
+        uint32_t segmentY;
+        if(!fits(segment, width, height, segmentY))
+            continue;
+
+        if(bestSegment == skyline.size() || segmentY < bestY)
+        {
+            bestSegment = segment;
+            bestY       = segmentY;
+        }
+    }
+
+    if(bestSegment == skyline.size())
+        return false;
+
+    x = skyline[bestSegment].x;
+    y = bestY;
+
+    skyline.insert(skyline.begin() + bestSegment, Segment{x, y + height, width});
+
+    //      
+    for(size_t i = bestSegment + 1; i < skyline.size();)
+    {
+        const Segment &previous = skyline[i - 1];
+        uint32_t       previousEnd = previous.x + previous.width;
+
+        if(skyline[i].x >= previousEnd)
+            break;
+
+        uint32_t shrink = previousEnd - skyline[i].x;
+        if(skyline[i].width <= shrink)
+        {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+
+        skyline[i].x     += shrink;
+        skyline[i].width -= shrink;
+        break;
+    }
+
+    //     
+    for(size_t i = 1; i < skyline.size();)
+    {
+        if(skyline[i - 1].y == skyline[i].y)
+        {
+            skyline[i - 1].width += skyline[i].width;
+            skyline.erase(skyline.begin() + i);
+        }
+        else
+            i++;
+    }
+
+    usedArea += uint64_t(width) * height;
+    return true;
+}
+
+float SkylinePacker::getOccupancy() const
+{
+    return static_cast<float>(usedArea) / (uint64_t(pageWidth) * pageHeight);
+}
+
+///////////////////////// SKYLINE PACKER END //////////////////////////////
+
+
+///////////////////////// TEXTURE ATLAS BEG //////////////////////////////
+
+TextureAtlas::TextureAtlas()
+{
+    this->maxTextureSize = 0;
+}
+
+void TextureAtlas::setMaxTextureSize(uint32_t size)
+{
+    maxTextureSize = std::min(size, pageSize - 2 * gutter);
+}
+
+void TextureAtlas::clear()
+{
+    placements.clear();
+    pages.clear();
+}
+
+bool TextureAtlas::fits(Texture &source) const
+{
+    return maxTextureSize > 0 &&
+           source.getWidth()  > 0 && static_cast<uint32_t>(source.getWidth())  <= maxTextureSize &&
+           source.getHeight() > 0 && static_cast<uint32_t>(source.getHeight()) <= maxTextureSize;
+}
+
+bool TextureAtlas::add(TextureHandle texture, Texture &source)
+{
+    if(!fits(source))
+    {
+        remove(texture);
+        return false;
+    }
+
+    if(texture >= placements.size())
+        placements.resize(texture + 1);
+
+    Placement &placement = placements[texture];
+    uint32_t   width     = source.getWidth();
+    uint32_t   height    = source.getHeight();
+
+    //        
+    if(placement.placed && placement.width == width && placement.height == height)
+    {
+        writePixels(placement, source);
+        return true;
+    }
+
+    //       gutter,    
+    //  gutter,         pageMipLevels 
+    uint32_t paddedWidth  = alignUp(width  + 2 * gutter, gutter);
+    uint32_t paddedHeight = alignUp(height + 2 * gutter, gutter);
+
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t page = 0;
+    while(page < pages.size() && !pages[page].packer.insert(paddedWidth, paddedHeight, x, y))
+        page++;
+
+    if(page == pages.size())
+    {
+        pages.push_back(Page{SkylinePacker(pageSize, pageSize),
+                             std::vector<Pixel>(pageSize * pageSize, Pixel{0, 0, 0, 0}),
+                             true});
+
+        if(!pages.back().packer.insert(paddedWidth, paddedHeight, x, y))
+            throw std::runtime_error("failed to fit texture into an empty atlas page!");
+    }
+
+    placement.placed = true;
+    placement.page   = page;
+    placement.x      = x + gutter;
+    placement.y      = y + gutter;
+    placement.width  = width;
+    placement.height = height;
+
+    writePixels(placement, source);
+    return true;
+}
+
+void TextureAtlas::remove(TextureHandle texture)
+{
+    if(texture < placements.size())
+        placements[texture].placed = false;
+}
+
+bool TextureAtlas::contains(TextureHandle texture) const
+{
+    return texture < placements.size() && placements[texture].placed;
+}
+
+uint32_t TextureAtlas::getPage(TextureHandle texture) const
+{
+    return placements[texture].page;
+}
+
+glm::vec4 TextureAtlas::getUvRect(TextureHandle texture) const
+{
+    const Placement &placement = placements[texture];
+
+    return glm::vec4(placement.width,
+                     placement.height,
+                     placement.x,
+                     placement.y) / static_cast<float>(pageSize);
+}
+
+uint32_t TextureAtlas::getPageCount() const
+{
+    return static_cast<uint32_t>(pages.size());
+}
+
+const std::vector<Pixel> &TextureAtlas::getPagePixels(uint32_t page) const
+{
+    return pages[page].pixels;
+}
+
+void TextureAtlas::takeDirtyPages(std::vector<uint32_t> &dirtyPages)
+{
+    dirtyPages.clear();
+
+    for(uint32_t page = 0; page < pages.size(); page++)
+        if(pages[page].dirty)
+        {
+            dirtyPages.push_back(page);
+            pages[page].dirty = false;
+        }
+}
+
+TextureAtlas::Stats TextureAtlas::getStats() const
+{
+    Stats stats{};
+    stats.pageCount = static_cast<uint32_t>(pages.size());
+
+    for(const Placement &placement : placements)
+        if(placement.placed)
+            stats.textureCount++;
+
+    for(const Page &page : pages)
+        stats.occupancy += page.packer.getOccupancy();
+
+    if(!pages.empty())
+        stats.occupancy /= pages.size();
+
+    return stats;
+}
+
+
+void TextureAtlas::writePixels(const Placement &placement, Texture &source)
+{
+    Page &page = pages[placement.page];
+
+    //   ,     
+    int64_t fieldWidth  = placement.width  + 2 * gutter;
+    int64_t fieldHeight = placement.height + 2 * gutter;
+
+    for(int64_t fieldY = 0; fieldY < fieldHeight; fieldY++)
+        for(int64_t fieldX = 0; fieldX < fieldWidth; fieldX++)
+        {
+            uint32_t sourceX = wrap(fieldX - gutter, placement.width);
+            uint32_t sourceY = wrap(fieldY - gutter, placement.height);
+
+            uint32_t pageX = placement.x - gutter + static_cast<uint32_t>(fieldX);
+            uint32_t pageY = placement.y - gutter + static_cast<uint32_t>(fieldY);
+
+            page.pixels[pageY * pageSize + pageX] = source.pixels[sourceY * placement.width + sourceX];
+        }
+
+    page.dirty = true;
+}
+
+///////////////////////// TEXTURE ATLAS END //////////////////////////////
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Pixel.h"
+#include "Texture.h"
+#include "Scene.h"
+
+/*
+*        (skyline)
+*  -     ,    .
+*   ,      ,    - 
+*       
+*/
+class SkylinePacker
+{
+public:
+    SkylinePacker(uint32_t width, uint32_t height);
+
+    // false,    
+    bool insert(uint32_t width, uint32_t height, uint32_t &x, uint32_t &y);
+
+    //   ,  
+    float getOccupancy() const;
+
+private:
+    struct Segment
+    {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+    };
+
+    uint32_t             pageWidth;
+    uint32_t             pageHeight;
+    uint64_t             usedArea;
+    std::vector<Segment> skyline;
+
+    // ,     width     segment
+    bool fits(size_t segment, uint32_t width, uint32_t height, uint32_t &y) const;
+};
+
+/*
+*   
+* ,       maxTextureSize,    ,
+*        .   
+*   gutter ,       , 
+*      pageMipLevels     
+*/
+class TextureAtlas
+{
+public:
+    static const uint32_t pageSize      = 512;
+    static const uint32_t gutter        = 4;
+    //   log2(gutter)     
+    static const uint32_t pageMipLevels = 3;
+
+    struct Stats
+    {
+        uint32_t textureCount;
+        uint32_t pageCount;
+        //   
+        float    occupancy;
+    };
+
+    TextureAtlas();
+
+    // 0 -  
+    void setMaxTextureSize(uint32_t size);
+    void clear();
+
+    bool fits(Texture &source) const;
+
+    //    . ,    ,   , 
+    //   ,    . false,     
+    bool add(TextureHandle texture, Texture &source);
+    //        clear
+    void remove(TextureHandle texture);
+
+    bool contains(TextureHandle texture) const;
+
+    uint32_t  getPage  (TextureHandle texture) const;
+    // xy -      , zw -  
+    glm::vec4 getUvRect(TextureHandle texture) const;
+
+    uint32_t                  getPageCount() const;
+    const std::vector<Pixel> &getPagePixels(uint32_t page) const;
+
+    // ,     
+    void takeDirtyPages(std::vector<uint32_t> &pages);
+
+    Stats getStats() const;
+
+private:
+    struct Placement
+    {
+        bool     placed = false;
+        uint32_t page   = 0;
+        //   ,  
+        uint32_t x      = 0;
+        uint32_t y      = 0;
+        uint32_t width  = 0;
+        uint32_t height = 0;
+    };
+
+    struct Page
+    {
+        SkylinePacker      packer;
+        std::vector<Pixel> pixels;
+        bool               dirty;
+    };
+
+    uint32_t               maxTextureSize;
+    std::vector<Placement> placements;
+    std::vector<Page>      pages;
+
+    void writePixels(const Placement &placement, Texture &source);
+};
@@ -0,0 +1,125 @@
+#include "TextureResidency.h"
+
+#include <algorithm>
+
+///////////////////////// TEXTURE RESIDENCY BEG //////////////////////////////
+
+void TextureResidency::resize(size_t textureCount)
+{
+    for(size_t texture = textureCount; texture < entries.size(); texture++)
+        if(entries[texture].resident)
+            residentBytes -= entries[texture].bytes;
+
+    entries.resize(textureCount);
+}
+
+void TextureResidency::clear()
+{
+    entries.clear();
+    residentBytes = 0;
+}
+
+void TextureResidency::setResident(TextureHandle texture, uint64_t bytes, uint64_t frame)
+{
+    if(texture >= entries.size())
+        entries.resize(texture + 1);
+
+    Entry &entry = entries[texture];
+
+    if(entry.resident)
+        residentBytes -= entry.bytes;
+    //         
+    else if(entry.bytes > 0)
+        streams++;
+
+    entry.resident = true;
+    entry.bytes    = bytes;
+    entry.lastUsed = frame;
+
+    residentBytes += bytes;
+}
+
+void TextureResidency::setEvicted(TextureHandle texture)
+{
+    Entry &entry = entries[texture];
+    if(!entry.resident)
+        return;
+
+    entry.resident = false;
+    residentBytes -= entry.bytes;
+    evictions++;
+}
+
+void TextureResidency::forget(TextureHandle texture)
+{
+    if(texture >= entries.size())
+        return;
+
+    Entry &entry = entries[texture];
+    if(entry.resident)
+        residentBytes -= entry.bytes;
+
+    entry.resident = false;
+    entry.bytes    = 0;
+}
+
+bool TextureResidency::isResident(TextureHandle texture) const
+{
+    return texture < entries.size() && entries[texture].resident;
+}
+
+void TextureResidency::markUsed(TextureHandle texture, uint64_t frame)
+{
+    if(texture < entries.size())
+        entries[texture].lastUsed = frame;
+}
+
+uint64_t TextureResidency::getResidentBytes() const
+{
+    return residentBytes;
+}
+
+std::vector<TextureHandle> TextureResidency::chooseEvictions(uint64_t bytesToFree,
+                                                             uint64_t lastSafeFrame) const
+{
+    std::vector<TextureHandle> candidates;
+    for(TextureHandle texture = 0; texture < entries.size(); texture++)
+        if(entries[texture].resident && entries[texture].lastUsed <= lastSafeFrame)
+            candidates.push_back(texture);
+
+    //      ,  
+    //     ,       
+    std::sort(candidates.begin(), candidates.end(),
+              [this](TextureHandle a, TextureHandle b)
+              {
+                  return entries[a].lastUsed < entries[b].lastUsed;
+              });
+
+    uint64_t freed = 0;
+    size_t   count = 0;
+    while(count < candidates.size() && freed < bytesToFree)
+        freed += entries[candidates[count++]].bytes;
+
+    candidates.resize(count);
+    return candidates;
+}
+
+TextureResidency::Stats TextureResidency::getStats() const
+{
+    Stats stats{};
+    stats.residentBytes = residentBytes;
+    stats.evictions     = evictions;
+    stats.streams       = streams;
+
+    for(const Entry &entry : entries)
+    {
+        if(entry.resident)
+            stats.residentCount++;
+        else if(entry.bytes > 0)
+            stats.evictedCount++;
+    }
+
+    return stats;
+}
+
+///////////////////////// TEXTURE RESIDENCY END //////////////////////////////
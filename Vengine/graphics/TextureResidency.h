@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Scene.h"
+
+/*
+*  ,     
+*    ,      .  
+*  ,  ,       .
+*        ,    
+*        ,   ,     
+*/
+class TextureResidency
+{
+public:
+    struct Stats
+    {
+        uint64_t residentBytes;
+        uint32_t residentCount;
+        uint32_t evictedCount;
+        //   
+        uint64_t evictions;
+        uint64_t streams;
+    };
+
+    //    
+    void resize(size_t textureCount);
+    void clear();
+
+    void setResident(TextureHandle texture, uint64_t bytes, uint64_t frame);
+    void setEvicted (TextureHandle texture);
+    //    , ,      .
+    //    setEvicted   ,      
+    void forget(TextureHandle texture);
+
+    bool isResident(TextureHandle texture) const;
+
+    void markUsed(TextureHandle texture, uint64_t frame);
+
+    uint64_t getResidentBytes() const;
+
+    //    ,      bytesToFree
+    //   ,      lastSafeFrame,
+    //       ,   
+    std::vector<TextureHandle> chooseEvictions(uint64_t bytesToFree,
+                                               uint64_t lastSafeFrame) const;
+
+    Stats getStats() const;
+
+private:
+    struct Entry
+    {
+        bool     resident = false;
+        uint64_t bytes    = 0;
+        uint64_t lastUsed = 0;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t           residentBytes = 0;
+    uint64_t           evictions     = 0;
+    uint64_t           streams       = 0;
+};
@@ -0,0 +1,466 @@
+#include "ThumbnailService.h"
+
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+
+#include "Renderer.h"
+#include "tools.h"
+
+//      stats
+static const size_t latencyWindow = 4096;
+
+//   ,     ,       
+static const size_t maxCachedResources = 256;
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+using Clock = std::chrono::steady_clock;
+
+static std::vector<std::string> splitFields(const std::string &line)
+{
+    std::vector<std::string> fields;
+
+    size_t begin = 0;
+    while(true)
+    {
+        size_t end = line.find('\t', begin);
+        fields.push_back(line.substr(begin, end - begin));
+
+        if(end == std::string::npos)
+            break;
+
+        begin = end + 1;
+    }
+
+    return fields;
+}
+
+static ThumbnailJob parseJob(const std::vector<std::string> &fields)
+{
+    if(fields.size() < 6)
+        throw std::invalid_argument("render needs id, mesh, texture, width and height");
+
+    ThumbnailJob job;
+    job.id          = fields[1];
+    job.meshPath    = fields[2];
+    job.texturePath = fields[3];
+    job.width       = std::stoul(fields[4]);
+    job.height      = std::stoul(fields[5]);
+
+    if(job.width == 0 || job.height == 0 || job.width > 4096 || job.height > 4096)
+        throw std::invalid_argument("resolution must be between 1 and 4096");
+
+    if(fields.size() > 6 && !fields[6].empty())
+    {
+        std::istringstream camera(fields[6]);
+        camera >> job.cameraPosition.x >> job.cameraPosition.y >> job.cameraPosition.z
+               >> job.cameraTarget.x   >> job.cameraTarget.y   >> job.cameraTarget.z;
+
+        if(camera.fail())
+            throw std::invalid_argument("camera needs six numbers");
+
+        job.hasCamera = true;
+    }
+
+    return job;
+}
+
+//      .     ,      
+template<typename Cache>
+static const auto &getCached(Cache &cache, const std::string &path, uint64_t use)
+{
+    auto cached = cache.find(path);
+
+    if(cached == cache.end())
+    {
+        if(cache.size() >= maxCachedResources)
+            cache.erase(std::min_element(cache.begin(), cache.end(), [](const auto &a, const auto &b)
+            {
+                return a.second.lastUsed < b.second.lastUsed;
+            }));
+
+        using Resource = decltype(cached->second.resource);
+        cached = cache.emplace(path, typename Cache::mapped_type{Resource(path), use}).first;
+    }
+
+    cached->second.lastUsed = use;
+    return cached->second.resource;
+}
+
+static std::string formatJob(const ThumbnailJob &job)
+{
+    std::ostringstream line;
+    line << "render\t" << job.id << "\t" << job.meshPath << "\t" << job.texturePath << "\t"
+         << job.width << "\t" << job.height;
+
+    if(job.hasCamera)
+        line << "\t" << job.cameraPosition.x << " " << job.cameraPosition.y << " " << job.cameraPosition.z << " "
+                     << job.cameraTarget.x   << " " << job.cameraTarget.y   << " " << job.cameraTarget.z;
+
+    line << "\n";
+    return line.str();
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// THUMBNAIL SERVICE BEG //////////////////////////////
+
+ThumbnailService::ThumbnailService(Renderer &renderer) : renderer(renderer)
+{
+}
+
+void ThumbnailService::serve(const std::string &socketPath)
+{
+    LocalSocket server = LocalSocket::listen(socketPath);
+    std::cout << "\nthumbnail service is listening on " << socketPath << "\n";
+
+    //    ,     
+    encoder.start(renderer.settings.encodeThreads, renderer.settings.serviceBatchSize);
+
+    while(running)
+    {
+        LocalSocket client = server.accept();
+
+        try
+        {
+            serveClient(client);
+        }
+        catch(std::exception &e)
+        {
+            //      
+            std::cerr << e.what() << std::endl;
+        }
+    }
+
+    vkDeviceWaitIdle(renderer.device.handle);
+    encoder.finish();
+}
+
+void ThumbnailService::serveClient(LocalSocket &client)
+{
+    std::string line;
+    bool        open = true;
+
+    while(running && open)
+    {
+        std::vector<ThumbnailJob> batch;
+
+        open = readRequest(client, line, batch);
+        if(open)
+            parseLine(client, line, batch);
+
+        // ,     ,  
+        while(open && running && batch.size() < renderer.settings.serviceBatchSize && client.hasPendingData())
+        {
+            open = readRequest(client, line, batch);
+            if(open)
+                parseLine(client, line, batch);
+        }
+
+        if(batch.empty())
+            continue;
+
+        renderBatch(batch);
+        sendResults(client, batch);
+    }
+}
+
+bool ThumbnailService::readRequest(LocalSocket               &client,
+                                   std::string               &line,
+                                   std::vector<ThumbnailJob> &batch)
+{
+    try
+    {
+        return client.readLine(line);
+    }
+    catch(std::exception &e)
+    {
+        //        ,
+        //       
+        ThumbnailJob job{};
+        job.error    = e.what();
+        job.received = Clock::now();
+
+        batch.push_back(job);
+        return false;
+    }
+}
+
+bool ThumbnailService::parseLine(LocalSocket               &client,
+                                 const std::string         &line,
+                                 std::vector<ThumbnailJob> &batch)
+{
+    std::vector<std::string> fields = splitFields(line);
+
+    if(fields[0] == "stats")
+    {
+        ThumbnailJob job{};
+        job.stats    = true;
+        job.received = Clock::now();
+
+        batch.push_back(job);
+        return false;
+    }
+
+    if(fields[0] == "quit")
+    {
+        running = false;
+        return false;
+    }
+
+    try
+    {
+        if(fields[0] != "render")
+            throw std::invalid_argument("unknown command " + fields[0]);
+
+        ThumbnailJob job = parseJob(fields);
+        job.received = Clock::now();
+
+        batch.push_back(job);
+        return true;
+    }
+    catch(std::exception &e)
+    {
+        ThumbnailJob job{};
+        job.id       = fields.size() > 1 ? fields[1] : std::string();
+        job.error    = e.what();
+        job.received = Clock::now();
+
+        batch.push_back(job);
+        return false;
+    }
+}
+
+const Mesh &ThumbnailService::getMesh(const std::string &path)
+{
+    return getCached(meshCache, path, ++cacheUses);
+}
+
+const Texture &ThumbnailService::getTexture(const std::string &path)
+{
+    return getCached(textureCache, path, ++cacheUses);
+}
+
+void ThumbnailService::renderBatch(std::vector<ThumbnailJob> &jobs)
+{
+    PROFILE_ZONE("renderThumbnailBatch");
+
+    Clock::time_point batchBegin = Clock::now();
+
+    //         
+    Scene                                scene;
+    std::map<std::string, MeshHandle>    meshHandles;
+    std::map<std::string, TextureHandle> textureHandles;
+
+    std::vector<size_t>         order;
+    std::vector<MeshHandle>     jobMeshes(jobs.size());
+    std::vector<TextureHandle>  jobTextures(jobs.size());
+    std::vector<BoundingSphere> spheres(jobs.size());
+
+    for(size_t i = 0; i < jobs.size(); i++)
+    {
+        // ,    ,   stats      
+        if(!jobs[i].error.empty() || jobs[i].stats)
+            continue;
+
+        try
+        {
+            const Mesh    &mesh    = getMesh(jobs[i].meshPath);
+            const Texture &texture = getTexture(jobs[i].texturePath);
+
+            if(!meshHandles.count(jobs[i].meshPath))
+                meshHandles[jobs[i].meshPath] = scene.addMesh(mesh);
+
+            if(!textureHandles.count(jobs[i].texturePath))
+                textureHandles[jobs[i].texturePath] = scene.addTexture(texture);
+
+            jobMeshes[i]   = meshHandles[jobs[i].meshPath];
+            jobTextures[i] = textureHandles[jobs[i].texturePath];
+            spheres[i]     = mesh.sphere;
+
+            order.push_back(i);
+        }
+        catch(std::exception &e)
+        {
+            jobs[i].error = e.what();
+        }
+    }
+
+    if(order.empty())
+        return;
+
+    //      reach     
+    float reach = 0.0f;
+    for(size_t i : order)
+    {
+        const ThumbnailJob &job = jobs[i];
+
+        float jobReach = glm::length(spheres[i].center) + 3.0f * spheres[i].radius;
+        if(job.hasCamera)
+            jobReach = std::max(jobReach, std::max(glm::length(job.cameraPosition), glm::length(job.cameraTarget)) + 2.0f * spheres[i].radius);
+
+        reach = std::max(reach, jobReach);
+    }
+
+    //    2 * reach,       5 * reach - 2 * reach,
+    //        
+    float spacing = 5.0f * reach + 1.0f;
+
+    for(size_t i : order)
+        scene.addObject(jobMeshes[i], jobTextures[i], glm::vec3(spacing * i, 0.0f, 0.0f));
+
+    renderer.setScene(scene);
+    renderer.pushScene();
+
+    //     ,    
+    std::stable_sort(order.begin(), order.end(), [&jobs](size_t a, size_t b)
+    {
+        return std::make_pair(jobs[a].width, jobs[a].height) < std::make_pair(jobs[b].width, jobs[b].height);
+    });
+
+    for(size_t i : order)
+    {
+        ThumbnailJob &job = jobs[i];
+
+        if(renderer.swapChain.extent.width != job.width || renderer.swapChain.extent.height != job.height)
+        {
+            renderer.settings.windowWidth  = job.width;
+            renderer.settings.windowHeight = job.height;
+            renderer.recreateSwapChain();
+        }
+
+        glm::vec3 origin(spacing * i, 0.0f, 0.0f);
+
+        Camera &camera = renderer.camera;
+        camera.farPlane  = 2.0f * reach;
+        camera.nearPlane = camera.farPlane / 1000.0f;
+        camera.up        = glm::vec3(0.0f, 1.0f, 0.0f);
+
+        if(job.hasCamera)
+        {
+            camera.position = origin + job.cameraPosition;
+            camera.target   = origin + job.cameraTarget;
+        }
+        else
+        {
+            camera.target   = origin + spheres[i].center;
+            camera.position = camera.target + glm::normalize(glm::vec3(1.0f, 0.8f, 1.0f)) * spheres[i].radius * 2.2f;
+        }
+
+        renderer.readback.waitForFreeSlot();
+        renderer.captureFrame([this, &job](const ReadbackImage &image)
+        {
+            //       RGBA,   
+            std::vector<Pixel> pixels(image.width * image.height);
+            memcpy(pixels.data(), image.pixels, pixels.size() * sizeof(Pixel));
+
+            //  ,     
+            encoder.encodePng(image.width, image.height, std::move(pixels), job.png);
+        });
+
+        renderer.drawFrame();
+    }
+
+    vkDeviceWaitIdle(renderer.device.handle);
+    renderer.readback.flush();
+    encoder.wait();
+
+    batches++;
+
+    double batchSeconds = std::chrono::duration<double>(Clock::now() - batchBegin).count();
+    busySeconds += batchSeconds;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "thumbnail batch: " << order.size() << " jobs, " << batchSeconds * 1000.0 << " ms, "
+              << order.size() / batchSeconds << " jobs/s\n";
+    std::cout.unsetf(std::ios_base::floatfield);
+}
+
+void ThumbnailService::sendResults(LocalSocket &client, std::vector<ThumbnailJob> &jobs)
+{
+    for(ThumbnailJob &job : jobs)
+    {
+        if(job.stats)
+        {
+            client.write(getStatsLine());
+            continue;
+        }
+
+        if(!job.error.empty())
+        {
+            client.write("error\t" + job.id + "\t" + job.error + "\n");
+            continue;
+        }
+
+        float latency = std::chrono::duration<float, std::milli>(Clock::now() - job.received).count();
+
+        client.write("ok\t" + job.id + "\t" + std::to_string(job.png.size()) + "\t" + std::to_string(latency) + "\n");
+        client.write(job.png.data(), job.png.size());
+
+        completedJobs++;
+        addLatency(latency);
+    }
+}
+
+void ThumbnailService::addLatency(float milliseconds)
+{
+    if(latencies.size() < latencyWindow)
+        latencies.push_back(milliseconds);
+    else
+        latencies[nextLatency] = milliseconds;
+
+    nextLatency = (nextLatency + 1) % latencyWindow;
+}
+
+std::string ThumbnailService::getStatsLine() const
+{
+    std::vector<float> sorted = latencies;
+    std::sort(sorted.begin(), sorted.end());
+
+    float sum = 0.0f;
+    for(float latency : sorted)
+        sum += latency;
+
+    float average = sorted.empty() ? 0.0f : sum / sorted.size();
+    float p99     = sorted.empty() ? 0.0f : sorted[std::min(sorted.size() - 1, sorted.size() * 99 / 100)];
+
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(3)
+         << "stats\tjobs " << completedJobs
+         << "\tbatches " << batches
+         << "\tjobs_per_second " << completedJobs / std::max(busySeconds, 1e-9)
+         << "\tlatency_avg_ms " << average
+         << "\tlatency_p99_ms " << p99 << "\n";
+
+    return line.str();
+}
+
+std::vector<unsigned char> ThumbnailService::request(const std::string  &socketPath,
+                                                     const ThumbnailJob &job)
+{
+    LocalSocket server = LocalSocket::connect(socketPath);
+    server.write(formatJob(job));
+
+    std::string line;
+    if(!server.readLine(line))
+        throw std::runtime_error("thumbnail service closed the connection!");
+
+    std::vector<std::string> fields = splitFields(line);
+
+    if(fields[0] != "ok" || fields.size() < 4)
+        throw std::runtime_error("thumbnail service failed: " + (fields.size() > 2 ? fields[2] : line));
+
+    std::vector<unsigned char> png(std::stoul(fields[2]));
+    if(!server.readBytes(png.data(), png.size()))
+        throw std::runtime_error("thumbnail service closed the connection!");
+
+    std::cout << "thumbnail " << job.id << ": " << png.size() << " bytes, latency " << fields[3] << " ms\n";
+
+    return png;
+}
+
+///////////////////////// THUMBNAIL SERVICE END //////////////////////////////
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+
+#include "Mesh.h"
+#include "Texture.h"
+#include "LocalSocket.h"
+#include "ImageEncoderPool.h"
+
+class Renderer;
+
+struct ThumbnailJob
+{
+    std::string id;
+    std::string meshPath;
+    std::string texturePath;
+    uint32_t    width;
+    uint32_t    height;
+
+    //    ,    ,   
+    //        
+    bool        hasCamera = false;
+    glm::vec3   cameraPosition;
+    glm::vec3   cameraTarget;
+
+    std::chrono::steady_clock::time_point received;
+
+    std::vector<unsigned char> png;
+    std::string                error;
+    //  stats:    ,     
+    bool                       stats = false;
+};
+
+/*
+*  .    Unix       ,
+*           
+*
+*  -  ,   :
+*   render  id          [px py pz tx ty tz]
+*   stats
+*   quit
+*   render -  "ok id  _"   PNG  ,
+*   "error id ".   render  stats    
+*   stats -    ,      
+*  (   )  
+*
+* ,      ,   :   
+*   ,   ,      
+*   ,         . 
+*    :   -        
+*  .   PNG    encoder,    
+*/
+class ThumbnailService
+{
+public:
+    explicit ThumbnailService(Renderer &renderer);
+
+    //    ,       quit
+    void serve(const std::string &socketPath);
+
+    //      .       
+    static std::vector<unsigned char> request(const std::string  &socketPath,
+                                              const ThumbnailJob &job);
+
+private:
+    Renderer &renderer;
+
+    //        .   ,
+    //   ,      
+    template<typename Resource>
+    struct CachedResource
+    {
+        Resource resource;
+        uint64_t lastUsed;
+    };
+
+    std::map<std::string, CachedResource<Mesh>>    meshCache;
+    std::map<std::string, CachedResource<Texture>> textureCache;
+    uint64_t                                       cacheUses = 0;
+
+    ImageEncoderPool encoder;
+
+    uint64_t                              completedJobs = 0;
+    uint64_t                              batches       = 0;
+    //      
+    double                                busySeconds   = 0.0;
+    //     
+    std::vector<float>                    latencies;
+    size_t                                nextLatency   = 0;
+
+    bool running = true;
+
+    void serveClient(LocalSocket &client);
+    // false,       .  
+    //    ,         
+    bool readRequest(LocalSocket &client, std::string &line, std::vector<ThumbnailJob> &batch);
+    // false,     render: quit  ,  stats
+    //      batch,        
+    bool parseLine(LocalSocket &client, const std::string &line, std::vector<ThumbnailJob> &batch);
+
+    void renderBatch(std::vector<ThumbnailJob> &jobs);
+    void sendResults(LocalSocket &client, std::vector<ThumbnailJob> &jobs);
+
+    const Mesh    &getMesh   (const std::string &path);
+    const Texture &getTexture(const std::string &path);
+
+    void        addLatency(float milliseconds);
+    std::string getStatsLine() const;
+};
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+///////////////////////// WORKER POOL BEG //////////////////////////////
+
+WorkerPool::WorkerPool()
+{
+    work            = nullptr;
+    taskCount       = 0;
+    nextTask        = 0;
+    unfinishedTasks = 0;
+    stopping        = false;
+}
+
+WorkerPool::~WorkerPool()
+{
+    stop();
+}
+
+void WorkerPool::start(uint32_t threadCount)
+{
+    if(threadCount == 0)
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    stopping = false;
+
+    //    - ,   run
+    for(uint32_t i = 1; i < threadCount; i++)
+        threads.emplace_back(&WorkerPool::workLoop, this);
+}
+
+uint32_t WorkerPool::getThreadCount() const
+{
+    return static_cast<uint32_t>(threads.size() + 1);
+}
+
+void WorkerPool::run(size_t                             taskCount,
+                     const std::function<void(size_t)> &work)
+{
+    //      ,    
+    if(threads.empty() || taskCount <= 1)
+    {
+        for(size_t task = 0; task < taskCount; task++)
+            work(task);
+
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    this->work      = &work;
+    this->taskCount = taskCount;
+    nextTask        = 0;
+    unfinishedTasks = taskCount;
+
+    workAdded.notify_all();
+
+    while(runNextTask(lock))
+        ;
+
+    workFinished.wait(lock, [this]() { return unfinishedTasks == 0; });
+
+    this->work = nullptr;
+}
+
+void WorkerPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAdded.notify_all();
+
+    for(std::thread &thread : threads)
+        thread.join();
+
+    threads.clear();
+}
+
+bool WorkerPool::runNextTask(std::unique_lock<std::mutex> &lock)
+{
+    if(!work || nextTask >= taskCount)
+        return false;
+
+    size_t                             task     = nextTask++;
+    const std::function<void(size_t)> &taskWork = *work;
+
+    lock.unlock();
+    taskWork(task);
+    lock.lock();
+
+    if(--unfinishedTasks == 0)
+        workFinished.notify_all();
+
+    return true;
+}
+
+void WorkerPool::workLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while(true)
+    {
+        workAdded.wait(lock, [this]() { return stopping || (work && nextTask < taskCount); });
+
+        if(stopping)
+            return;
+
+        runNextTask(lock);
+    }
+}
+
+///////////////////////// WORKER POOL END //////////////////////////////
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <condition_variable>
+
+/*
+*      ,    
+*        run ,   
+*   ,       
+* run         ,   
+*/
+class WorkerPool
+{
+public:
+    WorkerPool();
+    ~WorkerPool();
+
+    // threadCount -    ,   run. 0 -    
+    void start(uint32_t threadCount = 0);
+
+    //    ,   run.  start - 1
+    uint32_t getThreadCount() const;
+
+    //  work(task)   task  0  taskCount - 1  ,   
+    void run(size_t                             taskCount,
+             const std::function<void(size_t)> &work);
+
+    void stop();
+
+private:
+    std::vector<std::thread>  threads;
+
+    std::mutex                mutex;
+    std::condition_variable   workAdded;
+    std::condition_variable   workFinished;
+
+    //   run. work ,  run  
+    const std::function<void(size_t)> *work;
+    size_t                             taskCount;
+    size_t                             nextTask;
+    size_t                             unfinishedTasks;
+    bool                               stopping;
+
+    //        . false,    
+    bool runNextTask(std::unique_lock<std::mutex> &lock);
+
+    void workLoop();
+};
@@ -7,13 +7,55 @@ vkSettings::vkSettings()
     windowWidth  = 800;
     windowHeight = 600;
 
+    presentMode         = VK_PRESENT_MODE_MAILBOX_KHR;
+    swapchainImageCount = 0;
+    framesInFlight      = 2;
+
+    headless            = false;
+    headlessFrames      = 500;
+
+    measureLatency    = false;
+    measurementFrames = 500;
+
+    instancing        = true;
+    compareInstancing = false;
+
+    frustumCulling    = true;
+    gpuCulling        = false;
+
+    lod               = true;
+    lodErrorPixels    = 1.0f;
+    reportLod         = false;
+    reportDrawState   = false;
+
+    maxTextureCount   = 4096;
+    textureBudgetMB   = 0;
+
+    reportTextureResidency = false;
+    mipStreaming           = true;
+    atlasMaxTextureSize    = 64;
+    shaderHotReload        = true;
+
+    gpuProfiling      = false;
+
+    readbackSlots     = 3;
+
+    offlineFrames     = 0;
+    offlinePath       = "frames/frame_%04u.png";
+    encodeThreads     = 0;
+
+    servicePath       = "";
+    serviceBatchSize  = 32;
+
     validationLayers = {
         "VK_LAYER_KHRONOS_validation"
     };
 
     instanceExtensions = {};
     deviceExtensions = { 
-        VK_KHR_SWAPCHAIN_EXTENSION_NAME 
+        VK_KHR_SWAPCHAIN_EXTENSION_NAME,
+        VK_KHR_MAINTENANCE3_EXTENSION_NAME,
+        VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME
     };
 };
 
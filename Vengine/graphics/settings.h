@@ -22,5 +22,108 @@ struct vkSettings
     std::string model_path;
     std::string texture_path;
 
+    //   .  VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR,
+    // VK_PRESENT_MODE_FIFO_KHR  VK_PRESENT_MODE_FIFO_RELAXED_KHR
+    //      ,   FIFO
+    VkPresentModeKHR presentMode;
+
+    //     
+    // 0 -      + 1
+    uint32_t swapchainImageCount;
+
+    //        windowWidth x windowHeight
+    //  Renderer       ,   lavapipe
+    // run()  headlessFrames ,     
+    //         
+    bool     headless;
+    uint32_t headlessFrames;
+
+    //         
+    uint32_t framesInFlight;
+
+    //   . Renderer     ,
+    //            
+    //         
+    bool     measureLatency;
+    uint32_t measurementFrames;
+
+    //           vkCmdDrawIndexed
+    bool     instancing;
+
+    //   ,        
+    bool     frustumCulling;
+
+    //    ,      
+    //   run().  ,   Renderer::loadCullingShaders
+    bool     gpuCulling;
+
+    //            
+    //    ,       lodErrorPixels
+    bool     lod;
+    float    lodErrorPixels;
+
+    //          measurementFrames 
+    //          
+    bool     reportLod;
+
+    //           
+    //  ,    
+    bool     reportDrawState;
+
+    //   .        ,
+    //       .    ,   
+    uint32_t maxTextureCount;
+
+    //     . ,     ,
+    //    ,     
+    // 0 -    VK_EXT_memory_budget,    80%  
+    uint32_t textureBudgetMB;
+    //       
+    bool     reportTextureResidency;
+
+    //        ,  
+    //  .      
+    bool     mipStreaming;
+
+    // ,        ,   
+    //  ,       . 0 -  
+    uint32_t atlasMaxTextureSize;
+
+    //        ,   SPIR-V
+    // .       .    
+    bool     shaderHotReload;
+
+    //   , ,      
+    //    measurementFrames     min/avg/p99  
+    bool     gpuProfiling;
+
+    // ,             
+    //   Chrome trace_event.   -   
+    std::string tracePath;
+
+    //        .   
+    // ,   ,    
+    uint32_t    readbackSlots;
+
+    //        .   -  
+    std::string screenshotPath;
+
+    //   .  offlineFrames > 0, run()     
+    //   ,  Renderer::setCameraPath,      
+    // offlinePath -     printf   ,  frames/frame_%04u.png
+    //    encodeThreads , 0 -   
+    uint32_t    offlineFrames;
+    std::string offlinePath;
+    uint32_t    encodeThreads;
+
+    //   .  servicePath  , run()       
+    //    .     serviceBatchSize 
+    std::string servicePath;
+    uint32_t    serviceBatchSize;
+
+    //   . Renderer  measurementFrames  
+    //                
+    bool     compareInstancing;
+
     vkSettings();
 };
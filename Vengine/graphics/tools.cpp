@@ -1,4 +1,7 @@
 ﻿#include "tools.h"
+#include "Profiler.h"
+
+#include <array>
 
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "libraries/tiny_obj_loader.h"
@@ -27,6 +30,133 @@ static std::vector<char> loadFile(const std::string &filename)
         return buffer;
 }
 
+// двоичный PPM, его открывает большинство просмотрщиков. Альфа-канал не пишется
+static void writePpm(std::ofstream            &file,
+                     int                       width,
+                     int                       height,
+                     const std::vector<Pixel> &pixels)
+{
+    file << "P6\n" << width << " " << height << "\n255\n";
+
+    std::vector<unsigned char> row(width * 3);
+    for(int y = 0; y < height; y++)
+    {
+        for(int x = 0; x < width; x++)
+        {
+            const Pixel &pixel = pixels[y * width + x];
+            row[x * 3 + 0] = pixel.r;
+            row[x * 3 + 1] = pixel.g;
+            row[x * 3 + 2] = pixel.b;
+        }
+
+        file.write(reinterpret_cast<const char *>(row.data()), row.size());
+    }
+}
+
+static uint32_t crc32(const unsigned char *data, size_t size, uint32_t crc = 0)
+{
+    // потоки кодирования считают контрольные суммы одновременно, поэтому таблица строится
+    // при инициализации локальной статической переменной, которая потокобезопасна
+    static const std::array<uint32_t, 256> table = []()
+    {
+        std::array<uint32_t, 256> values{};
+        for(uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t value = i;
+            for(int bit = 0; bit < 8; bit++)
+                value = value & 1 ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+
+            values[i] = value;
+        }
+        return values;
+    }();
+
+    crc = ~crc;
+    for(size_t i = 0; i < size; i++)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+
+    return ~crc;
+}
+
+static void appendBigEndian(std::vector<unsigned char> &data, uint32_t value)
+{
+    data.push_back(static_cast<unsigned char>(value >> 24));
+    data.push_back(static_cast<unsigned char>(value >> 16));
+    data.push_back(static_cast<unsigned char>(value >> 8));
+    data.push_back(static_cast<unsigned char>(value));
+}
+
+static void appendPngChunk(std::vector<unsigned char>       &png,
+                           const char                       *type,
+                           const std::vector<unsigned char> &data)
+{
+    size_t chunkBegin = png.size();
+
+    appendBigEndian(png, static_cast<uint32_t>(data.size()));
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+
+    // контрольная сумма считается по типу и данным, без длины
+    appendBigEndian(png, crc32(png.data() + chunkBegin + 4, png.size() - chunkBegin - 4));
+}
+
+/*
+* Данные zlib из несжатых блоков deflate для PNG
+* Файл в несколько раз больше сжатого, зато запись почти не тратит процессор
+*/
+static std::vector<unsigned char> encodeStoredZlib(int                       width,
+                                                   int                       height,
+                                                   const std::vector<Pixel> &pixels)
+{
+    // каждая строка начинается с байта фильтра, 0 - без фильтра
+    size_t rowSize = width * sizeof(Pixel);
+    std::vector<unsigned char> scanlines;
+    scanlines.reserve((rowSize + 1) * height);
+
+    for(int y = 0; y < height; y++)
+    {
+        const unsigned char *row = reinterpret_cast<const unsigned char *>(pixels.data() + y * width);
+
+        scanlines.push_back(0);
+        scanlines.insert(scanlines.end(), row, row + rowSize);
+    }
+
+    const size_t maxBlockSize = 65535;
+
+    std::vector<unsigned char> data = {0x78, 0x01};
+    data.reserve(scanlines.size() + scanlines.size() / maxBlockSize * 5 + 16);
+
+    uint32_t adlerA = 1;
+    uint32_t adlerB = 0;
+
+    for(size_t offset = 0; offset < scanlines.size() || offset == 0; offset += maxBlockSize)
+    {
+        size_t blockSize = std::min(maxBlockSize, scanlines.size() - offset);
+        bool   lastBlock = offset + blockSize >= scanlines.size();
+
+        data.push_back(lastBlock ? 1 : 0);
+        data.push_back(static_cast<unsigned char>(blockSize));
+        data.push_back(static_cast<unsigned char>(blockSize >> 8));
+        data.push_back(static_cast<unsigned char>(~blockSize));
+        data.push_back(static_cast<unsigned char>(~blockSize >> 8));
+
+        data.insert(data.end(), scanlines.begin() + offset, scanlines.begin() + offset + blockSize);
+
+        for(size_t i = offset; i < offset + blockSize; i++)
+        {
+            adlerA = (adlerA + scanlines[i]) % 65521;
+            adlerB = (adlerB + adlerA)       % 65521;
+        }
+
+        if(lastBlock)
+            break;
+    }
+
+    appendBigEndian(data, (adlerB << 16) | adlerA);
+
+    return data;
+}
+
 ///////////////////////// STATIC END //////////////////////////////
 
 
@@ -39,6 +169,8 @@ namespace VengineTools
                   std::vector<Vertex>   &vertices,
                   std::vector<uint32_t> &indices)
     {
+        PROFILE_ZONE("loadMesh");
+
         tinyobj::attrib_t attrib;
         std::vector<tinyobj::shape_t> shapes;
         std::vector<tinyobj::material_t> materials;
@@ -79,6 +211,8 @@ namespace VengineTools
                    int                &loadedChannels,
                    std::vector<Pixel> &pixels)
     {
+        PROFILE_ZONE("loadImage");
+
         stbi_uc *rawPixels = stbi_load(path.c_str(),
                                        &loadedWidth,
                                        &loadedHeight,
@@ -99,6 +233,49 @@ namespace VengineTools
     }
 
 
+    void saveImage(const std::string        &path,
+                   int                       width,
+                   int                       height,
+                   const std::vector<Pixel> &pixels)
+    {
+        std::ofstream file(path, std::ios::binary);
+        if(!file.is_open())
+            throw std::runtime_error("failed to open image file! " + path);
+
+        std::string extension = path.size() >= 4 ? path.substr(path.size() - 4) : "";
+
+        if(extension == ".png")
+        {
+            std::vector<unsigned char> png = encodePng(width, height, pixels);
+            file.write(reinterpret_cast<const char *>(png.data()), png.size());
+        }
+        // пиксели RGBA подряд без заголовка
+        else if(extension == ".raw")
+            file.write(reinterpret_cast<const char *>(pixels.data()), pixels.size() * sizeof(Pixel));
+        else
+            writePpm(file, width, height, pixels);
+    }
+
+
+    std::vector<unsigned char> encodePng(int                       width,
+                                         int                       height,
+                                         const std::vector<Pixel> &pixels)
+    {
+        std::vector<unsigned char> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+        std::vector<unsigned char> header;
+        appendBigEndian(header, width);
+        appendBigEndian(header, height);
+        header.insert(header.end(), {8, 6, 0, 0, 0}); // 8 бит на канал, RGBA
+
+        appendPngChunk(png, "IHDR", header);
+        appendPngChunk(png, "IDAT", encodeStoredZlib(width, height, pixels));
+        appendPngChunk(png, "IEND", {});
+
+        return png;
+    }
+
+
     std::vector<char> loadShader(const std::string &filename)
     {
         return loadFile(filename);
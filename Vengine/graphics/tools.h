@@ -19,5 +19,17 @@ namespace VengineTools
                    int                &loadedChannels,
                    std::vector<Pixel> &pixels);
 
+    //    : .png - PNG  , .raw -  RGBA ,
+    //  - PPM
+    void saveImage(const std::string        &path,
+                   int                       width,
+                   int                       height,
+                   const std::vector<Pixel> &pixels);
+
+    // PNG    ,     
+    std::vector<unsigned char> encodePng(int                       width,
+                                         int                       height,
+                                         const std::vector<Pixel> &pixels);
+
     std::vector<char> loadShader(const std::string &filename);
 }
\ No newline at end of file
@@ -42,4 +42,47 @@ std::array<VkVertexInputAttributeDescription, 3> Vertex::getAttributeDescription
     return attributeDescriptions;
 }
 
-///////////////////////// VERTEX END //////////////////////////////
\ No newline at end of file
+///////////////////////// VERTEX END //////////////////////////////
+
+
+
+///////////////////////// INSTANCE DATA BEG //////////////////////////////
+
+VkVertexInputBindingDescription InstanceData::getBindingDescription()
+{
+    VkVertexInputBindingDescription bindingDescription{};
+    bindingDescription.binding   = 1;
+    bindingDescription.stride    = sizeof(InstanceData);
+    //        ,   
+    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+    return bindingDescription;
+}
+
+std::array<VkVertexInputAttributeDescription, 6> InstanceData::getAttributeDescriptions()
+{
+    std::array<VkVertexInputAttributeDescription, 6> attributeDescriptions{};
+
+    //       vec4,     
+    for(uint32_t column = 0; column < 4; column++)
+    {
+        attributeDescriptions[column].binding  = 1;
+        attributeDescriptions[column].location = 3 + column;
+        attributeDescriptions[column].format   = VK_FORMAT_R32G32B32A32_SFLOAT;
+        attributeDescriptions[column].offset   = offsetof(InstanceData, model) + sizeof(glm::vec4) * column;
+    }
+
+    attributeDescriptions[4].binding  = 1;
+    attributeDescriptions[4].location = 7;
+    attributeDescriptions[4].format   = VK_FORMAT_R32G32B32A32_SFLOAT;
+    attributeDescriptions[4].offset   = offsetof(InstanceData, tint);
+
+    attributeDescriptions[5].binding  = 1;
+    attributeDescriptions[5].location = 8;
+    attributeDescriptions[5].format   = VK_FORMAT_R32G32B32A32_SFLOAT;
+    attributeDescriptions[5].offset   = offsetof(InstanceData, uvRect);
+
+    return attributeDescriptions;
+}
+
+///////////////////////// INSTANCE DATA END //////////////////////////////
\ No newline at end of file
@@ -17,3 +17,21 @@ struct Vertex
     static VkVertexInputBindingDescription getBindingDescription();
     static std::array<VkVertexInputAttributeDescription, 3> getAttributeDescriptions();
 };
+
+/*
+*    .       
+*   VK_VERTEX_INPUT_RATE_INSTANCE,      
+*      
+*/
+struct InstanceData
+{
+    glm::mat4 model;
+    glm::vec4 tint;
+    //   ,    : xy - , zw - .
+    //      (1, 1, 0, 0)
+    glm::vec4 uvRect;
+
+    static VkVertexInputBindingDescription getBindingDescription();
+    //   4 location ,    
+    static std::array<VkVertexInputAttributeDescription, 6> getAttributeDescriptions();
+};
@@ -1,61 +1,60 @@
 #include "buffer.h"
 
 #include <stdexcept>
+#include <utility>
 
-#include "commandBuffer.h"
+#include "uploadBatch.h"
 
 ///////////////////////// STATIC BEG //////////////////////////////
 
-static uint32_t findMemoryType(VkPhysicalDevice       physicalDevice,
-                               uint32_t               typeFilter,
-                               VkMemoryPropertyFlags  properties)
+static void setupAsStagingBuffer(VkDeviceSize bufferSize,
+                                 Buffer       &buffer)
 {
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
-
-    for(uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
-    {
-        //   ,      
-        // true          
-        if((typeFilter & (1 << i)) &&
-           //   memoryTypes    ,
-           //      
-           //      CPU
-           (memProperties.memoryTypes[i].propertyFlags & properties) == properties)
-        {
-            return i;
-        }
-    }
-
-    throw std::runtime_error("failed to find suitable memory type!");
+    buffer.create(bufferSize, 
+                  VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                  VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 }
 
-
-static void copyBuffer(CommandPool          &commandPool,
-                       Buffer               &srcBuffer,
-                       Buffer               &dstBuffer,
-                       VkDeviceSize         size)
+//        ,
+//   ,      
+static void setupAsInstanceBuffer(VkDeviceSize bufferSize,
+                                  Buffer       &buffer)
 {
-    VkCommandBuffer commandBuffer;
-    commandBuffer = beginSingleTimeCommands(commandPool);
+     buffer.create(bufferSize,
+                   VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, 
+                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | 
+                   VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+}
 
-    VkBufferCopy copyRegion{};
-    copyRegion.size = size;
-    vkCmdCopyBuffer(commandBuffer, 
-                    srcBuffer.handle, 
-                    dstBuffer.handle, 
-                    1, &copyRegion);
+static void setupAsIndirectBuffer(VkDeviceSize bufferSize,
+                                  Buffer       &buffer)
+{
+     buffer.create(bufferSize,
+                   VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, 
+                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | 
+                   VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+}
 
-    endSingleTimeCommands(commandPool, commandBuffer);
+static void setupAsStorageBuffer(VkDeviceSize bufferSize,
+                                 Buffer       &buffer)
+{
+     buffer.create(bufferSize,
+                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, 
+                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | 
+                   VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 }
 
-static void setupAsStagingBuffer(VkDeviceSize bufferSize,
+static void setupAsCounterBuffer(VkDeviceSize bufferSize,
                                  Buffer       &buffer)
 {
-    buffer.create(bufferSize, 
-                  VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                  VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+     buffer.create(bufferSize,
+                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT  |
+                   VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                   VK_BUFFER_USAGE_TRANSFER_DST_BIT, 
+                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 }
 
 static void setupAsUniformBuffer(VkDeviceSize bufferSize,
@@ -68,36 +67,20 @@ static void setupAsUniformBuffer(VkDeviceSize bufferSize,
 }
 
 
-static void transferBufferToGPU(CommandPool            &commandPool,
-                                VkBufferUsageFlagBits   usage,
-                                Buffer                 &srcBuffer,
-                                Buffer                 &gpuBuffer)
-{
-    gpuBuffer.setDevice(commandPool.device);
-    gpuBuffer.create(srcBuffer.size,
-                     VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-                     usage,
-                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-    copyBuffer(commandPool, 
-               srcBuffer, 
-               gpuBuffer, 
-               srcBuffer.size);
-}
-
-
-static void transferDataToGPU(CommandPool            &commandPool,
+//    ,   ,     
+static void transferDataToGPU(UploadBatch            &upload,
                               VkDeviceSize            dataSize,
                               const void             *data,
-                              VkBufferUsageFlagBits   usage,
+                              VkBufferUsageFlags      usage,
                               Buffer                 &bufferOnGpu)
 {
-    Buffer stagingBuffer(commandPool.device);
-    setupAsStagingBuffer(dataSize, stagingBuffer);
-
-    stagingBuffer.mapMemory(dataSize, data);
+    bufferOnGpu.setDevice(upload.device);
+    bufferOnGpu.create(dataSize,
+                       VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                       usage,
+                       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-    transferBufferToGPU(commandPool, usage, stagingBuffer, bufferOnGpu);
+    upload.copyToBuffer(data, dataSize, bufferOnGpu);
 }
 
 ///////////////////////// STATIC END //////////////////////////////
@@ -111,7 +94,9 @@ Buffer::Buffer()
     this->device = VK_NULL_HANDLE;
     this->handle = VK_NULL_HANDLE;
     this->memory = VK_NULL_HANDLE;
+    this->mapped = nullptr;
     this->size   = 0;
+    this->alive  = false;
 }
 
 Buffer::Buffer(const LogicalDevice *device) : Buffer()
@@ -124,6 +109,34 @@ Buffer::~Buffer()
     destroy();
 }
 
+Buffer::Buffer(Buffer &&other) noexcept : Buffer()
+{
+    *this = std::move(other);
+}
+
+Buffer &Buffer::operator=(Buffer &&other) noexcept
+{
+    if(this == &other)
+        return *this;
+
+    destroy();
+
+    handle = other.handle;
+    size   = other.size;
+    device = other.device;
+    alive  = other.alive;
+    memory = other.memory;
+    mapped = other.mapped;
+
+    other.handle = VK_NULL_HANDLE;
+    other.memory = VK_NULL_HANDLE;
+    other.mapped = nullptr;
+    other.alive  = false;
+    other.size   = 0;
+
+    return *this;
+}
+
 void Buffer::create(VkDeviceSize           size,
                     VkBufferUsageFlags     usage,
                     VkMemoryPropertyFlags  properties)
@@ -152,10 +165,28 @@ void Buffer::mapMemory(VkDeviceSize  dataSize,
     vkUnmapMemory(this->device->handle, this->memory);
 }
 
+void *Buffer::map()
+{
+    if(!mapped)
+        vkMapMemory(this->device->handle, this->memory, 0, VK_WHOLE_SIZE, 0, &mapped);
+
+    return mapped;
+}
+
+void Buffer::unmap()
+{
+    if(mapped)
+    {
+        vkUnmapMemory(this->device->handle, this->memory);
+        mapped = nullptr;
+    }
+}
+
 void Buffer::destroy()
 {
     if(alive)
     {
+        unmap();
         vkDestroyBuffer(device->handle, handle, nullptr);
         vkFreeMemory(device->handle, memory, nullptr);
         handle = VK_NULL_HANDLE;
@@ -203,6 +234,31 @@ void Buffer::allocateMemory(const VkMemoryRequirements &memRequirements,
 
 ///////////////////////// PUBLIC BEG ///////////////////////////////////
 
+uint32_t findMemoryType(VkPhysicalDevice       physicalDevice,
+                        uint32_t               typeFilter,
+                        VkMemoryPropertyFlags  properties)
+{
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+    for(uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
+    {
+        //   ,      
+        // true          
+        if((typeFilter & (1 << i)) &&
+           //   memoryTypes    ,
+           //      
+           //      CPU
+           (memProperties.memoryTypes[i].propertyFlags & properties) == properties)
+        {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("failed to find suitable memory type!");
+}
+
+
 void createStagingBuffer(VkDeviceSize bufferSize,
                          Buffer       &buffer)
 {
@@ -210,13 +266,13 @@ void createStagingBuffer(VkDeviceSize bufferSize,
 }
 
 
-void createVertexBuffer(CommandPool               &commandPool,
+void createVertexBuffer(UploadBatch               &upload,
                         const std::vector<Vertex> &vertices,
                         Buffer                    &vertexBuffer)
 {
     VkDeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
 
-    transferDataToGPU(commandPool,
+    transferDataToGPU(upload,
                       bufferSize,
                       vertices.data(),
                       VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
@@ -224,13 +280,13 @@ void createVertexBuffer(CommandPool               &commandPool,
 }
 
 
-void createIndexBuffer(CommandPool                 &commandPool,
+void createIndexBuffer(UploadBatch                 &upload,
                        const std::vector<uint32_t> &indices,
                        Buffer                      &indexBuffer)
 {
     VkDeviceSize bufferSize = sizeof(indices[0]) * indices.size();
 
-    transferDataToGPU(commandPool,
+    transferDataToGPU(upload,
                       bufferSize,
                       indices.data(),
                       VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
@@ -253,47 +309,76 @@ void createUniformBuffers(const LogicalDevice         &device,
     }
 }
 
-void updateUniformBuffer(VkDevice                    logicalDevice,
-                         uint32_t                    currentImage,
-                         VkExtent2D                  swapChainExtent,
-                         glm::vec3                   position,
-                         glm::vec3                   rotation,
-                         glm::vec3                   scale,
-                         std::vector<Buffer>         &uniformBuffers)
+void createInstanceBuffers(const LogicalDevice         &device,
+                           std::vector<Buffer>         &instanceBuffers,
+                           uint32_t                     instanceCapacity,
+                           uint32_t                     amount)
 {
-    UniformBufferObject ubo{};
+    VkDeviceSize bufferSize = sizeof(InstanceData) * instanceCapacity;
 
-    ubo.model = glm::mat4(1.0f);
-    rotation  = glm::radians(rotation);
-    
-    
-    
-    ubo.model = glm::translate(ubo.model, position);
-    
+    instanceBuffers.resize(amount);
 
-    ubo.view = glm::lookAt(glm::vec3(0.0f, 1.5f, 0.0f), //   
-                           glm::vec3(0.0f, 0.0f, 0.0f), //   
-                           glm::vec3(0.0f, 0.0f, 1.0f));//   
+    for(size_t i = 0; i < amount; i++)
+    {
+        instanceBuffers[i].device = &device;
+        setupAsInstanceBuffer(bufferSize, instanceBuffers[i]);
+        instanceBuffers[i].map();
+    }
+}
 
+void createStorageBuffers(const LogicalDevice         &device,
+                          std::vector<Buffer>         &storageBuffers,
+                          VkDeviceSize                 bufferSize,
+                          uint32_t                     amount)
+{
+    storageBuffers.resize(amount);
 
-    ubo.proj = glm::perspective(glm::radians(90.0f), //   
-                                //  
-                                swapChainExtent.width / (float) swapChainExtent.height,
-                                0.1f,   //   
-                                100.0f); //   
-    // GLM     OpenGL,   Y 
-    //     -  Y 
-    //  
+    for(size_t i = 0; i < amount; i++)
+    {
+        storageBuffers[i].device = &device;
+        setupAsStorageBuffer(bufferSize, storageBuffers[i]);
+        storageBuffers[i].map();
+    }
+}
 
-    ubo.model = glm::rotate(ubo.model, rotation.x, glm::vec3(1.0f, 0.0f, 0.0f)); 
-    ubo.model = glm::rotate(ubo.model, rotation.y, glm::vec3(0.0f, 1.0f, 0.0f)); 
-    ubo.model = glm::rotate(ubo.model, rotation.z, glm::vec3(0.0f, 0.0f, 1.0f)); 
-    
-    ubo.model = glm::scale(ubo.model, scale);
+void createCounterBuffers(const LogicalDevice         &device,
+                          std::vector<Buffer>         &counterBuffers,
+                          uint32_t                     counterCount,
+                          uint32_t                     amount)
+{
+    VkDeviceSize bufferSize = sizeof(uint32_t) * counterCount;
 
+    counterBuffers.resize(amount);
 
-    ubo.proj[1][1] *= -1;
+    for(size_t i = 0; i < amount; i++)
+    {
+        counterBuffers[i].device = &device;
+        setupAsCounterBuffer(bufferSize, counterBuffers[i]);
+    }
+}
+
+void createIndirectBuffers(const LogicalDevice         &device,
+                           std::vector<Buffer>         &indirectBuffers,
+                           uint32_t                     commandCapacity,
+                           uint32_t                     amount)
+{
+    VkDeviceSize bufferSize = sizeof(VkDrawIndexedIndirectCommand) * commandCapacity;
+
+    indirectBuffers.resize(amount);
+
+    for(size_t i = 0; i < amount; i++)
+    {
+        indirectBuffers[i].device = &device;
+        setupAsIndirectBuffer(bufferSize, indirectBuffers[i]);
+        indirectBuffers[i].map();
+    }
+}
 
+void updateUniformBuffer(VkDevice                    logicalDevice,
+                         uint32_t                    currentImage,
+                         const UniformBufferObject   &ubo,
+                         std::vector<Buffer>         &uniformBuffers)
+{
     uniformBuffers[currentImage].mapMemory(sizeof(ubo), &ubo);
 }
 
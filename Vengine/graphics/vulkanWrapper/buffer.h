@@ -13,15 +13,79 @@
 #include "commandPool.h"
 #include "vertex.h"
 
+struct UploadBatch;
 
 struct UniformBufferObject
 {
-    glm::mat4  model;
     glm::mat4  view;
     glm::mat4  proj;
     alignas(16)
     bool noTexture;
     //glm::uint8 
+    //        
+    alignas(16)
+    glm::vec4  frustumPlanes[6];
+    // xyz -  , w - Camera::getPixelsPerUnit      
+    // w = 0   
+    glm::vec4  lodParameters;
+};
+
+
+//      .    Object  cull.comp
+struct CullingObject
+{
+    glm::mat4  model;
+    glm::vec4  tint;
+    glm::vec4  uvRect;   //      , . InstanceData
+    glm::vec4  sphere;   //        
+    uint32_t   group;    //     ,      
+    float      scale;    //   ,      
+    uint32_t   padding[2];
+};
+
+
+//       .    Group   
+struct CullingGroup
+{
+    uint32_t indexCount;
+    uint32_t firstIndex;
+    int32_t  vertexOffset;
+    uint32_t firstInstance;  //      
+    uint32_t textureRun;     //      
+    uint32_t runFirstDraw;   //     
+    float    lodError;       //        
+    uint32_t lodCount;       //     
+    uint32_t clusterCount;   //    ,      
+};
+
+
+//    .    Cluster   
+//          
+struct CullingCluster
+{
+    glm::vec4  sphere;   //      
+    glm::vec4  cone;     //        
+    uint32_t   object;   //     
+    uint32_t   group;    //    
+    uint32_t   padding[2];
+};
+
+
+//       
+struct DrawPushConstants
+{
+    uint32_t textureIndex;
+};
+
+
+struct CullingPushConstants
+{
+    uint32_t objectCount;
+    uint32_t groupCount;
+    // 1 -       vkCmdDrawIndexedIndirectCountKHR
+    // 0 -       ,    instanceCount = 0
+    uint32_t compactDraws;
+    uint32_t clusterCount;
 };
 
 
@@ -36,6 +100,11 @@ struct Buffer
 
     ~Buffer();
 
+    //     ,     
+    //   :     
+    Buffer(Buffer &&other) noexcept;
+    Buffer &operator=(Buffer &&other) noexcept;
+
     void create(VkDeviceSize          size, 
                 VkBufferUsageFlags    usage, 
                 VkMemoryPropertyFlags properties);
@@ -43,12 +112,18 @@ struct Buffer
     void setDevice(const LogicalDevice *device);
 
     void mapMemory(VkDeviceSize dataSize, const void *data);
+
+    //    .   
+    //   unmap  destroy,    vkMapMemory   
+    void *map();
+    void  unmap();
     
     void destroy();
 
 protected:
     bool            alive;    
     VkDeviceMemory  memory;
+    void           *mapped;
 
     void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage);
 
@@ -56,16 +131,23 @@ protected:
                         VkMemoryPropertyFlags       properties);
 };
 
+//     typeFilter,      properties
+uint32_t findMemoryType(VkPhysicalDevice       physicalDevice,
+                        uint32_t               typeFilter,
+                        VkMemoryPropertyFlags  properties);
+
+
 void createStagingBuffer(VkDeviceSize  bufferSize,
                          Buffer        &buffer);
 
 
-void createVertexBuffer(CommandPool               &commandPool,
+//       upload.     upload.submit
+void createVertexBuffer(UploadBatch               &upload,
                         const std::vector<Vertex> &vertices,
                         Buffer                    &vertexBuffer);
 
 
-void createIndexBuffer(CommandPool                 &commandPool,
+void createIndexBuffer(UploadBatch                 &upload,
                        const std::vector<uint32_t> &indices,
                        Buffer                      &indexBuffer);
 
@@ -75,11 +157,39 @@ void createUniformBuffers(const LogicalDevice         &device,
                           uint32_t                     amount);
 
 
+//  amount    instanceCapacity  InstanceData .
+//        
+void createInstanceBuffers(const LogicalDevice         &device,
+                           std::vector<Buffer>         &instanceBuffers,
+                           uint32_t                     instanceCapacity,
+                           uint32_t                     amount);
+
+
+//  amount  ,       
+void createStorageBuffers(const LogicalDevice         &device,
+                          std::vector<Buffer>         &storageBuffers,
+                          VkDeviceSize                 bufferSize,
+                          uint32_t                     amount);
+
+
+//  amount     .   
+//  vkCmdFillBuffer        
+void createCounterBuffers(const LogicalDevice         &device,
+                          std::vector<Buffer>         &counterBuffers,
+                          uint32_t                     counterCount,
+                          uint32_t                     amount);
+
+
+//  amount   commandCapacity  VkDrawIndexedIndirectCommand 
+//        
+void createIndirectBuffers(const LogicalDevice         &device,
+                           std::vector<Buffer>         &indirectBuffers,
+                           uint32_t                     commandCapacity,
+                           uint32_t                     amount);
+
+
 void updateUniformBuffer(VkDevice                    logicalDevice,
                          uint32_t                    currentImage,
-                         VkExtent2D                  swapChainExtent,
-                         glm::vec3                   position,
-                         glm::vec3                   rotation,
-                         glm::vec3                   scale,
+                         const UniformBufferObject   &ubo,
                          std::vector<Buffer>         &uniformBuffers);
 
@@ -1,7 +1,6 @@
 #include "commandBuffer.h"
 
 #include <stdexcept>
-#include <array>
 
 ///////////////////////// STATIC BEG //////////////////////////////
 
@@ -30,36 +29,118 @@ static void beginCommandBuffer(VkCommandBuffer            commandBuffer,
 }
 
 
-static void beginRenderPass(VkRenderPass        renderPass,
-                            VkCommandBuffer     commandBuffer,
-                            VkFramebuffer       frameBuffer,
-                            const VkExtent2D    &extent)
+static uint32_t divideRoundingUp(uint32_t value, uint32_t divider)
 {
-    VkRenderPassBeginInfo renderPassInfo{};
-    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassInfo.renderPass  = renderPass;
-    renderPassInfo.framebuffer = frameBuffer;
-
-    //    
-    //        
-    //     attahments
-    renderPassInfo.renderArea.offset = {0, 0};
-    renderPassInfo.renderArea.extent = extent;
-
-    //      
-    //      clearValues   
-    std::array<VkClearValue, 2> clearValues{};
-    clearValues[0].color        = {0.0f, 0.0f, 0.0f, 1.0f};
-    clearValues[1].depthStencil = {1.0f, 0};
-
-    renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-    renderPassInfo.pClearValues    = clearValues.data();
-
-    //         
-    // VK_SUBPASS_CONTENTS_INLINE -      
-    //       
-    // VK_SUBPASS_CONTENTS_INLINE -      
-    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    return (value + divider - 1) / divider;
+}
+
+//      cull.comp, clusters.comp  compact.comp
+static const uint32_t workGroupSize = 64;
+
+static void bindCullingState(VkCommandBuffer         commandBuffer,
+                             uint32_t                imageIndex,
+                             const CullingDispatch  &culling)
+{
+    CullingPushConstants pushConstants{};
+    pushConstants.objectCount  = culling.objectCount;
+    pushConstants.groupCount   = culling.groupCount;
+    pushConstants.compactDraws = culling.drawIndexedIndirectCount ? 1 : 0;
+    pushConstants.clusterCount = culling.clusterCount;
+
+    vkCmdBindDescriptorSets(commandBuffer,
+                            VK_PIPELINE_BIND_POINT_COMPUTE,
+                            culling.pipelineLayout,
+                            0,
+                            1,
+                            &(*culling.descriptorSets)[imageIndex],
+                            0,
+                            nullptr);
+
+    vkCmdPushConstants(commandBuffer,
+                       culling.pipelineLayout,
+                       VK_SHADER_STAGE_COMPUTE_BIT,
+                       0,
+                       sizeof(pushConstants),
+                       &pushConstants);
+}
+
+//      .  ,
+//       ,    
+struct BoundDrawState
+{
+    VkPipeline         pipeline             = VK_NULL_HANDLE;
+    VkDescriptorSet    descriptorSets[2]    = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    VkBuffer           vertexBuffers[2]     = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    VkBuffer           indexBuffer          = VK_NULL_HANDLE;
+    uint32_t           textureIndex         = UINT32_MAX;
+
+    DrawStateChanges   changes{};
+};
+
+static void bindDrawState(VkCommandBuffer      commandBuffer,
+                          uint32_t             imageIndex,
+                          const DrawDispatch  &draw,
+                          uint32_t             textureIndex,
+                          BoundDrawState      &bound)
+{
+    //      pipeline   
+    if(bound.pipeline != draw.graphicsPipeline)
+    {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw.graphicsPipeline);
+        bound.pipeline = draw.graphicsPipeline;
+        bound.changes.pipelineBinds++;
+    }
+
+    //          ,
+    //         
+    VkBuffer vertexBuffers[] = {draw.vertexBuffer, (*draw.instanceBuffers)[imageIndex].handle};
+    if(bound.vertexBuffers[0] != vertexBuffers[0] || bound.vertexBuffers[1] != vertexBuffers[1])
+    {
+        VkDeviceSize offsets[] = {0, 0};
+        vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertexBuffers, offsets);
+        bound.vertexBuffers[0] = vertexBuffers[0];
+        bound.vertexBuffers[1] = vertexBuffers[1];
+        bound.changes.vertexBufferBinds++;
+    }
+
+    if(bound.indexBuffer != draw.indexBuffer)
+    {
+        vkCmdBindIndexBuffer(commandBuffer, draw.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        bound.indexBuffer = draw.indexBuffer;
+        bound.changes.indexBufferBinds++;
+    }
+
+    //      ,    ,   
+    VkDescriptorSet descriptorSets[] = {(*draw.descriptorSets)[imageIndex], (*draw.textureDescriptorSets)[imageIndex]};
+    if(bound.descriptorSets[0] != descriptorSets[0] || bound.descriptorSets[1] != descriptorSets[1])
+    {
+        vkCmdBindDescriptorSets(commandBuffer,
+                                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                draw.pipelineLayout,
+                                0,
+                                2,
+                                descriptorSets,
+                                0,
+                                nullptr);
+        bound.descriptorSets[0] = descriptorSets[0];
+        bound.descriptorSets[1] = descriptorSets[1];
+        bound.changes.descriptorSetBinds++;
+    }
+
+    if(bound.textureIndex != textureIndex)
+    {
+        DrawPushConstants pushConstants{};
+        pushConstants.textureIndex = textureIndex;
+
+        vkCmdPushConstants(commandBuffer,
+                           draw.pipelineLayout,
+                           VK_SHADER_STAGE_FRAGMENT_BIT,
+                           0,
+                           sizeof(pushConstants),
+                           &pushConstants);
+        bound.textureIndex = textureIndex;
+        bound.changes.textureChanges++;
+    }
 }
 
 ///////////////////////// STATIC END ///////////////////////////
@@ -67,54 +148,127 @@ static void beginRenderPass(VkRenderPass        renderPass,
 
 ///////////////////////// PUBLIC BEG ////////////////////////////////
 
-void writeCommandBuffersForDrawing(CommandPool                  &commandPool,
-                                   Swapchain                    &swapChain,
-                                   VkRenderPass                 renderPass,
-                                   VkPipeline                   graphicsPipeline,
-                                   VkPipelineLayout             pipelineLayout,
-                                   VkBuffer                     vertexBuffer,
-                                   VkBuffer                     indexBuffer,
-                                   uint32_t                     indexCount,
-                                   std::vector<VkDescriptorSet> &descriptorSets,
-                                   std::vector<VkCommandBuffer> &commandBuffers)
+void writeCounterResetCommands(VkCommandBuffer         commandBuffer,
+                               uint32_t                imageIndex,
+                               const CullingDispatch  &culling)
 {
-    commandBuffers.resize(swapChain.frameBuffers.size());
-    commandPool.freeCommandBuffers(commandBuffers.size(), commandBuffers.data());
-    commandPool.allocateCommandBuffers(commandBuffers.size(),
-                                       commandBuffers.data());
+    vkCmdFillBuffer(commandBuffer, (*culling.counterBuffers)[imageIndex].handle, 0, VK_WHOLE_SIZE, 0);
+}
+
+
+void writeCullCommands(VkCommandBuffer         commandBuffer,
+                       uint32_t                imageIndex,
+                       const CullingDispatch  &culling)
+{
+    bindCullingState(commandBuffer, imageIndex, culling);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, culling.cullPipeline);
+    vkCmdDispatch(commandBuffer, divideRoundingUp(culling.objectCount, workGroupSize), 1, 1);
 
-    for(size_t i = 0; i < commandBuffers.size(); i++)
+    //     ,     , 
+    //      
+    if(culling.clusterCount > 0)
     {
-        beginCommandBuffer(commandBuffers[i]);
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, culling.clusterPipeline);
+        vkCmdDispatch(commandBuffer, divideRoundingUp(culling.clusterCount, workGroupSize), 1, 1);
+    }
+}
 
-        beginRenderPass(renderPass, 
-                        commandBuffers[i], 
-                        swapChain.frameBuffers[i], 
-                        swapChain.extent);
 
-        //      pipeline   
-        vkCmdBindPipeline(commandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
+void writeCompactCommands(VkCommandBuffer         commandBuffer,
+                          uint32_t                imageIndex,
+                          const CullingDispatch  &culling)
+{
+    bindCullingState(commandBuffer, imageIndex, culling);
 
-        VkBuffer vertexBuffers[] = {vertexBuffer};
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers(commandBuffers[i], 0, 1, vertexBuffers, offsets);
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, culling.compactPipeline);
+    vkCmdDispatch(commandBuffer, divideRoundingUp(culling.groupCount, workGroupSize), 1, 1);
+}
 
-        vkCmdBindIndexBuffer(commandBuffers[i], indexBuffer, 0, VK_INDEX_TYPE_UINT32);
 
-        vkCmdBindDescriptorSets(commandBuffers[i],
-                                VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                pipelineLayout,
-                                0,
-                                1,
-                                &descriptorSets[i],
-                                0,
-                                nullptr);
+void writeDrawCommands(VkCommandBuffer      commandBuffer,
+                       uint32_t             imageIndex,
+                       const DrawDispatch  &draw)
+{
+    const std::vector<IndexedDraw> &draws   = *draw.draws;
+    const CullingDispatch          *culling = draw.culling;
+
+    VkBuffer indirectBuffer = (*draw.indirectBuffers)[imageIndex].handle;
+
+    //     DrawKey,   
+    //         
+    BoundDrawState bound;
+
+    for(size_t drawIndex = 0; drawIndex < draws.size(); drawIndex++)
+    {
+        const IndexedDraw &indexedDraw = draws[drawIndex];
+
+        bool drawWholeRun = culling && culling->drawIndexedIndirectCount;
+
+        bindDrawState(commandBuffer, imageIndex, draw, indexedDraw.textureIndex, bound);
+        bound.changes.drawCalls++;
+
+        //            ,
+        //       .     
+        if(drawWholeRun)
+        {
+            size_t runEnd = drawIndex;
+            while(runEnd < draws.size() && draws[runEnd].textureRun == indexedDraw.textureRun)
+                runEnd++;
+
+            culling->drawIndexedIndirectCount(commandBuffer,
+                                              indirectBuffer,
+                                              drawIndex * sizeof(VkDrawIndexedIndirectCommand),
+                                              (*culling->counterBuffers)[imageIndex].handle,
+                                              (draws.size() + indexedDraw.textureRun) * sizeof(uint32_t),
+                                              static_cast<uint32_t>(runEnd - drawIndex),
+                                              sizeof(VkDrawIndexedIndirectCommand));
+
+            drawIndex = runEnd - 1;
+            continue;
+        }
+
+        //       
+        //     ,      
+        vkCmdDrawIndexedIndirect(commandBuffer,
+                                 indirectBuffer,
+                                 drawIndex * sizeof(VkDrawIndexedIndirectCommand),
+                                 1,
+                                 sizeof(VkDrawIndexedIndirectCommand));
+    }
+
+    if(draw.stateChanges)
+        *draw.stateChanges = bound.changes;
+}
+
+
+void writeCommandBuffersForDrawing(CommandPool                    &commandPool,
+                                   const RenderGraph              &graph,
+                                   uint32_t                       imageCount,
+                                   std::vector<VkCommandBuffer>   &commandBuffers,
+                                   GpuProfiler                    *profiler)
+{
+    commandBuffers.resize(imageCount);
+    commandPool.freeCommandBuffers(commandBuffers.size(), commandBuffers.data());
+    commandPool.allocateCommandBuffers(commandBuffers.size(),
+                                       commandBuffers.data());
+
+    for(uint32_t i = 0; i < imageCount; i++)
+    {
+        beginCommandBuffer(commandBuffers[i]);
 
-        vkCmdDrawIndexed(commandBuffers[i],
-                         indexCount,
-                         1, 0, 0, 0);
+        //        
+        if(profiler)
+        {
+            profiler->beginRecording(commandBuffers[i], i);
+            profiler->beginScope(commandBuffers[i], i, "frame");
+        }
 
-        vkCmdEndRenderPass(commandBuffers[i]);
+        //       
+        graph.execute(commandBuffers[i], i, profiler);
+
+        if(profiler)
+            profiler->endScope(commandBuffers[i], i);
 
         if(vkEndCommandBuffer(commandBuffers[i]) != VK_SUCCESS)
             throw std::runtime_error("failed to record command buffer!");
@@ -129,6 +283,9 @@ VkCommandBuffer beginSingleTimeCommands(CommandPool &commandPool)
 
     beginCommandBuffer(commandBuffer, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 
+    if(commandPool.profiler)
+        commandPool.profiler->beginUpload(commandBuffer);
+
     return commandBuffer;
 }
 
@@ -136,6 +293,9 @@ VkCommandBuffer beginSingleTimeCommands(CommandPool &commandPool)
 void endSingleTimeCommands(const CommandPool   &commandPool,
                            VkCommandBuffer     commandBuffer)
 {
+    if(commandPool.profiler)
+        commandPool.profiler->endUpload(commandBuffer);
+
     vkEndCommandBuffer(commandBuffer);
 
     VkSubmitInfo submitInfo{};
@@ -146,6 +306,10 @@ void endSingleTimeCommands(const CommandPool   &commandPool,
     vkQueueSubmit(commandPool.device->graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
     vkQueueWaitIdle(commandPool.device->graphicsQueue);
 
+    //  ,    
+    if(commandPool.profiler)
+        commandPool.profiler->collectUpload();
+
     vkFreeCommandBuffers(commandPool.device->handle, commandPool.handle, 1, &commandBuffer);
 }
 
@@ -4,17 +4,118 @@
 
 #include "commandPool.h"
 #include "swapChain.h"
+#include "buffer.h"
+#include "renderGraph.h"
 
-void writeCommandBuffersForDrawing(CommandPool                  &commandPool,
-                                   Swapchain                    &swapChain,
-                                   VkRenderPass                 renderPass,
-                                   VkPipeline                   graphicsPipeline,
-                                   VkPipelineLayout             pipelineLayout,
-                                   VkBuffer                     vertexBuffer,
-                                   VkBuffer                     indexBuffer,
-                                   uint32_t                     indicesCount,
-                                   std::vector<VkDescriptorSet> &descriptorSets,
-                                   std::vector<VkCommandBuffer> &commandBuffers);
+#include <vector>
+
+/*
+*        
+*       vkCmdDrawIndexedIndirect,   
+*         ,      draws.
+* instanceCount  firstInstance      ,
+*         
+*/
+struct IndexedDraw
+{
+    uint32_t        indexCount;
+    uint32_t        instanceCount;
+    uint32_t        firstIndex;
+    int32_t         vertexOffset;
+    uint32_t        firstInstance;
+    //  -         
+    uint32_t        textureRun;
+    //     ,    push constant
+    uint32_t        textureIndex;
+};
+
+/*
+*     
+*        :
+*  , cullPipeline     ,
+* clusterPipeline        ,
+*  compactPipeline    .     
+*/
+struct CullingDispatch
+{
+    VkPipeline                           cullPipeline;
+    VkPipeline                           compactPipeline;
+    VkPipeline                           clusterPipeline;
+    VkPipelineLayout                     pipelineLayout;
+    const std::vector<VkDescriptorSet>  *descriptorSets;
+    const std::vector<Buffer>           *counterBuffers;
+    uint32_t                             objectCount;
+    //   
+    uint32_t                             groupCount;
+    //   -,   clusterPipeline
+    uint32_t                             clusterCount;
+    //     VK_KHR_draw_indirect_count,  nullptr
+    //      ,    instanceCount = 0
+    PFN_vkCmdDrawIndexedIndirectCountKHR drawIndexedIndirectCount;
+};
+
+//    ,        
+// ,    ,     
+//   ,   :        ,
+//  ,        ,   
+struct DrawStateChanges
+{
+    uint32_t pipelineBinds;
+    uint32_t descriptorSetBinds;
+    uint32_t vertexBufferBinds;
+    uint32_t indexBufferBinds;
+    // push constant   
+    uint32_t textureChanges;
+    uint32_t drawCalls;
+};
+
+/*
+* ,       
+*         ,    
+*     ,   ,       
+*/
+struct DrawDispatch
+{
+    VkPipeline                           graphicsPipeline;
+    VkPipelineLayout                     pipelineLayout;
+    VkBuffer                             vertexBuffer;
+    VkBuffer                             indexBuffer;
+    const std::vector<Buffer>           *instanceBuffers;
+    const std::vector<Buffer>           *indirectBuffers;
+    const std::vector<IndexedDraw>      *draws;
+    const std::vector<VkDescriptorSet>  *descriptorSets;
+    const std::vector<VkDescriptorSet>  *textureDescriptorSets;
+    // nullptr,     
+    const CullingDispatch               *culling;
+    //  ,        
+    DrawStateChanges                    *stateChanges;
+};
+
+//    . imageIndex -   
+void writeCounterResetCommands(VkCommandBuffer         commandBuffer,
+                               uint32_t                imageIndex,
+                               const CullingDispatch  &culling);
+
+// cullPipeline  clusterPipeline    ,    
+void writeCullCommands(VkCommandBuffer         commandBuffer,
+                       uint32_t                imageIndex,
+                       const CullingDispatch  &culling);
+
+void writeCompactCommands(VkCommandBuffer         commandBuffer,
+                          uint32_t                imageIndex,
+                          const CullingDispatch  &culling);
+
+//    ,   
+void writeDrawCommands(VkCommandBuffer      commandBuffer,
+                       uint32_t             imageIndex,
+                       const DrawDispatch  &draw);
+
+//         .  -    
+void writeCommandBuffersForDrawing(CommandPool                    &commandPool,
+                                   const RenderGraph              &graph,
+                                   uint32_t                       imageCount,
+                                   std::vector<VkCommandBuffer>   &commandBuffers,
+                                   GpuProfiler                    *profiler = nullptr);
                                    
 
 VkCommandBuffer beginSingleTimeCommands(CommandPool  &commandPool);
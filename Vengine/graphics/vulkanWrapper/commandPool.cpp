@@ -6,13 +6,15 @@
 
 CommandPool::CommandPool()
 {
-    handle = VK_NULL_HANDLE;
-    device = VK_NULL_HANDLE;
+    handle   = VK_NULL_HANDLE;
+    device   = VK_NULL_HANDLE;
+    profiler = nullptr;
 }
 
 CommandPool::CommandPool(const LogicalDevice *device)
 {
-    handle = VK_NULL_HANDLE;
+    handle   = VK_NULL_HANDLE;
+    profiler = nullptr;
     setDevice(device);
 }
 
@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.h>
 
 #include "device.h"
+#include "gpuProfiler.h"
 
 struct CommandPool
 {   
@@ -10,6 +11,9 @@ struct CommandPool
     
     const LogicalDevice  *device;
 
+    //  ,          upload
+    GpuProfiler          *profiler;
+
     CommandPool();
     CommandPool(const LogicalDevice *device);
 
@@ -0,0 +1,294 @@
+#include "descriptorAllocator.h"
+
+#include <stdexcept>
+#include <functional>
+
+#include "descriptorPool.h"
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+//     32    uint64_t,   64  - 
+template<typename Handle>
+static uint64_t getHandleValue(Handle handle)
+{
+    return (uint64_t)handle;
+}
+
+static void combineHash(size_t &seed, uint64_t value)
+{
+    seed ^= std::hash<uint64_t>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+static size_t hashDescriptorSet(VkDescriptorSetLayout                 layout,
+                                const std::vector<DescriptorBinding> &bindings)
+{
+    size_t seed = 0;
+    combineHash(seed, getHandleValue(layout));
+
+    for(const DescriptorBinding &binding : bindings)
+    {
+        combineHash(seed, binding.binding);
+        combineHash(seed, binding.type);
+        combineHash(seed, getHandleValue(binding.buffer));
+        combineHash(seed, binding.offset);
+        combineHash(seed, binding.range);
+        combineHash(seed, getHandleValue(binding.imageView));
+        combineHash(seed, getHandleValue(binding.sampler));
+        combineHash(seed, binding.imageLayout);
+    }
+
+    return seed;
+}
+
+static bool isSameBinding(const DescriptorBinding &first,
+                          const DescriptorBinding &second)
+{
+    return first.binding     == second.binding   &&
+           first.type        == second.type      &&
+           first.buffer      == second.buffer    &&
+           first.offset      == second.offset    &&
+           first.range       == second.range     &&
+           first.imageView   == second.imageView &&
+           first.sampler     == second.sampler   &&
+           first.imageLayout == second.imageLayout;
+}
+
+static bool isSameBindings(const std::vector<DescriptorBinding> &first,
+                           const std::vector<DescriptorBinding> &second)
+{
+    if(first.size() != second.size())
+        return false;
+
+    for(size_t i = 0; i < first.size(); i++)
+        if(!isSameBinding(first[i], second[i]))
+            return false;
+
+    return true;
+}
+
+static void writeDescriptorSet(VkDevice                              logicalDevice,
+                               VkDescriptorSet                       descriptorSet,
+                               const std::vector<DescriptorBinding> &bindings)
+{
+    // pBufferInfo  pImageInfo    ,     
+    std::vector<VkDescriptorBufferInfo> bufferInfos(bindings.size());
+    std::vector<VkDescriptorImageInfo>  imageInfos(bindings.size());
+    std::vector<VkWriteDescriptorSet>   descriptorWrites(bindings.size());
+
+    for(size_t i = 0; i < bindings.size(); i++)
+    {
+        const DescriptorBinding &binding = bindings[i];
+
+        descriptorWrites[i].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[i].dstSet          = descriptorSet;
+        descriptorWrites[i].dstBinding      = binding.binding;
+        descriptorWrites[i].dstArrayElement = 0;
+        descriptorWrites[i].descriptorType  = binding.type;
+        descriptorWrites[i].descriptorCount = 1;
+
+        if(binding.buffer)
+        {
+            bufferInfos[i].buffer = binding.buffer;
+            bufferInfos[i].offset = binding.offset;
+            bufferInfos[i].range  = binding.range;
+
+            descriptorWrites[i].pBufferInfo = &bufferInfos[i];
+        }
+        else
+        {
+            imageInfos[i].imageView   = binding.imageView;
+            imageInfos[i].sampler     = binding.sampler;
+            imageInfos[i].imageLayout = binding.imageLayout;
+
+            descriptorWrites[i].pImageInfo = &imageInfos[i];
+        }
+    }
+
+    vkUpdateDescriptorSets(logicalDevice,
+                           static_cast<uint32_t>(descriptorWrites.size()),
+                           descriptorWrites.data(),
+                           0,
+                           nullptr);
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// DESCRIPTOR ALLOCATOR BEG //////////////////////////////
+
+DescriptorAllocator::DescriptorAllocator()
+{
+    device           = nullptr;
+    nextPoolSetCount = 0;
+    currentPool      = VK_NULL_HANDLE;
+}
+
+void DescriptorAllocator::create(const LogicalDevice                     *device,
+                                 const std::vector<VkDescriptorPoolSize> &setSizes,
+                                 uint32_t                                 firstPoolSetCount)
+{
+    this->device     = device;
+    this->setSizes   = setSizes;
+    nextPoolSetCount = firstPoolSetCount;
+}
+
+VkDescriptorPool DescriptorAllocator::takePool()
+{
+    if(!freePools.empty())
+    {
+        VkDescriptorPool pool = freePools.back();
+        freePools.pop_back();
+
+        return pool;
+    }
+
+    std::vector<VkDescriptorPoolSize> poolSizes = setSizes;
+    for(VkDescriptorPoolSize &poolSize : poolSizes)
+        poolSize.descriptorCount *= nextPoolSetCount;
+
+    VkDescriptorPool pool = createDescriptorPool(*device, poolSizes, nextPoolSetCount);
+
+    //   ,       
+    nextPoolSetCount *= 2;
+
+    return pool;
+}
+
+VkDescriptorSet DescriptorAllocator::allocate(VkDescriptorSetLayout layout)
+{
+    if(!currentPool)
+    {
+        currentPool = takePool();
+        usedPools.push_back(currentPool);
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool     = currentPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts        = &layout;
+
+    VkDescriptorSet descriptorSet;
+    VkResult        result = vkAllocateDescriptorSets(device->handle, &allocInfo, &descriptorSet);
+
+    //     .      
+    if(result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
+    {
+        currentPool = takePool();
+        usedPools.push_back(currentPool);
+
+        allocInfo.descriptorPool = currentPool;
+        result = vkAllocateDescriptorSets(device->handle, &allocInfo, &descriptorSet);
+    }
+
+    if(result != VK_SUCCESS)
+        throw std::runtime_error("failed to allocate descriptor set!");
+
+    return descriptorSet;
+}
+
+void DescriptorAllocator::reset()
+{
+    for(VkDescriptorPool pool : usedPools)
+    {
+        vkResetDescriptorPool(device->handle, pool, 0);
+        freePools.push_back(pool);
+    }
+
+    usedPools.clear();
+    currentPool = VK_NULL_HANDLE;
+}
+
+void DescriptorAllocator::destroy()
+{
+    reset();
+
+    for(VkDescriptorPool pool : freePools)
+        vkDestroyDescriptorPool(device->handle, pool, nullptr);
+
+    freePools.clear();
+}
+
+///////////////////////// DESCRIPTOR ALLOCATOR END //////////////////////////////
+
+
+///////////////////////// DESCRIPTOR BINDING BEG //////////////////////////////
+
+DescriptorBinding bufferBinding(uint32_t          binding,
+                                VkDescriptorType  type,
+                                VkBuffer          buffer,
+                                VkDeviceSize      range,
+                                VkDeviceSize      offset)
+{
+    DescriptorBinding descriptorBinding{};
+    descriptorBinding.binding = binding;
+    descriptorBinding.type    = type;
+    descriptorBinding.buffer  = buffer;
+    descriptorBinding.offset  = offset;
+    descriptorBinding.range   = range;
+
+    return descriptorBinding;
+}
+
+DescriptorBinding imageBinding(uint32_t          binding,
+                               VkDescriptorType  type,
+                               VkImageView       imageView,
+                               VkSampler         sampler,
+                               VkImageLayout     imageLayout)
+{
+    DescriptorBinding descriptorBinding{};
+    descriptorBinding.binding     = binding;
+    descriptorBinding.type        = type;
+    descriptorBinding.imageView   = imageView;
+    descriptorBinding.sampler     = sampler;
+    descriptorBinding.imageLayout = imageLayout;
+
+    return descriptorBinding;
+}
+
+///////////////////////// DESCRIPTOR BINDING END //////////////////////////////
+
+
+///////////////////////// DESCRIPTOR CACHE BEG //////////////////////////////
+
+void DescriptorCache::create(const LogicalDevice                     *device,
+                             const std::vector<VkDescriptorPoolSize> &setSizes,
+                             uint32_t                                 firstPoolSetCount)
+{
+    allocator.create(device, setSizes, firstPoolSetCount);
+}
+
+VkDescriptorSet DescriptorCache::get(VkDescriptorSetLayout                 layout,
+                                     const std::vector<DescriptorBinding> &bindings)
+{
+    std::vector<CachedSet> &candidates = sets[hashDescriptorSet(layout, bindings)];
+
+    for(const CachedSet &candidate : candidates)
+        if(candidate.layout == layout && isSameBindings(candidate.bindings, bindings))
+            return candidate.set;
+
+    CachedSet cachedSet{};
+    cachedSet.layout   = layout;
+    cachedSet.bindings = bindings;
+    cachedSet.set      = allocator.allocate(layout);
+
+    writeDescriptorSet(allocator.device->handle, cachedSet.set, bindings);
+
+    candidates.push_back(cachedSet);
+
+    return cachedSet.set;
+}
+
+void DescriptorCache::reset()
+{
+    allocator.reset();
+    sets.clear();
+}
+
+void DescriptorCache::destroy()
+{
+    allocator.destroy();
+    sets.clear();
+}
+
+///////////////////////// DESCRIPTOR CACHE END //////////////////////////////
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+#include <unordered_map>
+
+#include "device.h"
+
+/*
+*      
+*      ,  ,   
+* reset()   ,        
+*/
+struct DescriptorAllocator
+{
+    const LogicalDevice  *device;
+
+    DescriptorAllocator();
+
+    // setSizes -        
+    //     firstPoolSetCount 
+    void create(const LogicalDevice                     *device,
+                const std::vector<VkDescriptorPoolSize> &setSizes,
+                uint32_t                                 firstPoolSetCount);
+
+    VkDescriptorSet allocate(VkDescriptorSetLayout layout);
+
+    //     
+    void reset();
+
+    void destroy();
+
+private:
+    std::vector<VkDescriptorPoolSize> setSizes;
+    uint32_t                          nextPoolSetCount;
+
+    VkDescriptorPool                  currentPool;
+    std::vector<VkDescriptorPool>     usedPools;
+    std::vector<VkDescriptorPool>     freePools;
+
+    VkDescriptorPool takePool();
+};
+
+
+/*
+*    :     
+*/
+struct DescriptorBinding
+{
+    uint32_t          binding;
+    VkDescriptorType  type;
+
+    VkBuffer          buffer;
+    VkDeviceSize      offset;
+    VkDeviceSize      range;
+
+    VkImageView       imageView;
+    VkSampler         sampler;
+    VkImageLayout     imageLayout;
+};
+
+DescriptorBinding bufferBinding(uint32_t          binding,
+                                VkDescriptorType  type,
+                                VkBuffer          buffer,
+                                VkDeviceSize      range  = VK_WHOLE_SIZE,
+                                VkDeviceSize      offset = 0);
+
+DescriptorBinding imageBinding(uint32_t          binding,
+                               VkDescriptorType  type,
+                               VkImageView       imageView,
+                               VkSampler         sampler,
+                               VkImageLayout     imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+
+/*
+*  ,     
+*             ,   
+*  vkAllocateDescriptorSets  vkUpdateDescriptorSets
+*        ,    
+*  ,    -,     
+*/
+struct DescriptorCache
+{
+    DescriptorAllocator allocator;
+
+    void create(const LogicalDevice                     *device,
+                const std::vector<VkDescriptorPoolSize> &setSizes,
+                uint32_t                                 firstPoolSetCount);
+
+    VkDescriptorSet get(VkDescriptorSetLayout                 layout,
+                        const std::vector<DescriptorBinding> &bindings);
+
+    void reset();
+
+    void destroy();
+
+private:
+    struct CachedSet
+    {
+        VkDescriptorSetLayout          layout;
+        std::vector<DescriptorBinding> bindings;
+        VkDescriptorSet                set;
+    };
+
+    //           
+    std::unordered_map<size_t, std::vector<CachedSet>> sets;
+};
\ No newline at end of file
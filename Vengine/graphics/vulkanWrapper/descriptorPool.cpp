@@ -5,24 +5,17 @@
 
 ///////////////////////// PUBLIC BEG //////////////////////////////
 
-VkDescriptorPool createDescriptorPool(const LogicalDevice  &device,
-                                      uint32_t              size)
+VkDescriptorPool createDescriptorPool(const LogicalDevice                     &device,
+                                      const std::vector<VkDescriptorPoolSize> &poolSizes,
+                                      uint32_t                                 maxSets,
+                                      VkDescriptorPoolCreateFlags              flags)
 {
-    std::array<VkDescriptorPoolSize, 2> poolSizes{};
-
-    poolSizes[0].type            = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[0].descriptorCount = size;
-
-    poolSizes[1].type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = size;
-
-
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
     poolInfo.pPoolSizes    = poolSizes.data();
-    poolInfo.maxSets       = size;
-    poolInfo.flags         = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    poolInfo.maxSets       = maxSets;
+    poolInfo.flags         = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | flags;
 
     VkDescriptorPool descriptorPool;
     if(vkCreateDescriptorPool(device.handle, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
@@ -31,4 +24,19 @@ VkDescriptorPool createDescriptorPool(const LogicalDevice  &device,
     return descriptorPool;
 }
 
+VkDescriptorPool createTextureDescriptorPool(const LogicalDevice  &device,
+                                             uint32_t              textureCount,
+                                             uint32_t              setCount)
+{
+    std::vector<VkDescriptorPoolSize> poolSizes(2);
+
+    poolSizes[0].type            = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    poolSizes[0].descriptorCount = textureCount * setCount;
+
+    poolSizes[1].type            = VK_DESCRIPTOR_TYPE_SAMPLER;
+    poolSizes[1].descriptorCount = setCount;
+
+    return createDescriptorPool(device, poolSizes, setCount, VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT);
+}
+
 ///////////////////////// PUBLIC END /////////////////////////////
\ No newline at end of file
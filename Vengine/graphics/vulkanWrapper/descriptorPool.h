@@ -1,8 +1,16 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include "device.h"
 
-VkDescriptorPool createDescriptorPool(const LogicalDevice  &device,
-                                      uint32_t             size);
\ No newline at end of file
+VkDescriptorPool createDescriptorPool(const LogicalDevice                     &device,
+                                      const std::vector<VkDescriptorPoolSize> &poolSizes,
+                                      uint32_t                                 maxSets,
+                                      VkDescriptorPoolCreateFlags              flags = 0);
+
+//   setCount   :   textureCount    
+VkDescriptorPool createTextureDescriptorPool(const LogicalDevice  &device,
+                                             uint32_t             textureCount,
+                                             uint32_t             setCount = 1);
\ No newline at end of file
@@ -22,19 +22,6 @@ static void allocateDescriptorSets(VkDevice                      logicalDevice,
 }
 
 
-static void setupDescriptorBufferInfo(VkBuffer                 buffer,
-                                      uint32_t                 offset,
-                                      uint32_t                 range,                  
-                                      VkDescriptorBufferInfo  &bufferInfo)
-{
-    bufferInfo.buffer = buffer;
-    bufferInfo.offset = offset;
-    //        , 
-    //     VK_WHOLE_SIZE  range
-    bufferInfo.range = range;
-}
-
-
 static void setupDescriptorImageInfo(VkImageLayout          layout,
                                      VkImageView            textureImageView,
                                      VkSampler              textureSampler,
@@ -46,59 +33,120 @@ static void setupDescriptorImageInfo(VkImageLayout          layout,
 }
 
 
-void createDescriptorSets(const LogicalDevice          &device,
-                          VkDescriptorPool             descriptorPool,
-                          VkDescriptorSetLayout        descriptorSetLayout,
-                          std::vector<VkDescriptorSet> &descriptorSets,
-                          std::vector<Buffer>          &uniformBuffers,
-                          VkImageView                  textureImageView,
-                          VkSampler                    textureSampler,
-                          uint32_t                     amount)
+void createFrameDescriptorSets(DescriptorCache              &descriptorCache,
+                               VkDescriptorSetLayout        descriptorSetLayout,
+                               std::vector<VkDescriptorSet> &descriptorSets,
+                               std::vector<Buffer>          &uniformBuffers,
+                               std::vector<Buffer>          &feedbackBuffers,
+                               uint32_t                     amount)
+{
+    descriptorSets.resize(amount);
+
+    for(size_t i = 0; i < amount; i++)
+        descriptorSets[i] = descriptorCache.get(descriptorSetLayout,
+                                                {bufferBinding(0,
+                                                               VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                                                               uniformBuffers[i].handle,
+                                                               sizeof(UniformBufferObject)),
+                                                 bufferBinding(1,
+                                                               VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                                               feedbackBuffers[i].handle)});
+}
+
+
+void createCullingDescriptorSets(DescriptorCache              &descriptorCache,
+                                 VkDescriptorSetLayout        descriptorSetLayout,
+                                 std::vector<VkDescriptorSet> &descriptorSets,
+                                 std::vector<Buffer>          &uniformBuffers,
+                                 std::vector<Buffer>          &objectBuffers,
+                                 std::vector<Buffer>          &groupBuffers,
+                                 std::vector<Buffer>          &counterBuffers,
+                                 std::vector<Buffer>          &instanceBuffers,
+                                 std::vector<Buffer>          &indirectBuffers,
+                                 std::vector<Buffer>          &clusterBuffers,
+                                 uint32_t                     amount)
+{
+    descriptorSets.resize(amount);
+
+    for(size_t i = 0; i < amount; i++)
+    {
+        //       culling.glsl
+        std::array<VkBuffer, 7> buffers = {
+            uniformBuffers[i].handle,
+            objectBuffers[i].handle,
+            groupBuffers[i].handle,
+            counterBuffers[i].handle,
+            instanceBuffers[i].handle,
+            indirectBuffers[i].handle,
+            clusterBuffers[i].handle
+        };
+
+        std::vector<DescriptorBinding> bindings;
+        for(uint32_t binding = 0; binding < buffers.size(); binding++)
+            bindings.push_back(bufferBinding(binding,
+                                             binding == 0 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
+                                                          : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                             buffers[binding]));
+
+        descriptorSets[i] = descriptorCache.get(descriptorSetLayout, bindings);
+    }
+}
+
+
+VkDescriptorSet createTextureDescriptorSet(const LogicalDevice   &device,
+                                           VkDescriptorPool      descriptorPool,
+                                           VkDescriptorSetLayout descriptorSetLayout,
+                                           VkSampler             textureSampler)
 {
+    std::vector<VkDescriptorSet> descriptorSets;
     allocateDescriptorSets(device.handle,
                            descriptorPool,
                            descriptorSetLayout,
                            descriptorSets,
-                           amount);
+                           1);
+
+    VkDescriptorImageInfo samplerInfo{};
+    setupDescriptorImageInfo(VK_IMAGE_LAYOUT_UNDEFINED,
+                             VK_NULL_HANDLE,
+                             textureSampler,
+                             samplerInfo);
+
+    VkWriteDescriptorSet descriptorWrite{};
+    descriptorWrite.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet          = descriptorSets[0];
+    descriptorWrite.dstBinding      = 1;
+    descriptorWrite.dstArrayElement = 0;
+    descriptorWrite.descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLER;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pImageInfo      = &samplerInfo;
+
+    vkUpdateDescriptorSets(device.handle, 1, &descriptorWrite, 0, nullptr);
+
+    return descriptorSets[0];
+}
 
-    for(size_t i = 0; i < amount; i++)
-    {
-        VkDescriptorBufferInfo bufferInfo{};
-        setupDescriptorBufferInfo(uniformBuffers[i].handle, 
-                                  0, 
-                                  sizeof(UniformBufferObject), 
-                                  bufferInfo);
-
-        VkDescriptorImageInfo imageInfo{};
-        setupDescriptorImageInfo(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                                 textureImageView,
-                                 textureSampler,
-                                 imageInfo);
-
-        std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
-
-        descriptorWrites[0].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[0].dstSet          = descriptorSets[i];
-        descriptorWrites[0].dstBinding      = 0;
-        descriptorWrites[0].dstArrayElement = 0;
-        descriptorWrites[0].descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        descriptorWrites[0].descriptorCount = 1;
-        descriptorWrites[0].pBufferInfo     = &bufferInfo;
-
-        descriptorWrites[1].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[1].dstSet          = descriptorSets[i];
-        descriptorWrites[1].dstBinding      = 1;
-        descriptorWrites[1].dstArrayElement = 0;
-        descriptorWrites[1].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        descriptorWrites[1].descriptorCount = 1;
-        descriptorWrites[1].pImageInfo      = &imageInfo;
-
-        vkUpdateDescriptorSets(device.handle,
-                               static_cast<uint32_t>(descriptorWrites.size()), 
-                               descriptorWrites.data(), 
-                               0, 
-                               nullptr);
-    }
+
+void writeTextureDescriptor(const LogicalDevice  &device,
+                            VkDescriptorSet      descriptorSet,
+                            uint32_t             textureIndex,
+                            VkImageView          textureImageView)
+{
+    VkDescriptorImageInfo imageInfo{};
+    setupDescriptorImageInfo(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                             textureImageView,
+                             VK_NULL_HANDLE,
+                             imageInfo);
+
+    VkWriteDescriptorSet descriptorWrite{};
+    descriptorWrite.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet          = descriptorSet;
+    descriptorWrite.dstBinding      = 0;
+    descriptorWrite.dstArrayElement = textureIndex;
+    descriptorWrite.descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pImageInfo      = &imageInfo;
+
+    vkUpdateDescriptorSets(device.handle, 1, &descriptorWrite, 0, nullptr);
 }
 
 ///////////////////////// PUBLIC END /////////////////////////////
\ No newline at end of file
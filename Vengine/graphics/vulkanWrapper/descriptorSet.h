@@ -8,12 +8,42 @@
 
 #include "device.h"
 #include "buffer.h"
+#include "descriptorAllocator.h"
 
-void createDescriptorSets(const LogicalDevice          &device,
-                          VkDescriptorPool             descriptorPool,
-                          VkDescriptorSetLayout        descriptorSetLayout,
-                          std::vector<VkDescriptorSet> &descriptorSets,
-                          std::vector<Buffer>          &uniformBuffers,
-                          VkImageView                  textureImageView,
-                          VkSampler                    textureSampler,
-                          uint32_t                     amount);
\ No newline at end of file
+//   ,       
+// ,     ,      
+void createFrameDescriptorSets(DescriptorCache              &descriptorCache,
+                               VkDescriptorSetLayout        descriptorSetLayout,
+                               std::vector<VkDescriptorSet> &descriptorSets,
+                               std::vector<Buffer>          &uniformBuffers,
+                               std::vector<Buffer>          &feedbackBuffers,
+                               uint32_t                     amount);
+
+
+//  ,       
+void createCullingDescriptorSets(DescriptorCache              &descriptorCache,
+                                 VkDescriptorSetLayout        descriptorSetLayout,
+                                 std::vector<VkDescriptorSet> &descriptorSets,
+                                 std::vector<Buffer>          &uniformBuffers,
+                                 std::vector<Buffer>          &objectBuffers,
+                                 std::vector<Buffer>          &groupBuffers,
+                                 std::vector<Buffer>          &counterBuffers,
+                                 std::vector<Buffer>          &instanceBuffers,
+                                 std::vector<Buffer>          &indirectBuffers,
+                                 std::vector<Buffer>          &clusterBuffers,
+                                 uint32_t                     amount);
+
+
+//   .    , 
+//     writeTextureDescriptor
+VkDescriptorSet createTextureDescriptorSet(const LogicalDevice   &device,
+                                           VkDescriptorPool      descriptorPool,
+                                           VkDescriptorSetLayout descriptorSetLayout,
+                                           VkSampler             textureSampler);
+
+
+//     textureIndex  
+void writeTextureDescriptor(const LogicalDevice  &device,
+                            VkDescriptorSet      descriptorSet,
+                            uint32_t             textureIndex,
+                            VkImageView          textureImageView);
\ No newline at end of file
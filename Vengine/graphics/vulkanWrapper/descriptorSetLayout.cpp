@@ -20,29 +20,30 @@ void setupDescriptorSetLayoutBinding(uint32_t                     binding,
     uboLayoutBinding.pImmutableSamplers = nullptr; // Optional
 }
 
-VkDescriptorSetLayout createDescriptorSetLayout(VkDevice  logicalDevice)
+VkDescriptorSetLayout createDescriptorSetLayout(VkDevice                                         logicalDevice,
+                                                const std::vector<VkDescriptorSetLayoutBinding> &bindings,
+                                                const std::vector<VkDescriptorBindingFlagsEXT>   &bindingFlags)
 {
-    VkDescriptorSetLayoutBinding uboLayoutBinding{};
-    setupDescriptorSetLayoutBinding(0, //binding
-                                    1, //count
-                                    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                                    uboLayoutBinding);
-
-    VkDescriptorSetLayoutBinding samplerLayoutBinding{};
-    setupDescriptorSetLayoutBinding(1, 
-                                    1, 
-                                    VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                                    VK_SHADER_STAGE_FRAGMENT_BIT,
-                                    samplerLayoutBinding);
-
-    std::array<VkDescriptorSetLayoutBinding, 2> bindings = {uboLayoutBinding, samplerLayoutBinding};
-
     VkDescriptorSetLayoutCreateInfo layoutInfo{};
     layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
     layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
     layoutInfo.pBindings    = bindings.data();
 
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo{};
+    if(!bindingFlags.empty())
+    {
+        bindingFlagsInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+        bindingFlagsInfo.bindingCount  = static_cast<uint32_t>(bindingFlags.size());
+        bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+        layoutInfo.pNext = &bindingFlagsInfo;
+
+        //             
+        for(VkDescriptorBindingFlagsEXT flags : bindingFlags)
+            if(flags & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT)
+                layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    }
+
     VkDescriptorSetLayout descriptorSetLayout;
     if(vkCreateDescriptorSetLayout(logicalDevice, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS)
         throw std::runtime_error("failed to create descriptor set layout!");
@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.h>
 
 #include <array>
+#include <vector>
 #include <stdexcept>
 
 void setupDescriptorSetLayoutBinding(uint32_t                     binding,
@@ -11,4 +12,11 @@ void setupDescriptorSetLayoutBinding(uint32_t                     binding,
                                      VkShaderStageFlags           shaderStage,
                                      VkDescriptorSetLayoutBinding &uboLayoutBinding);
 
-VkDescriptorSetLayout createDescriptorSetLayout(VkDevice logicalDevice);
\ No newline at end of file
+// PARTIALLY_BOUND -    ,     
+// UPDATE_AFTER_BIND -        ,
+//     .          
+// UPDATE_UNUSED_WHILE_PENDING - ,      ,
+//  ,   
+VkDescriptorSetLayout createDescriptorSetLayout(VkDevice                                         logicalDevice,
+                                                const std::vector<VkDescriptorSetLayoutBinding> &bindings,
+                                                const std::vector<VkDescriptorBindingFlagsEXT>   &bindingFlags = {});
\ No newline at end of file
@@ -1,8 +1,10 @@
 #include "device.h"
 
 #include <iostream>
+#include <algorithm>
 #include <stdexcept>
 #include <set>
+#include <string>
 
 ///////////////////////// STATIC BEG //////////////////////////////
 
@@ -35,6 +37,38 @@ static bool checkDeviceExtensionsSupport(VkPhysicalDevice                physica
     return requiredExtensionsSet.empty();
 }
 
+/*
+*  VK_EXT_descriptor_indexing,     :
+*      ,     
+*       
+*/
+static void setupDescriptorIndexingFeatures(VkPhysicalDeviceDescriptorIndexingFeaturesEXT &indexingFeatures)
+{
+    indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+    indexingFeatures.runtimeDescriptorArray                       = VK_TRUE;
+    indexingFeatures.descriptorBindingPartiallyBound              = VK_TRUE;
+    indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    indexingFeatures.descriptorBindingUpdateUnusedWhilePending    = VK_TRUE;
+}
+
+static bool checkDescriptorIndexingSupport(VkPhysicalDevice physicalDevice)
+{
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures{};
+    indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+    VkPhysicalDeviceFeatures2 features{};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &indexingFeatures;
+
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+    return indexingFeatures.runtimeDescriptorArray                       &&
+           indexingFeatures.descriptorBindingPartiallyBound              &&
+           indexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+           indexingFeatures.descriptorBindingUpdateUnusedWhilePending;
+}
+
 /*
 *       
 */
@@ -44,26 +78,29 @@ static bool isDeviceSuitable(VkPhysicalDevice                physicalDevice,
 {
     QueueFamilyIndices indices = findQueueFamilies(physicalDevice, surface);
 
-    VkPhysicalDeviceProperties deviceProperties;
-    VkPhysicalDeviceFeatures   supportedFeatures;
-
-    vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
-    vkGetPhysicalDeviceFeatures  (physicalDevice, &supportedFeatures);
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
 
     bool extensionsSupported = checkDeviceExtensionsSupport(physicalDevice, requiredExtensions);
 
-    bool swapChainAdequate = false;
-    if(extensionsSupported)
+    //       ,     
+    bool swapChainAdequate = surface == VK_NULL_HANDLE;
+    if(extensionsSupported && surface != VK_NULL_HANDLE)
     {
         SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice, surface);
         swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
     }
 
-    return deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU &&
-            supportedFeatures.geometryShader                                   &&
+    //     ,    
+    bool descriptorIndexingSupported = extensionsSupported && checkDescriptorIndexingSupport(physicalDevice);
+
+    return  supportedFeatures.geometryShader                                   &&
             supportedFeatures.fillModeNonSolid                                 && 
             supportedFeatures.samplerAnisotropy                                &&
+            supportedFeatures.drawIndirectFirstInstance                        &&
+            supportedFeatures.fragmentStoresAndAtomics                         &&
             extensionsSupported                                                &&
+            descriptorIndexingSupported                                        &&
             swapChainAdequate                                                  &&
             indices.has_value();
 }
@@ -87,9 +124,13 @@ static void setupQueueFamilies(const std::set<uint32_t>             &uniqueQueue
 
 static void setupDeviceFeatures(VkPhysicalDeviceFeatures  &deviceFeatures)
 {
-    deviceFeatures.geometryShader    = VK_TRUE;
-    deviceFeatures.fillModeNonSolid  = VK_TRUE;
-    deviceFeatures.samplerAnisotropy = VK_TRUE;
+    deviceFeatures.geometryShader            = VK_TRUE;
+    deviceFeatures.fillModeNonSolid          = VK_TRUE;
+    deviceFeatures.samplerAnisotropy         = VK_TRUE;
+    // firstInstance           
+    deviceFeatures.drawIndirectFirstInstance = VK_TRUE;
+    //         atomicMax
+    deviceFeatures.fragmentStoresAndAtomics  = VK_TRUE;
 }
 
 ///////////////////////// STATIC END //////////////////////////////
@@ -147,11 +188,16 @@ QueueFamilyIndices findQueueFamilies(VkPhysicalDevice  physicalDevice,
             indices.graphicsFamily = i;
 
         VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
+        if(surface != VK_NULL_HANDLE)
+            vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
 
         if(presentSupport)
             indices.presentFamily = i;
 
+        //  ,      
+        if(surface == VK_NULL_HANDLE && indices.graphicsFamily.has_value())
+            indices.presentFamily = indices.graphicsFamily;
+
         if(indices.has_value())
             break;
 
@@ -175,17 +221,104 @@ VkPhysicalDevice pickPhysicalDevice(VkInstance                      instance,
     std::vector<VkPhysicalDevice> devices(deviceCount);
     vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
 
+    //      ,      ,
+    //    vulkan (lavapipe),     
+    VkPhysicalDevice fallbackDevice = VK_NULL_HANDLE;
     for(auto &device : devices)
     {
-        if(isDeviceSuitable(device, surface, requiredExtenisons))
+        if(!isDeviceSuitable(device, surface, requiredExtenisons))
+            continue;
+
+        VkPhysicalDeviceProperties deviceProperties;
+        vkGetPhysicalDeviceProperties(device, &deviceProperties);
+
+        if(deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
             return device;
+
+        if(fallbackDevice == VK_NULL_HANDLE)
+            fallbackDevice = device;
     }
 
+    if(fallbackDevice != VK_NULL_HANDLE)
+        return fallbackDevice;
+
     //      
     throw std::runtime_error("failed to find a suitable GPU!");
 }
 
 
+bool isDeviceExtensionSupported(VkPhysicalDevice  physicalDevice,
+                                const char       *extension)
+{
+    uint32_t extensionCount;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+
+    std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+
+    for(auto &availableExtension : availableExtensions)
+    {
+        if(std::string(availableExtension.extensionName) == extension)
+            return true;
+    }
+
+    return false;
+}
+
+
+uint32_t getMaxUpdateAfterBindImages(VkPhysicalDevice physicalDevice)
+{
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT indexingProperties{};
+    indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+
+    VkPhysicalDeviceProperties2 properties{};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = &indexingProperties;
+
+    vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+    return std::min(indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                    indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages);
+}
+
+
+DeviceMemoryBudget queryDeviceMemoryBudget(VkPhysicalDevice physicalDevice,
+                                           bool             memoryBudgetEnabled)
+{
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+    budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2 properties{};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    properties.pNext = memoryBudgetEnabled ? &budgetProperties : nullptr;
+
+    vkGetPhysicalDeviceMemoryProperties2(physicalDevice, &properties);
+
+    DeviceMemoryBudget budget{};
+    budget.measured = memoryBudgetEnabled;
+
+    const VkPhysicalDeviceMemoryProperties &memoryProperties = properties.memoryProperties;
+    for(uint32_t heap = 0; heap < memoryProperties.memoryHeapCount; heap++)
+    {
+        if(!(memoryProperties.memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+            continue;
+
+        budget.heapSize += memoryProperties.memoryHeaps[heap].size;
+
+        if(memoryBudgetEnabled)
+        {
+            budget.budget += budgetProperties.heapBudget[heap];
+            budget.usage  += budgetProperties.heapUsage[heap];
+        }
+    }
+
+    if(!memoryBudgetEnabled)
+        budget.budget = budget.heapSize;
+
+    return budget;
+}
+
+
 LogicalDevice createLogicalDevice(VkInstance                      instance,
                                   VkPhysicalDevice                physicalDevice,
                                   VkSurfaceKHR                    surface,
@@ -203,8 +336,12 @@ LogicalDevice createLogicalDevice(VkInstance                      instance,
     VkPhysicalDeviceFeatures deviceFeatures{};
     setupDeviceFeatures(deviceFeatures);
 
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures{};
+    setupDescriptorIndexingFeatures(indexingFeatures);
+
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    createInfo.pNext = &indexingFeatures;
 
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos    = queueCreateInfos.data();
@@ -47,6 +47,30 @@ VkPhysicalDevice pickPhysicalDevice(VkInstance                      instance,
                                     const std::vector<const char *> &requiredExtensions);
 
 
+//   ,     
+bool isDeviceExtensionSupported(VkPhysicalDevice  physicalDevice,
+                                const char       *extension);
+
+
+//          VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+uint32_t getMaxUpdateAfterBindImages(VkPhysicalDevice physicalDevice);
+
+
+//    (VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+// budget -     , usage -    
+struct DeviceMemoryBudget
+{
+    VkDeviceSize heapSize;
+    VkDeviceSize budget;
+    VkDeviceSize usage;
+    // false,  VK_EXT_memory_budget  .  budget  heapSize,  usage 
+    bool         measured;
+};
+
+DeviceMemoryBudget queryDeviceMemoryBudget(VkPhysicalDevice physicalDevice,
+                                           bool             memoryBudgetEnabled);
+
+
 LogicalDevice createLogicalDevice(VkInstance                      instance,
                                   VkPhysicalDevice                physicalDevice,
                                   VkSurfaceKHR                    surface,
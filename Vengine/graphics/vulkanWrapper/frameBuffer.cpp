@@ -7,7 +7,7 @@
 VkFramebuffer createFrameBuffer(const LogicalDevice              &device,
                                 VkRenderPass                      renderPass,
                                 const VkExtent3D                 &extent,
-                                const std::array<VkImageView, 2> &attachments)
+                                const std::vector<VkImageView>   &attachments)
 {
     VkFramebufferCreateInfo framebufferInfo{};
     framebufferInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
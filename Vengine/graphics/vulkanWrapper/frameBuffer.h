@@ -1,10 +1,10 @@
 #pragma once
 
-#include <array>
+#include <vector>
 
 #include "device.h"
 
 VkFramebuffer createFrameBuffer(const LogicalDevice              &device,
                                 VkRenderPass                      renderPass,
                                 const VkExtent3D                 &extent,
-                                const std::array<VkImageView, 2> &attachments);
\ No newline at end of file
+                                const std::vector<VkImageView>   &attachments);
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include "geometryPool.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+//   ,         
+static const uint32_t minVertexCapacity = 64 * 1024;
+static const uint32_t minIndexCapacity  = 3 * minVertexCapacity;
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+
+///////////////////////// RANGE ALLOCATOR BEG //////////////////////////////
+
+RangeAllocator::RangeAllocator()
+{
+    this->capacity = 0;
+    this->used     = 0;
+}
+
+bool RangeAllocator::allocate(uint32_t count, uint32_t &offset)
+{
+    if(count == 0)
+    {
+        offset = 0;
+        return true;
+    }
+
+    for(auto block = freeBlocks.begin(); block != freeBlocks.end(); block++)
+    {
+        if(block->second < count)
+            continue;
+
+        offset = block->first;
+
+        //    
+        uint32_t rest = block->second - count;
+        freeBlocks.erase(block);
+        if(rest > 0)
+            freeBlocks[offset + count] = rest;
+
+        used += count;
+        return true;
+    }
+
+    return false;
+}
+
+void RangeAllocator::free(uint32_t offset, uint32_t count)
+{
+    if(count == 0)
+        return;
+
+    auto next = freeBlocks.lower_bound(offset);
+
+    //     ,    ,   
+    if(next != freeBlocks.begin())
+    {
+        auto previous = std::prev(next);
+        if(previous->first + previous->second == offset)
+        {
+            offset  = previous->first;
+            count  += previous->second;
+            freeBlocks.erase(previous);
+        }
+    }
+
+    //   ,      
+    if(next != freeBlocks.end() && offset + count == next->first)
+    {
+        count += next->second;
+        freeBlocks.erase(next);
+    }
+
+    freeBlocks[offset] = count;
+    used -= std::min(used, count);
+}
+
+void RangeAllocator::grow(uint32_t newCapacity)
+{
+    if(newCapacity <= capacity)
+        return;
+
+    // free       . used   
+    // ,       
+    uint32_t added = newCapacity - capacity;
+    uint32_t start = capacity;
+
+    capacity  = newCapacity;
+    used     += added;
+    free(start, added);
+}
+
+uint32_t RangeAllocator::getCapacity() const
+{
+    return capacity;
+}
+
+uint32_t RangeAllocator::getUsed() const
+{
+    return used;
+}
+
+uint32_t RangeAllocator::getFreeBlockCount() const
+{
+    return static_cast<uint32_t>(freeBlocks.size());
+}
+
+void RangeAllocator::clear()
+{
+    freeBlocks.clear();
+    capacity = 0;
+    used     = 0;
+}
+
+///////////////////////// RANGE ALLOCATOR END //////////////////////////////
+
+
+
+///////////////////////// GEOMETRY POOL BEG //////////////////////////////
+
+GeometryPool::GeometryPool()
+{
+    this->device    = nullptr;
+    this->growCount = 0;
+}
+
+void GeometryPool::create(const LogicalDevice *device)
+{
+    this->device = device;
+}
+
+GeometryAllocation GeometryPool::add(UploadBatch                 &upload,
+                                     const std::vector<Vertex>   &vertices,
+                                     const std::vector<uint32_t> &indices)
+{
+    GeometryAllocation allocation{};
+    allocation.vertexCount = static_cast<uint32_t>(vertices.size());
+    allocation.indexCount  = static_cast<uint32_t>(indices.size());
+
+    allocation.firstVertex = allocate(upload,
+                                      vertexBuffer,
+                                      vertexRanges,
+                                      allocation.vertexCount,
+                                      minVertexCapacity,
+                                      sizeof(Vertex),
+                                      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+
+    allocation.firstIndex  = allocate(upload,
+                                      indexBuffer,
+                                      indexRanges,
+                                      allocation.indexCount,
+                                      minIndexCapacity,
+                                      sizeof(uint32_t),
+                                      VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+
+    if(!vertices.empty())
+        upload.copyToBuffer(vertices.data(),
+                            vertices.size() * sizeof(Vertex),
+                            *vertexBuffer,
+                            allocation.firstVertex * sizeof(Vertex));
+
+    if(!indices.empty())
+        upload.copyToBuffer(indices.data(),
+                            indices.size() * sizeof(uint32_t),
+                            *indexBuffer,
+                            allocation.firstIndex * sizeof(uint32_t));
+
+    return allocation;
+}
+
+void GeometryPool::remove(const GeometryAllocation &allocation)
+{
+    vertexRanges.free(allocation.firstVertex, allocation.vertexCount);
+    indexRanges.free(allocation.firstIndex, allocation.indexCount);
+}
+
+void GeometryPool::releaseRetiredBuffers()
+{
+    retiredBuffers.clear();
+}
+
+VkBuffer GeometryPool::getVertexBuffer() const
+{
+    return vertexBuffer ? vertexBuffer->handle : VK_NULL_HANDLE;
+}
+
+VkBuffer GeometryPool::getIndexBuffer() const
+{
+    return indexBuffer ? indexBuffer->handle : VK_NULL_HANDLE;
+}
+
+GeometryPoolStats GeometryPool::getStats() const
+{
+    GeometryPoolStats stats{};
+    stats.vertexCapacity = vertexRanges.getCapacity();
+    stats.vertexUsed     = vertexRanges.getUsed();
+    stats.indexCapacity  = indexRanges.getCapacity();
+    stats.indexUsed      = indexRanges.getUsed();
+    stats.freeBlockCount = vertexRanges.getFreeBlockCount() + indexRanges.getFreeBlockCount();
+    stats.growCount      = growCount;
+
+    return stats;
+}
+
+void GeometryPool::destroy()
+{
+    retiredBuffers.clear();
+    vertexBuffer.reset();
+    indexBuffer.reset();
+
+    vertexRanges.clear();
+    indexRanges.clear();
+    growCount = 0;
+}
+
+
+void GeometryPool::growBuffer(UploadBatch             &upload,
+                              std::unique_ptr<Buffer> &buffer,
+                              RangeAllocator          &ranges,
+                              uint32_t                 newCapacity,
+                              VkDeviceSize             elementSize,
+                              VkBufferUsageFlags       usage)
+{
+    std::unique_ptr<Buffer> newBuffer(new Buffer(device));
+    newBuffer->create(newCapacity * elementSize,
+                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                      VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                      usage,
+                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    if(buffer)
+    {
+        //           
+        upload.memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_ACCESS_TRANSFER_WRITE_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_ACCESS_TRANSFER_READ_BIT);
+
+        upload.copyBuffer(*buffer, *newBuffer, ranges.getCapacity() * elementSize);
+
+        //       ,   
+        //     ,       
+        upload.memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_ACCESS_TRANSFER_WRITE_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_ACCESS_TRANSFER_WRITE_BIT);
+
+        retiredBuffers.push_back(std::move(buffer));
+    }
+
+    buffer = std::move(newBuffer);
+    ranges.grow(newCapacity);
+}
+
+uint32_t GeometryPool::allocate(UploadBatch             &upload,
+                                std::unique_ptr<Buffer> &buffer,
+                                RangeAllocator          &ranges,
+                                uint32_t                 count,
+                                uint32_t                 minCapacity,
+                                VkDeviceSize             elementSize,
+                                VkBufferUsageFlags       usage)
+{
+    uint32_t offset = 0;
+    if(ranges.allocate(count, offset))
+        return offset;
+
+    //     ,         
+    uint32_t capacity    = ranges.getCapacity();
+    uint32_t newCapacity = std::max({minCapacity, capacity * 2, capacity + count});
+
+    growBuffer(upload, buffer, ranges, newCapacity, elementSize, usage);
+    growCount++;
+
+    if(!ranges.allocate(count, offset))
+        throw std::runtime_error("failed to allocate geometry pool range!");
+
+    return offset;
+}
+
+///////////////////////// GEOMETRY POOL END //////////////////////////////
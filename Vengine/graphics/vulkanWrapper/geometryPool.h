@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "device.h"
+#include "buffer.h"
+#include "uploadBatch.h"
+
+/*
+*   [offset, offset + count)   
+*      .   ,
+*       ,   
+*      
+*/
+struct RangeAllocator
+{
+    RangeAllocator();
+
+    // false,      count
+    bool allocate(uint32_t count, uint32_t &offset);
+    void free    (uint32_t offset, uint32_t count);
+
+    //        newCapacity 
+    void grow(uint32_t newCapacity);
+
+    uint32_t getCapacity()       const;
+    uint32_t getUsed()           const;
+    uint32_t getFreeBlockCount() const;
+
+    void clear();
+
+private:
+    //    ->  
+    std::map<uint32_t, uint32_t> freeBlocks;
+    uint32_t                     capacity;
+    uint32_t                     used;
+};
+
+//  ,   .    firstVertex
+struct GeometryAllocation
+{
+    uint32_t firstVertex = 0;
+    uint32_t vertexCount = 0;
+    uint32_t firstIndex  = 0;
+    uint32_t indexCount  = 0;
+};
+
+struct GeometryPoolStats
+{
+    uint32_t vertexCapacity;
+    uint32_t vertexUsed;
+    uint32_t indexCapacity;
+    uint32_t indexUsed;
+    //       .   -  
+    uint32_t freeBlockCount;
+    //       
+    uint32_t growCount;
+};
+
+/*
+*           
+*       ,     
+*       vertexOffset  firstIndex
+*    ,    ,    
+*       .     releaseRetiredBuffers
+*   .     
+*/
+struct GeometryPool
+{
+    const LogicalDevice  *device;
+
+    GeometryPool();
+
+    void create(const LogicalDevice *device);
+
+    //          upload
+    //       ,     
+    GeometryAllocation add(UploadBatch                 &upload,
+                           const std::vector<Vertex>   &vertices,
+                           const std::vector<uint32_t> &indices);
+
+    //    ,          
+    void remove(const GeometryAllocation &allocation);
+
+    //  ,   .     
+    void releaseRetiredBuffers();
+
+    VkBuffer getVertexBuffer() const;
+    VkBuffer getIndexBuffer()  const;
+
+    GeometryPoolStats getStats() const;
+
+    void destroy();
+
+private:
+    std::unique_ptr<Buffer>              vertexBuffer;
+    std::unique_ptr<Buffer>              indexBuffer;
+    std::vector<std::unique_ptr<Buffer>> retiredBuffers;
+
+    RangeAllocator                       vertexRanges;
+    RangeAllocator                       indexRanges;
+    uint32_t                             growCount;
+
+    //  buffer  newCapacity  elementSize     
+    void growBuffer(UploadBatch             &upload,
+                    std::unique_ptr<Buffer> &buffer,
+                    RangeAllocator          &ranges,
+                    uint32_t                 newCapacity,
+                    VkDeviceSize             elementSize,
+                    VkBufferUsageFlags       usage);
+
+    uint32_t allocate(UploadBatch             &upload,
+                      std::unique_ptr<Buffer> &buffer,
+                      RangeAllocator          &ranges,
+                      uint32_t                 count,
+                      uint32_t                 minCapacity,
+                      VkDeviceSize             elementSize,
+                      VkBufferUsageFlags       usage);
+};
@@ -0,0 +1,448 @@
+#include "gpuProfiler.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+//      .    
+static const uint32_t maxQueriesPerBuffer = 32;
+
+//  ,    
+static const size_t maxTraceRanges = 16384;
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+static VkQueryPool createTimestampQueryPool(VkDevice logicalDevice, uint32_t queryCount)
+{
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = queryCount;
+
+    VkQueryPool queryPool;
+    if(vkCreateQueryPool(logicalDevice, &poolInfo, nullptr, &queryPool) != VK_SUCCESS)
+        throw std::runtime_error("failed to create timestamp query pool!");
+
+    return queryPool;
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// GPU PROFILER BEG //////////////////////////////
+
+GpuProfiler::GpuProfiler()
+{
+    device          = nullptr;
+    supported       = false;
+    timestampPeriod = 0.0f;
+    timestampMask   = 0;
+    windowSize      = 0;
+
+    calibrated       = false;
+    calibrationTicks = 0;
+    nextTraceRange   = 0;
+}
+
+void GpuProfiler::create(const LogicalDevice *device,
+                         uint32_t             windowSize)
+{
+    this->device     = device;
+    this->windowSize = std::max(windowSize, 1u);
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(device->physicalDevice, &queueFamilyCount, nullptr);
+
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(device->physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+    //     .    ,
+    //        2^validBits
+    uint32_t validBits = queueFamilies[device->familyIndices.graphicsFamily.value()].timestampValidBits;
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(device->physicalDevice, &properties);
+
+    supported = validBits > 0 && properties.limits.timestampPeriod > 0.0f;
+    if(!supported)
+    {
+        std::cout << "\ngpu timestamps are not supported by the graphics queue\n";
+        return;
+    }
+
+    timestampMask   = validBits >= 64 ? UINT64_MAX : (uint64_t(1) << validBits) - 1;
+    // timestampPeriod     
+    timestampPeriod = properties.limits.timestampPeriod / 1000000.0f;
+
+    upload.queryCount = 2;
+    upload.queryPool  = createTimestampQueryPool(device->handle, upload.queryCount);
+}
+
+bool GpuProfiler::isSupported() const
+{
+    return supported;
+}
+
+void GpuProfiler::calibrate(VkCommandPool commandPool)
+{
+    if(!supported)
+        return;
+
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool        = commandPool;
+    allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer commandBuffer;
+    if(vkAllocateCommandBuffers(device->handle, &allocInfo, &commandBuffer) != VK_SUCCESS)
+        throw std::runtime_error("failed to allocate command buffers!");
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    vkCmdResetQueryPool(commandBuffer, upload.queryPool, 0, upload.queryCount);
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, upload.queryPool, 0);
+    vkEndCommandBuffer(commandBuffer);
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers    = &commandBuffer;
+
+    //  ,       
+    //  -   vkQueueSubmit   ,   
+    vkDeviceWaitIdle(device->handle);
+
+    calibrationTime = std::chrono::steady_clock::now();
+    vkQueueSubmit(device->graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+    vkQueueWaitIdle(device->graphicsQueue);
+
+    vkGetQueryPoolResults(device->handle,
+                          upload.queryPool,
+                          0,
+                          1,
+                          sizeof(calibrationTicks),
+                          &calibrationTicks,
+                          sizeof(calibrationTicks),
+                          VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+
+    vkFreeCommandBuffers(device->handle, commandPool, 1, &commandBuffer);
+
+    calibrated = true;
+}
+
+GpuProfiler::RecordedBuffer &GpuProfiler::getBuffer(uint32_t bufferIndex)
+{
+    if(bufferIndex >= buffers.size())
+        buffers.resize(bufferIndex + 1);
+
+    RecordedBuffer &buffer = buffers[bufferIndex];
+
+    if(!buffer.queryPool)
+    {
+        buffer.queryCount = maxQueriesPerBuffer;
+        buffer.queryPool  = createTimestampQueryPool(device->handle, buffer.queryCount);
+    }
+
+    return buffer;
+}
+
+size_t GpuProfiler::getScope(const std::string &name)
+{
+    for(size_t i = 0; i < scopes.size(); i++)
+        if(scopes[i].name == name)
+            return i;
+
+    ScopeSamples scope;
+    scope.name = name;
+    scope.samples.reserve(windowSize);
+
+    scopes.push_back(scope);
+
+    return scopes.size() - 1;
+}
+
+void GpuProfiler::resetQueries(VkCommandBuffer commandBuffer, RecordedBuffer &buffer)
+{
+    //     ,    
+    vkCmdResetQueryPool(commandBuffer, buffer.queryPool, 0, buffer.queryCount);
+
+    buffer.usedQueries = 0;
+    buffer.submitted   = false;
+    buffer.scopes.clear();
+    buffer.openScopes.clear();
+}
+
+void GpuProfiler::writeBegin(VkCommandBuffer commandBuffer, RecordedBuffer &buffer, const std::string &name)
+{
+    RecordedScope scope{};
+    scope.scope      = getScope(name);
+    scope.beginQuery = buffer.usedQueries;
+    scope.endQuery   = buffer.usedQueries + 1;
+
+    buffer.usedQueries += 2;
+
+    //   ,        
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, buffer.queryPool, scope.beginQuery);
+
+    buffer.openScopes.push_back(buffer.scopes.size());
+    buffer.scopes.push_back(scope);
+}
+
+void GpuProfiler::writeEnd(VkCommandBuffer commandBuffer, RecordedBuffer &buffer)
+{
+    if(buffer.openScopes.empty())
+        throw std::runtime_error("gpu profiler scope was not begun!");
+
+    const RecordedScope &scope = buffer.scopes[buffer.openScopes.back()];
+    buffer.openScopes.pop_back();
+
+    //  -      
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, buffer.queryPool, scope.endQuery);
+}
+
+bool GpuProfiler::readResults(RecordedBuffer &buffer)
+{
+    if(!buffer.submitted || buffer.usedQueries == 0)
+        return false;
+
+    std::vector<uint64_t> timestamps(buffer.usedQueries);
+
+    //  VK_QUERY_RESULT_WAIT_BIT       VK_NOT_READY,
+    //  -    
+    VkResult result = vkGetQueryPoolResults(device->handle,
+                                            buffer.queryPool,
+                                            0,
+                                            buffer.usedQueries,
+                                            timestamps.size() * sizeof(uint64_t),
+                                            timestamps.data(),
+                                            sizeof(uint64_t),
+                                            VK_QUERY_RESULT_64_BIT);
+    if(result != VK_SUCCESS)
+        return false;
+
+    for(const RecordedScope &scope : buffer.scopes)
+    {
+        uint64_t ticks = (timestamps[scope.endQuery] - timestamps[scope.beginQuery]) & timestampMask;
+        addSample(scope.scope, ticks * timestampPeriod);
+
+        TimestampRange range{};
+        range.scope = scope.scope;
+        range.begin = timestamps[scope.beginQuery];
+        range.end   = timestamps[scope.endQuery];
+
+        if(traceRanges.size() < maxTraceRanges)
+            traceRanges.push_back(range);
+        else
+            traceRanges[nextTraceRange] = range;
+
+        nextTraceRange = (nextTraceRange + 1) % maxTraceRanges;
+    }
+
+    //      
+    buffer.submitted = false;
+
+    return true;
+}
+
+void GpuProfiler::addSample(size_t scope, float time)
+{
+    ScopeSamples &samples = scopes[scope];
+    samples.last = time;
+
+    if(samples.samples.size() < windowSize)
+    {
+        samples.samples.push_back(time);
+        return;
+    }
+
+    samples.samples[samples.next] = time;
+    samples.next = (samples.next + 1) % windowSize;
+}
+
+void GpuProfiler::beginRecording(VkCommandBuffer commandBuffer, uint32_t bufferIndex)
+{
+    if(!supported)
+        return;
+
+    resetQueries(commandBuffer, getBuffer(bufferIndex));
+}
+
+void GpuProfiler::beginScope(VkCommandBuffer commandBuffer, uint32_t bufferIndex, const std::string &name)
+{
+    if(!supported)
+        return;
+
+    RecordedBuffer &buffer = getBuffer(bufferIndex);
+
+    if(buffer.usedQueries + 2 > buffer.queryCount)
+        throw std::runtime_error("too many gpu profiler scopes in one command buffer!");
+
+    writeBegin(commandBuffer, buffer, name);
+}
+
+void GpuProfiler::endScope(VkCommandBuffer commandBuffer, uint32_t bufferIndex)
+{
+    if(!supported)
+        return;
+
+    writeEnd(commandBuffer, getBuffer(bufferIndex));
+}
+
+void GpuProfiler::markSubmitted(uint32_t bufferIndex)
+{
+    if(!supported || bufferIndex >= buffers.size())
+        return;
+
+    buffers[bufferIndex].submitted = true;
+}
+
+bool GpuProfiler::collect(uint32_t bufferIndex)
+{
+    if(!supported || bufferIndex >= buffers.size())
+        return false;
+
+    return readResults(buffers[bufferIndex]);
+}
+
+void GpuProfiler::beginUpload(VkCommandBuffer commandBuffer)
+{
+    if(!supported)
+        return;
+
+    resetQueries(commandBuffer, upload);
+    writeBegin(commandBuffer, upload, "upload");
+}
+
+void GpuProfiler::endUpload(VkCommandBuffer commandBuffer)
+{
+    if(!supported)
+        return;
+
+    writeEnd(commandBuffer, upload);
+    upload.submitted = true;
+}
+
+void GpuProfiler::collectUpload()
+{
+    if(!supported)
+        return;
+
+    readResults(upload);
+}
+
+std::vector<std::string> GpuProfiler::getScopeNames() const
+{
+    std::vector<std::string> names;
+    for(const ScopeSamples &scope : scopes)
+        names.push_back(scope.name);
+
+    return names;
+}
+
+GpuScopeStats GpuProfiler::getStats(const std::string &name) const
+{
+    GpuScopeStats stats{};
+
+    for(const ScopeSamples &scope : scopes)
+    {
+        if(scope.name != name || scope.samples.empty())
+            continue;
+
+        std::vector<float> sorted = scope.samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        float sum = 0.0f;
+        for(float value : sorted)
+            sum += value;
+
+        stats.last    = scope.last;
+        stats.min     = sorted.front();
+        stats.avg     = sum / sorted.size();
+        stats.p99     = sorted[std::min(sorted.size() - 1, sorted.size() * 99 / 100)];
+        stats.samples = sorted.size();
+    }
+
+    return stats;
+}
+
+std::vector<GpuTraceEvent> GpuProfiler::getTraceEvents() const
+{
+    std::vector<GpuTraceEvent> events;
+    if(!calibrated)
+        return events;
+
+    for(const TimestampRange &range : traceRanges)
+    {
+        //   ,     
+        uint64_t sinceCalibration = (range.begin - calibrationTicks) & timestampMask;
+        uint64_t duration         = (range.end   - range.begin)      & timestampMask;
+
+        std::chrono::duration<double, std::milli> offset(sinceCalibration * static_cast<double>(timestampPeriod));
+        std::chrono::duration<double, std::milli> length(duration         * static_cast<double>(timestampPeriod));
+
+        GpuTraceEvent event;
+        event.name     = scopes[range.scope].name;
+        event.begin    = calibrationTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset);
+        event.duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(length);
+
+        events.push_back(event);
+    }
+
+    return events;
+}
+
+void GpuProfiler::print() const
+{
+    std::cout << "\ngpu time, last " << windowSize << " samples per scope\n"
+              << std::fixed << std::setprecision(3);
+
+    for(const ScopeSamples &scope : scopes)
+    {
+        GpuScopeStats stats = getStats(scope.name);
+
+        if(stats.samples == 0)
+        {
+            std::cout << scope.name << ": no samples\n";
+            continue;
+        }
+
+        std::cout << scope.name << ": "
+                  << "avg " << stats.avg << " ms, "
+                  << "min " << stats.min << " ms, "
+                  << "p99 " << stats.p99 << " ms "
+                  << "(" << stats.samples << " samples)\n";
+    }
+}
+
+void GpuProfiler::resetStats()
+{
+    for(ScopeSamples &scope : scopes)
+    {
+        scope.samples.clear();
+        scope.next = 0;
+        scope.last = 0.0f;
+    }
+}
+
+void GpuProfiler::destroy()
+{
+    for(RecordedBuffer &buffer : buffers)
+        vkDestroyQueryPool(device->handle, buffer.queryPool, nullptr);
+
+    if(upload.queryPool)
+        vkDestroyQueryPool(device->handle, upload.queryPool, nullptr);
+
+    buffers.clear();
+    upload = RecordedBuffer();
+
+    traceRanges.clear();
+    nextTraceRange = 0;
+    calibrated     = false;
+}
+
+///////////////////////// GPU PROFILER END //////////////////////////////
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "device.h"
+
+/*
+*          windowSize 
+*/
+struct GpuScopeStats
+{
+    float  last;
+    float  min;
+    float  avg;
+    float  p99;
+    size_t samples;
+};
+
+/*
+* ,  ,   
+*/
+struct GpuTraceEvent
+{
+    std::string                           name;
+    std::chrono::steady_clock::time_point begin;
+    std::chrono::steady_clock::duration   duration;
+};
+
+/*
+*          
+*     ,      ,
+*    .        ,  
+*    .    ,   
+*  ,       
+*   beginSingleTimeCommands   UploadBatch   
+*       ,      
+*/
+struct GpuProfiler
+{
+    const LogicalDevice  *device;
+
+    GpuProfiler();
+
+    // windowSize -       
+    void create(const LogicalDevice *device,
+                uint32_t             windowSize);
+
+    bool isSupported() const;
+
+    //       ,  
+    //          
+    void calibrate(VkCommandPool commandPool);
+
+    //    vkBeginCommandBuffer,   
+    //       
+    void beginRecording(VkCommandBuffer commandBuffer, uint32_t bufferIndex);
+
+    //    . endScope   
+    void beginScope(VkCommandBuffer commandBuffer, uint32_t bufferIndex, const std::string &name);
+    void endScope  (VkCommandBuffer commandBuffer, uint32_t bufferIndex);
+
+    //    .       
+    void markSubmitted(uint32_t bufferIndex);
+
+    //     ,     
+    //  true,    
+    bool collect(uint32_t bufferIndex);
+
+    //  "upload"    
+    void beginUpload(VkCommandBuffer commandBuffer);
+    void endUpload  (VkCommandBuffer commandBuffer);
+    //       
+    void collectUpload();
+
+    std::vector<std::string> getScopeNames() const;
+    //     samples = 0
+    GpuScopeStats            getStats(const std::string &name) const;
+
+    //   . ,  calibrate  
+    std::vector<GpuTraceEvent> getTraceEvents() const;
+
+    void print() const;
+    void resetStats();
+
+    void destroy();
+
+private:
+    struct RecordedScope
+    {
+        size_t   scope;
+        uint32_t beginQuery;
+        uint32_t endQuery;
+    };
+
+    struct RecordedBuffer
+    {
+        VkQueryPool                 queryPool = VK_NULL_HANDLE;
+        uint32_t                    queryCount = 0;
+        uint32_t                    usedQueries = 0;
+        std::vector<RecordedScope>  scopes;
+        std::vector<size_t>         openScopes;
+        bool                        submitted = false;
+    };
+
+    struct ScopeSamples
+    {
+        std::string        name;
+        std::vector<float> samples;
+        //   ,    
+        size_t             next = 0;
+        float              last = 0.0f;
+    };
+
+    bool     supported;
+    //       
+    float    timestampPeriod;
+    uint64_t timestampMask;
+    uint32_t windowSize;
+
+    struct TimestampRange
+    {
+        size_t   scope;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    bool                                  calibrated;
+    uint64_t                              calibrationTicks;
+    std::chrono::steady_clock::time_point calibrationTime;
+
+    //      
+    std::vector<TimestampRange>           traceRanges;
+    size_t                                nextTraceRange;
+
+    std::vector<RecordedBuffer> buffers;
+    RecordedBuffer              upload;
+    std::vector<ScopeSamples>   scopes;
+
+    RecordedBuffer &getBuffer(uint32_t bufferIndex);
+    size_t          getScope(const std::string &name);
+
+    void resetQueries(VkCommandBuffer commandBuffer, RecordedBuffer &buffer);
+    void writeBegin  (VkCommandBuffer commandBuffer, RecordedBuffer &buffer, const std::string &name);
+    void writeEnd    (VkCommandBuffer commandBuffer, RecordedBuffer &buffer);
+    bool readResults (RecordedBuffer &buffer);
+    void addSample   (size_t scope, float time);
+};
\ No newline at end of file
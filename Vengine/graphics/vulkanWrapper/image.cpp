@@ -1,32 +1,10 @@
 #include "image.h"
 
 #include <stdexcept>
-
-#include "commandBuffer.h"
-#include "transitionImageLayout.h"
+#include <utility>
 
 ///////////////////////// STATIC BEG //////////////////////////////
 
-static void setupImageCopyRegion(const VkExtent3D   &extent,
-                                 VkBufferImageCopy  &region)
-{
-    region.bufferOffset      = 0;
-    region.bufferRowLength   = 0;
-    region.bufferImageHeight = 0;
-
-    region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel       = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount     = 1;
-
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = {
-        extent.width,
-        extent.height,
-        extent.depth
-    };
-}
-
 static VkFormat findSupportedFormat(VkPhysicalDevice            physicalDevice,
                                     const std::vector<VkFormat> &candidates, 
                                     VkImageTiling               tiling, 
@@ -70,18 +48,46 @@ Image::Image(const LogicalDevice *device) : Buffer(device)
     resetImageInfo();
 }
 
+Image::Image(Image &&other) noexcept : Image()
+{
+    *this = std::move(other);
+}
+
+Image &Image::operator=(Image &&other) noexcept
+{
+    if(this == &other)
+        return *this;
+
+    // Buffer::operator=    ,    
+    destroy();
+
+    handle    = other.handle;
+    width     = other.width;
+    height    = other.height;
+    mipLevels = other.mipLevels;
+
+    Buffer::operator=(std::move(other));
+
+    other.handle = VK_NULL_HANDLE;
+    other.resetImageInfo();
+
+    return *this;
+}
+
 void Image::resetImageInfo()
 {
-    size     = 0;
-    width    = 0;
-    height   = 0;
+    size      = 0;
+    width     = 0;
+    height    = 0;
+    mipLevels = 1;
 }
 
 
 void Image::createImage(const VkExtent3D         &extent,
                               VkFormat           format,
                               VkImageTiling      tiling,
-                              VkImageUsageFlags  usage)
+                              VkImageUsageFlags  usage,
+                              uint32_t           mipLevels)
 {
     VkImageCreateInfo imageInfo{};
     imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -89,7 +95,7 @@ void Image::createImage(const VkExtent3D         &extent,
     imageInfo.extent.width  = extent.width;
     imageInfo.extent.height = extent.height;
     imageInfo.extent.depth  = extent.depth;
-    imageInfo.mipLevels     = 1;
+    imageInfo.mipLevels     = mipLevels;
     imageInfo.arrayLayers   = 1;
     imageInfo.format        = format;
     imageInfo.tiling        = tiling;
@@ -106,14 +112,16 @@ void Image::create(const VkExtent3D      &extent,
                    VkFormat              format,
                    VkImageTiling         tiling,
                    VkImageUsageFlags     usage,
-                   VkMemoryPropertyFlags properties)
+                   VkMemoryPropertyFlags properties,
+                   uint32_t              mipLevels)
 {
     alive = true;
 
-    width    = extent.width;
-    height   = extent.height;
+    this->width     = extent.width;
+    this->height    = extent.height;
+    this->mipLevels = mipLevels;
 
-    createImage(extent, format, tiling, usage);
+    createImage(extent, format, tiling, usage, mipLevels);
     VkMemoryRequirements memRequirements;
     vkGetImageMemoryRequirements(this->device->handle, this->handle, &memRequirements);
     allocateMemory(memRequirements, properties);
@@ -149,34 +157,11 @@ VkFormat findDepthFormat(VkPhysicalDevice physicalDevice)
 }
 
 
-void copyBufferToImage(CommandPool    &commandPool,
-                       VkExtent3D     &extent,
-                       Buffer         &buffer,
-                       Image          &image)
-{
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands(commandPool);
-
-    VkBufferImageCopy region{};
-    setupImageCopyRegion(extent, region);
-
-    vkCmdCopyBufferToImage(
-        commandBuffer,
-        buffer.handle,
-        image.handle,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        1,
-        &region
-    );
-
-    endSingleTimeCommands(commandPool,
-                          commandBuffer);
-}
-
-
 VkImageView createImageView(VkDevice           logicalDevice,
                             VkImage            image, 
                             VkFormat           format,
-                            VkImageAspectFlags aspectFlags)
+                            VkImageAspectFlags aspectFlags,
+                            uint32_t           levelCount)
 {
     VkImageViewCreateInfo viewInfo{};
     viewInfo.sType    = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -185,7 +170,7 @@ VkImageView createImageView(VkDevice           logicalDevice,
     viewInfo.format   = format;
     viewInfo.subresourceRange.aspectMask     = aspectFlags;
     viewInfo.subresourceRange.baseMipLevel   = 0;
-    viewInfo.subresourceRange.levelCount     = 1;
+    viewInfo.subresourceRange.levelCount     = levelCount;
     viewInfo.subresourceRange.baseArrayLayer = 0;
     viewInfo.subresourceRange.layerCount     = 1;
 
@@ -197,40 +182,6 @@ VkImageView createImageView(VkDevice           logicalDevice,
 }
 
 
-void createDepthResources(CommandPool      &commandPool,
-                          VkExtent2D       &swapChainExtent,
-                          Image            &depthImage,
-                          VkImageView      &depthImageView)
-{
-    VkFormat depthFormat = findDepthFormat(commandPool.device->physicalDevice);
-
-    VkExtent3D depthImageExtent{
-        swapChainExtent.width,
-        swapChainExtent.height,
-        1
-    };
-
-    depthImage.setDevice(commandPool.device);
-    depthImage.create(depthImageExtent,
-                      depthFormat, 
-                      VK_IMAGE_TILING_OPTIMAL, 
-                      VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, 
-                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-
-    depthImageView = createImageView(commandPool.device->handle, 
-                                     depthImage.handle, 
-                                     depthFormat, 
-                                     VK_IMAGE_ASPECT_DEPTH_BIT);
-    
-    transitionImageLayout(commandPool,
-                          depthImage, 
-                          depthFormat, 
-                          VK_IMAGE_LAYOUT_UNDEFINED, 
-                          VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
-}
-
-
 bool hasStencilComponent(VkFormat format)
 {
     return format == VK_FORMAT_D32_SFLOAT_S8_UINT || 
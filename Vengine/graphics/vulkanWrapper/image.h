@@ -12,15 +12,20 @@ struct Image: public Buffer
 
     int                    width;
     int                    height;
+    uint32_t               mipLevels;
 
     Image();
     Image(const LogicalDevice *device);
 
+    Image(Image &&other) noexcept;
+    Image &operator=(Image &&other) noexcept;
+
     void create(const VkExtent3D      &extent,
                 VkFormat              format,
                 VkImageTiling         tiling,
                 VkImageUsageFlags     usage,
-                VkMemoryPropertyFlags properties);
+                VkMemoryPropertyFlags properties,
+                uint32_t              mipLevels = 1);
 
     void destroy();
 
@@ -28,7 +33,8 @@ private:
     void createImage(const VkExtent3D      &extent,
                      VkFormat              format,
                      VkImageTiling         tiling,
-                     VkImageUsageFlags     usage);
+                     VkImageUsageFlags     usage,
+                     uint32_t              mipLevels);
 
     void resetImageInfo();
 };
@@ -36,22 +42,12 @@ private:
 VkFormat findDepthFormat(VkPhysicalDevice physicalDevice);
 
 
-void copyBufferToImage(CommandPool    &commandPool,
-                       VkExtent3D     &extent,
-                       Buffer         &buffer,
-                       Image          &image);
-
-
+//     [0, levelCount)
 VkImageView createImageView(VkDevice           logicalDevice,
                             VkImage            image, 
                             VkFormat           format,
-                            VkImageAspectFlags aspectFlags);
-
-
-void createDepthResources(CommandPool      &commandPool,
-                          VkExtent2D       &swapChainExtent,
-                          Image            &depthImage,
-                          VkImageView      &depthImageView);
+                            VkImageAspectFlags aspectFlags,
+                            uint32_t           levelCount = 1);
 
 
 bool hasStencilComponent(VkFormat format);
\ No newline at end of file
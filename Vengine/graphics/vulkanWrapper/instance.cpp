@@ -56,15 +56,21 @@ bool checkExtensionsSupport(const std::vector<const char *> &requiredExtensions)
 }
 
 /*
-*   ,   glfw   ,   
+*   ,   glfw,   ,   ,   
 */
-std::vector<const char *> getRequiredExtensions(bool enableValidationLayers)
+std::vector<const char *> getRequiredExtensions(bool enableValidationLayers,
+                                                bool withWindow)
 {
-    uint32_t glfwExtensionCount = 0;
-    const char **glfwExtensions;
+    std::vector<const char *> requeredExtensions;
 
-    glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-    std::vector<const char *> requeredExtensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    if(withWindow)
+    {
+        uint32_t glfwExtensionCount = 0;
+        const char **glfwExtensions;
+
+        glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+        requeredExtensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    }
 
     if(enableValidationLayers)
         requeredExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -74,7 +80,8 @@ std::vector<const char *> getRequiredExtensions(bool enableValidationLayers)
 
 #include <iostream>
 VkInstance createInstance(const std::vector<const char *> &validationLayers,
-                          const std::vector<const char *> &instanceExtensions)
+                          const std::vector<const char *> &instanceExtensions,
+                          bool                             withWindow)
 {
     if(enableValidationLayers && !checkValidationLayerSupport(validationLayers))
         throw std::runtime_error("validation layers requested, but not available");
@@ -86,7 +93,8 @@ VkInstance createInstance(const std::vector<const char *> &validationLayers,
     appInfo.pEngineName        = "Vengine";
     appInfo.applicationVersion = VK_MAKE_VERSION(0, 1, 0);
     appInfo.engineVersion      = VK_MAKE_VERSION(0, 1, 0);
-    appInfo.apiVersion         = VK_API_VERSION_1_0;
+    // vkGetPhysicalDeviceFeatures2 ,    VK_EXT_descriptor_indexing
+    appInfo.apiVersion         = VK_API_VERSION_1_1;
 
 
     VkInstanceCreateInfo createInfo{};
@@ -94,7 +102,7 @@ VkInstance createInstance(const std::vector<const char *> &validationLayers,
     createInfo.pApplicationInfo = &appInfo;
 
 
-    auto extensions = getRequiredExtensions(enableValidationLayers);
+    auto extensions = getRequiredExtensions(enableValidationLayers, withWindow);
 
     //      glfw    , 
     //   
@@ -6,5 +6,7 @@
 
 #include "validationLayers.h"
 
+//    ,   glfw,  
 VkInstance createInstance(const std::vector<const char *> &validationLayers,
-                          const std::vector<const char *> &instanceExtensions);
+                          const std::vector<const char *> &instanceExtensions,
+                          bool                             withWindow = true);
@@ -0,0 +1,219 @@
+#include "layoutCache.h"
+
+#include <stdexcept>
+#include <functional>
+
+#include "descriptorSetLayout.h"
+#include "pipelineLayout.h"
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+static void combineHash(size_t &seed, uint64_t value)
+{
+    seed ^= std::hash<uint64_t>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+//     32    uint64_t,   64  - 
+static uint64_t getHandleValue(VkDescriptorSetLayout handle)
+{
+    return (uint64_t)handle;
+}
+
+//   set   ,     vkCreateDescriptorSetLayout
+static void describeSet(const ShaderReflection                    &reflection,
+                        uint32_t                                   set,
+                        uint32_t                                   runtimeArraySize,
+                        std::vector<VkDescriptorSetLayoutBinding> &bindings,
+                        std::vector<VkDescriptorBindingFlagsEXT>  &bindingFlags)
+{
+    bool hasTable = false;
+
+    for(const ShaderBinding &shaderBinding : reflection.bindings)
+    {
+        if(shaderBinding.set != set)
+            continue;
+
+        bool table = shaderBinding.count == 0;
+        if(table && runtimeArraySize == 0)
+            throw std::runtime_error("failed to create descriptor set layout: array without size needs runtimeArraySize!");
+
+        VkDescriptorSetLayoutBinding binding{};
+        setupDescriptorSetLayoutBinding(shaderBinding.binding,
+                                        table ? runtimeArraySize : shaderBinding.count,
+                                        shaderBinding.type,
+                                        shaderBinding.stages,
+                                        binding);
+        bindings.push_back(binding);
+
+        bindingFlags.push_back(table ? VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT   |
+                                       VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+                                       VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT
+                                     : 0);
+        hasTable |= table;
+    }
+
+    //      
+    if(!hasTable)
+        bindingFlags.clear();
+}
+
+static size_t hashSetLayout(const std::vector<VkDescriptorSetLayoutBinding> &bindings,
+                            const std::vector<VkDescriptorBindingFlagsEXT>  &bindingFlags)
+{
+    size_t seed = 0;
+
+    for(const VkDescriptorSetLayoutBinding &binding : bindings)
+    {
+        combineHash(seed, binding.binding);
+        combineHash(seed, binding.descriptorType);
+        combineHash(seed, binding.descriptorCount);
+        combineHash(seed, binding.stageFlags);
+    }
+
+    for(VkDescriptorBindingFlagsEXT flags : bindingFlags)
+        combineHash(seed, flags);
+
+    return seed;
+}
+
+static bool isSameBindings(const std::vector<VkDescriptorSetLayoutBinding> &a,
+                           const std::vector<VkDescriptorSetLayoutBinding> &b)
+{
+    if(a.size() != b.size())
+        return false;
+
+    for(size_t i = 0; i < a.size(); i++)
+        if(a[i].binding         != b[i].binding         ||
+           a[i].descriptorType  != b[i].descriptorType  ||
+           a[i].descriptorCount != b[i].descriptorCount ||
+           a[i].stageFlags      != b[i].stageFlags)
+            return false;
+
+    return true;
+}
+
+static bool isSameRanges(const std::vector<VkPushConstantRange> &a,
+                         const std::vector<VkPushConstantRange> &b)
+{
+    if(a.size() != b.size())
+        return false;
+
+    for(size_t i = 0; i < a.size(); i++)
+        if(a[i].stageFlags != b[i].stageFlags ||
+           a[i].offset     != b[i].offset     ||
+           a[i].size       != b[i].size)
+            return false;
+
+    return true;
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// LAYOUT CACHE BEG //////////////////////////////
+
+LayoutCache::LayoutCache()
+{
+    device = nullptr;
+}
+
+void LayoutCache::create(const LogicalDevice *device)
+{
+    this->device = device;
+}
+
+VkDescriptorSetLayout LayoutCache::getSetLayout(const ShaderReflection &reflection,
+                                                uint32_t                set,
+                                                uint32_t                runtimeArraySize)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<VkDescriptorSetLayoutBinding> bindings;
+    std::vector<VkDescriptorBindingFlagsEXT>  bindingFlags;
+    describeSet(reflection, set, runtimeArraySize, bindings, bindingFlags);
+
+    return findSetLayout(bindings, bindingFlags);
+}
+
+VkPipelineLayout LayoutCache::getPipelineLayout(const ShaderReflection &reflection,
+                                                uint32_t                runtimeArraySize)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint32_t setCount = reflection.bindings.empty() ? 0 : reflection.bindings.back().set + 1;
+
+    std::vector<VkDescriptorSetLayout> layouts;
+    for(uint32_t set = 0; set < setCount; set++)
+    {
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+        std::vector<VkDescriptorBindingFlagsEXT>  bindingFlags;
+        describeSet(reflection, set, runtimeArraySize, bindings, bindingFlags);
+
+        layouts.push_back(findSetLayout(bindings, bindingFlags));
+    }
+
+    std::vector<VkPushConstantRange> ranges;
+    if(reflection.pushConstants.size > 0)
+        ranges.push_back(reflection.pushConstants);
+
+    size_t seed = 0;
+    for(VkDescriptorSetLayout layout : layouts)
+        combineHash(seed, getHandleValue(layout));
+    for(const VkPushConstantRange &range : ranges)
+    {
+        combineHash(seed, range.stageFlags);
+        combineHash(seed, range.offset);
+        combineHash(seed, range.size);
+    }
+
+    std::vector<CachedPipelineLayout> &candidates = pipelineLayouts[seed];
+
+    for(const CachedPipelineLayout &candidate : candidates)
+        if(candidate.setLayouts == layouts && isSameRanges(candidate.pushConstantRanges, ranges))
+            return candidate.layout;
+
+    CachedPipelineLayout cachedLayout{};
+    cachedLayout.setLayouts         = layouts;
+    cachedLayout.pushConstantRanges = ranges;
+    cachedLayout.layout             = createPipelineLayout(device->handle, layouts, ranges);
+
+    candidates.push_back(cachedLayout);
+    return cachedLayout.layout;
+}
+
+void LayoutCache::destroy()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for(auto &candidates : pipelineLayouts)
+        for(const CachedPipelineLayout &cachedLayout : candidates.second)
+            vkDestroyPipelineLayout(device->handle, cachedLayout.layout, nullptr);
+
+    for(auto &candidates : setLayouts)
+        for(const CachedSetLayout &cachedLayout : candidates.second)
+            vkDestroyDescriptorSetLayout(device->handle, cachedLayout.layout, nullptr);
+
+    pipelineLayouts.clear();
+    setLayouts.clear();
+}
+
+
+VkDescriptorSetLayout LayoutCache::findSetLayout(const std::vector<VkDescriptorSetLayoutBinding> &bindings,
+                                                 const std::vector<VkDescriptorBindingFlagsEXT>  &bindingFlags)
+{
+    std::vector<CachedSetLayout> &candidates = setLayouts[hashSetLayout(bindings, bindingFlags)];
+
+    for(const CachedSetLayout &candidate : candidates)
+        if(isSameBindings(candidate.bindings, bindings) && candidate.bindingFlags == bindingFlags)
+            return candidate.layout;
+
+    CachedSetLayout cachedLayout{};
+    cachedLayout.bindings     = bindings;
+    cachedLayout.bindingFlags = bindingFlags;
+    cachedLayout.layout       = createDescriptorSetLayout(device->handle, bindings, bindingFlags);
+
+    candidates.push_back(cachedLayout);
+    return cachedLayout.layout;
+}
+
+///////////////////////// LAYOUT CACHE END //////////////////////////////
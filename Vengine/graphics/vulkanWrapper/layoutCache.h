@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+
+#include "device.h"
+#include "shaderReflection.h"
+
+/*
+*     ,    
+*          ,  
+*         VkDescriptorSetLayout  VkPipelineLayout,
+*       
+*    destroy.      
+*/
+struct LayoutCache
+{
+    LayoutCache();
+
+    void create(const LogicalDevice *device);
+
+    //   set.      - :   runtimeArraySize
+    //    PARTIALLY_BOUND, UPDATE_AFTER_BIND  UPDATE_UNUSED_WHILE_PENDING
+    VkDescriptorSetLayout getSetLayout(const ShaderReflection &reflection,
+                                       uint32_t                set,
+                                       uint32_t                runtimeArraySize = 0);
+
+    //   0     ,     
+    VkPipelineLayout getPipelineLayout(const ShaderReflection &reflection,
+                                       uint32_t                runtimeArraySize = 0);
+
+    void destroy();
+
+private:
+    struct CachedSetLayout
+    {
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+        std::vector<VkDescriptorBindingFlagsEXT>  bindingFlags;
+        VkDescriptorSetLayout                     layout;
+    };
+
+    struct CachedPipelineLayout
+    {
+        std::vector<VkDescriptorSetLayout> setLayouts;
+        std::vector<VkPushConstantRange>   pushConstantRanges;
+        VkPipelineLayout                   layout;
+    };
+
+    const LogicalDevice *device;
+    std::mutex           mutex;
+
+    //           
+    std::unordered_map<size_t, std::vector<CachedSetLayout>>      setLayouts;
+    std::unordered_map<size_t, std::vector<CachedPipelineLayout>> pipelineLayouts;
+
+    VkDescriptorSetLayout findSetLayout(const std::vector<VkDescriptorSetLayoutBinding> &bindings,
+                                        const std::vector<VkDescriptorBindingFlagsEXT>  &bindingFlags);
+};
@@ -34,9 +34,9 @@ static void setupMultipleShaderStages(const ShaderModule          &vertexShader,
 
 ///////////////////////// PIPELINE FIXED FUNCTIONS BEG //////////////////////////////
 
-void PipelineFixedFunctions::setup(const VkExtent2D &swapChainExtent)
+void PipelineFixedFunctions::setup(const VkExtent2D &swapChainExtent, const ShaderReflection &vertexShader)
 {
-    setupVertexInputDescriptions();
+    setupVertexInputDescriptions(vertexShader);
     setupAssemblyStateInfo      ();
     setupViewPortAndScissor     (swapChainExtent);
     setupViewPortStateInfo      ();
@@ -56,16 +56,31 @@ void PipelineFixedFunctions:: setupAssemblyStateInfo()
     inputAssembly.primitiveRestartEnable = VK_FALSE;
 }
 
-void PipelineFixedFunctions:: setupVertexInputDescriptions()
+void PipelineFixedFunctions:: setupVertexInputDescriptions(const ShaderReflection &vertexShader)
 {
-    static auto bindingDescription    = Vertex::getBindingDescription();
-    static auto attributeDescriptions = Vertex::getAttributeDescriptions();
+    //  0 -  ,  1 -  
+    static std::array<VkVertexInputBindingDescription, 2> bindingDescriptions = {
+        Vertex::getBindingDescription(),
+        InstanceData::getBindingDescription()
+    };
+
+    //    ,   ,    .
+    //    ,     - 
+    std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+
+    auto meshAttributes     = Vertex::getAttributeDescriptions();
+    auto instanceAttributes = InstanceData::getAttributeDescriptions();
+
+    attributeDescriptions.insert(attributeDescriptions.end(), meshAttributes.begin(),     meshAttributes.end());
+    attributeDescriptions.insert(attributeDescriptions.end(), instanceAttributes.begin(), instanceAttributes.end());
+
+    vertexAttributes = selectVertexAttributes(vertexShader, attributeDescriptions);
 
     vertexInput.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInput.vertexBindingDescriptionCount   = 1;
-    vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-    vertexInput.pVertexBindingDescriptions      = &bindingDescription;
-    vertexInput.pVertexAttributeDescriptions    = attributeDescriptions.data();
+    vertexInput.vertexBindingDescriptionCount   = static_cast<uint32_t>(bindingDescriptions.size());
+    vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexAttributes.size());
+    vertexInput.pVertexBindingDescriptions      = bindingDescriptions.data();
+    vertexInput.pVertexAttributeDescriptions    = vertexAttributes.data();
 }
 
 void PipelineFixedFunctions:: setupViewPortAndScissor(const VkExtent2D  &swapChainExtent)
@@ -225,7 +240,8 @@ VkPipeline createGraphicsPipeline(const LogicalDevice         &device,
                                   const ShaderModule          &vertexShader,
                                   const ShaderModule          &fragmentShader,
                                   const VkDescriptorSetLayout &descriptorSetLayout,
-                                  const VkPipelineLayout      &pipelineLayout)
+                                  const VkPipelineLayout      &pipelineLayout,
+                                  VkPipelineCache             pipelineCache)
 {
     VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
     VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
@@ -252,11 +268,42 @@ VkPipeline createGraphicsPipeline(const LogicalDevice         &device,
     pipelineInfo.basePipelineHandle  = VK_NULL_HANDLE;
 
     VkPipeline graphicsPipeline;
-    if (vkCreateGraphicsPipelines(device.handle, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(device.handle, pipelineCache, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
         throw std::runtime_error("failed to create graphics pipeline!");
     }
 
     return graphicsPipeline;
 }
 
+VkPipelineCache createPipelineCache(const LogicalDevice &device)
+{
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+    VkPipelineCache pipelineCache;
+    if(vkCreatePipelineCache(device.handle, &cacheInfo, nullptr, &pipelineCache) != VK_SUCCESS)
+        throw std::runtime_error("failed to create pipeline cache!");
+
+    return pipelineCache;
+}
+
+VkPipeline createComputePipeline(const LogicalDevice         &device,
+                                 const ShaderModule          &computeShader,
+                                 const VkPipelineLayout      &pipelineLayout,
+                                 VkPipelineCache             pipelineCache)
+{
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType              = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.layout             = pipelineLayout;
+    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+
+    setupShaderStageInfo(computeShader, pipelineInfo.stage);
+
+    VkPipeline computePipeline;
+    if(vkCreateComputePipelines(device.handle, pipelineCache, 1, &pipelineInfo, nullptr, &computePipeline) != VK_SUCCESS)
+        throw std::runtime_error("failed to create compute pipeline!");
+
+    return computePipeline;
+}
+
 ///////////////////////// PUBLIC END //////////////////////////////
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "vertex.h"
 #include "shaderModule.h"
 #include "device.h"
+#include "shaderReflection.h"
 
 
 struct PipelineFixedFunctions
@@ -24,11 +25,14 @@ struct PipelineFixedFunctions
     VkPipelineColorBlendStateCreateInfo          colorBlending;
     VkPipelineDynamicStateCreateInfo             dynamicState;
 
-    void setup(const VkExtent2D &swapChainExtent);
+    // ,    .    vertexInput
+    std::vector<VkVertexInputAttributeDescription> vertexAttributes;
+
+    void setup(const VkExtent2D &swapChainExtent, const ShaderReflection &vertexShader);
     void setupViewPortAndScissor(const VkExtent2D  &swapChainExtent);
 
 private:
-    void setupVertexInputDescriptions();
+    void setupVertexInputDescriptions(const ShaderReflection &vertexShader);
     void setupAssemblyStateInfo      ();
     void setupViewPortStateInfo      ();
     void setupRasterizerStateInfo    ();
@@ -46,4 +50,12 @@ VkPipeline createGraphicsPipeline(const LogicalDevice         &device,
                                   const ShaderModule          &vertexShader,
                                   const ShaderModule          &fragmentShader,
                                   const VkDescriptorSetLayout &descriptorSetLayout,
-                                  const VkPipelineLayout      &pipelineLayout);
\ No newline at end of file
+                                  const VkPipelineLayout      &pipelineLayout,
+                                  VkPipelineCache             pipelineCache = VK_NULL_HANDLE);
+
+VkPipelineCache createPipelineCache(const LogicalDevice &device);
+
+VkPipeline createComputePipeline(const LogicalDevice         &device,
+                                 const ShaderModule          &computeShader,
+                                 const VkPipelineLayout      &pipelineLayout,
+                                 VkPipelineCache             pipelineCache = VK_NULL_HANDLE);
\ No newline at end of file
@@ -4,22 +4,24 @@
 
 ///////////////////////// PUBLIC BEG //////////////////////////////
 
-void setupPipelineLayoutInfo(const VkDescriptorSetLayout       &descriptorSetLayout,
-                                   VkPipelineLayoutCreateInfo  &pipelineLayoutInfo)
+void setupPipelineLayoutInfo(const std::vector<VkDescriptorSetLayout> &descriptorSetLayouts,
+                             const std::vector<VkPushConstantRange>   &pushConstantRanges,
+                                   VkPipelineLayoutCreateInfo         &pipelineLayoutInfo)
 {
     pipelineLayoutInfo.sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.setLayoutCount = 1;
-    pipelineLayoutInfo.pSetLayouts    = &descriptorSetLayout;
+    pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayouts.size());
+    pipelineLayoutInfo.pSetLayouts    = descriptorSetLayouts.data();
 
-    pipelineLayoutInfo.pushConstantRangeCount = 0;       // Optional
-    pipelineLayoutInfo.pPushConstantRanges    = nullptr; // Optional
+    pipelineLayoutInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size());
+    pipelineLayoutInfo.pPushConstantRanges    = pushConstantRanges.empty() ? nullptr : pushConstantRanges.data();
 }
 
-VkPipelineLayout createPipelineLayout(VkDevice                    logicalDevice,
-                                      const VkDescriptorSetLayout &descriptorSetLayout)
+VkPipelineLayout createPipelineLayout(VkDevice                                 logicalDevice,
+                                      const std::vector<VkDescriptorSetLayout> &descriptorSetLayouts,
+                                      const std::vector<VkPushConstantRange>   &pushConstantRanges)
 {
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-    setupPipelineLayoutInfo(descriptorSetLayout, pipelineLayoutInfo);
+    setupPipelineLayoutInfo(descriptorSetLayouts, pushConstantRanges, pipelineLayoutInfo);
 
     VkPipelineLayout pipelineLayout;
     if(vkCreatePipelineLayout(logicalDevice, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
@@ -2,8 +2,12 @@
 
 #include <vulkan/vulkan.h>
 
-void setupPipelineLayoutInfo(const VkDescriptorSetLayout       &descriptorSetLayout,
-                                   VkPipelineLayoutCreateInfo  &pipelineLayoutInfo);
+#include <vector>
 
-VkPipelineLayout createPipelineLayout(VkDevice                    logicalDevice,
-                                      const VkDescriptorSetLayout &descriptorSetLayout);
\ No newline at end of file
+void setupPipelineLayoutInfo(const std::vector<VkDescriptorSetLayout> &descriptorSetLayouts,
+                             const std::vector<VkPushConstantRange>   &pushConstantRanges,
+                                   VkPipelineLayoutCreateInfo         &pipelineLayoutInfo);
+
+VkPipelineLayout createPipelineLayout(VkDevice                                 logicalDevice,
+                                      const std::vector<VkDescriptorSetLayout> &descriptorSetLayouts,
+                                      const std::vector<VkPushConstantRange>   &pushConstantRanges = {});
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include "readback.h"
+
+#include <stdexcept>
+#include <algorithm>
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+/*
+*      ,     
+*    .     
+*/
+static VkMemoryPropertyFlags chooseReadbackMemory(VkPhysicalDevice physicalDevice)
+{
+    VkMemoryPropertyFlags cached = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT  |
+                                   VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
+                                   VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+    for(uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
+        if((memProperties.memoryTypes[i].propertyFlags & cached) == cached)
+            return cached;
+
+    return VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// READBACK RING BEG //////////////////////////////
+
+ReadbackRing::ReadbackRing()
+{
+    device           = nullptr;
+    commandPool      = nullptr;
+    memoryProperties = 0;
+}
+
+void ReadbackRing::create(CommandPool &commandPool,
+                          uint32_t     slotCount)
+{
+    this->commandPool = &commandPool;
+    device            = commandPool.device;
+    memoryProperties  = chooseReadbackMemory(device->physicalDevice);
+
+    //     ,    
+    slots.resize(std::max(slotCount, 1u));
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    for(Slot &slot : slots)
+        if(vkCreateFence(device->handle, &fenceInfo, nullptr, &slot.fence) != VK_SUCCESS)
+            throw std::runtime_error("failed to create readback fence!");
+}
+
+bool ReadbackRing::hasFreeSlot() const
+{
+    for(const Slot &slot : slots)
+        if(!slot.pending)
+            return true;
+
+    return false;
+}
+
+void ReadbackRing::waitForFreeSlot()
+{
+    if(hasFreeSlot())
+        return;
+
+    std::vector<VkFence> fences;
+    for(const Slot &slot : slots)
+        fences.push_back(slot.fence);
+
+    vkWaitForFences(device->handle, static_cast<uint32_t>(fences.size()), fences.data(), VK_FALSE, UINT64_MAX);
+
+    poll();
+}
+
+bool ReadbackRing::submitCopy(VkQueue           queue,
+                              VkImage           image,
+                              VkImageLayout     layout,
+                              VkFormat          format,
+                              VkExtent2D        extent,
+                              VkSemaphore       signalSemaphore,
+                              ReadbackCallback  callback)
+{
+    auto freeSlot = std::find_if(slots.begin(), slots.end(), [](const Slot &slot) { return !slot.pending; });
+    if(freeSlot == slots.end())
+        return false;
+
+    Slot &slot = *freeSlot;
+
+    VkDeviceSize size = static_cast<VkDeviceSize>(extent.width) * extent.height * 4;
+
+    //      ,     
+    if(slot.buffer.size < size)
+    {
+        slot.buffer.destroy();
+        slot.buffer.setDevice(device);
+        slot.buffer.create(size,
+                           VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                           memoryProperties);
+    }
+
+    slot.image.width    = extent.width;
+    slot.image.height   = extent.height;
+    slot.image.rowPitch = extent.width * 4;
+    slot.image.format   = format;
+    slot.callback       = callback;
+
+    commandPool->allocateCommandBuffers(1, &slot.commandBuffer);
+    recordCopy(slot, image, layout);
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.pCommandBuffers      = &slot.commandBuffer;
+    submitInfo.signalSemaphoreCount = signalSemaphore != VK_NULL_HANDLE ? 1 : 0;
+    submitInfo.pSignalSemaphores    = &signalSemaphore;
+
+    vkResetFences(device->handle, 1, &slot.fence);
+
+    if(vkQueueSubmit(queue, 1, &submitInfo, slot.fence) != VK_SUCCESS)
+        throw std::runtime_error("failed to submit readback command buffer!");
+
+    slot.pending = true;
+
+    return true;
+}
+
+void ReadbackRing::recordCopy(Slot          &slot,
+                              VkImage        image,
+                              VkImageLayout  layout)
+{
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if(vkBeginCommandBuffer(slot.commandBuffer, &beginInfo) != VK_SUCCESS)
+        throw std::runtime_error("failed to begin recording readback command buffer!");
+
+    VkImageMemoryBarrier imageBarrier{};
+    imageBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    imageBarrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.image                           = image;
+    imageBarrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    imageBarrier.subresourceRange.baseMipLevel   = 0;
+    imageBarrier.subresourceRange.levelCount     = 1;
+    imageBarrier.subresourceRange.baseArrayLayer = 0;
+    imageBarrier.subresourceRange.layerCount     = 1;
+
+    //       ,       
+    imageBarrier.oldLayout     = layout;
+    imageBarrier.newLayout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+    vkCmdPipelineBarrier(slot.commandBuffer,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         0, nullptr,
+                         0, nullptr,
+                         1, &imageBarrier);
+
+    VkBufferImageCopy region{};
+    region.bufferOffset                    = 0;
+    //      
+    region.bufferRowLength                 = 0;
+    region.bufferImageHeight               = 0;
+    region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel       = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount     = 1;
+    region.imageOffset                     = {0, 0, 0};
+    region.imageExtent                     = {slot.image.width, slot.image.height, 1};
+
+    vkCmdCopyImageToBuffer(slot.commandBuffer,
+                           image,
+                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           slot.buffer.handle,
+                           1,
+                           &region);
+
+    //          
+    imageBarrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.newLayout     = layout;
+    imageBarrier.srcAccessMask = 0;
+    imageBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+    VkBufferMemoryBarrier bufferBarrier{};
+    bufferBarrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    bufferBarrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufferBarrier.dstAccessMask       = VK_ACCESS_HOST_READ_BIT;
+    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.buffer              = slot.buffer.handle;
+    bufferBarrier.offset              = 0;
+    bufferBarrier.size                = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(slot.commandBuffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+                         0,
+                         0, nullptr,
+                         1, &bufferBarrier,
+                         1, &imageBarrier);
+
+    if(vkEndCommandBuffer(slot.commandBuffer) != VK_SUCCESS)
+        throw std::runtime_error("failed to record readback command buffer!");
+}
+
+void ReadbackRing::deliver(Slot &slot)
+{
+    //     VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+    //           
+    commandPool->freeCommandBuffers(1, &slot.commandBuffer);
+    slot.commandBuffer = VK_NULL_HANDLE;
+
+    slot.image.pixels = slot.buffer.map();
+
+    if(slot.callback)
+        slot.callback(slot.image);
+
+    slot.callback = nullptr;
+    slot.pending  = false;
+}
+
+void ReadbackRing::poll()
+{
+    for(Slot &slot : slots)
+        if(slot.pending && vkGetFenceStatus(device->handle, slot.fence) == VK_SUCCESS)
+            deliver(slot);
+}
+
+void ReadbackRing::flush()
+{
+    for(Slot &slot : slots)
+        if(slot.pending)
+        {
+            vkWaitForFences(device->handle, 1, &slot.fence, VK_TRUE, UINT64_MAX);
+            deliver(slot);
+        }
+}
+
+void ReadbackRing::destroy()
+{
+    if(!device)
+        return;
+
+    flush();
+
+    for(Slot &slot : slots)
+    {
+        slot.buffer.destroy();
+        vkDestroyFence(device->handle, slot.fence, nullptr);
+    }
+
+    slots.clear();
+    device = nullptr;
+}
+
+///////////////////////// READBACK RING END //////////////////////////////
\ No newline at end of file
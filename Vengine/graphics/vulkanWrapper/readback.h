@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <functional>
+#include <vector>
+
+#include "device.h"
+#include "buffer.h"
+#include "commandPool.h"
+
+/*
+* ,    .     rowPitch ,
+*  4       format
+* pixels      
+*/
+struct ReadbackImage
+{
+    const void *pixels;
+    uint32_t    width;
+    uint32_t    height;
+    uint32_t    rowPitch;
+    VkFormat    format;
+};
+
+using ReadbackCallback = std::function<void(const ReadbackImage &)>;
+
+/*
+*           
+*      ,       ,
+*      . poll       ,
+*      .    ,   
+*/
+struct ReadbackRing
+{
+    const LogicalDevice  *device;
+
+    ReadbackRing();
+
+    void create(CommandPool &commandPool,
+                uint32_t     slotCount);
+
+    bool hasFreeSlot() const;
+    //    ,       
+    //  ,    
+    void waitForFreeSlot();
+
+    //  image        queue  ,   
+    // image    layout       . 
+    //        
+    // signalSemaphore   .  false,    
+    bool submitCopy(VkQueue           queue,
+                    VkImage           image,
+                    VkImageLayout     layout,
+                    VkFormat          format,
+                    VkExtent2D        extent,
+                    VkSemaphore       signalSemaphore,
+                    ReadbackCallback  callback);
+
+    //  ,    .  
+    void poll();
+    //       
+    void flush();
+
+    void destroy();
+
+private:
+    struct Slot
+    {
+        Buffer            buffer;
+        VkCommandBuffer   commandBuffer = VK_NULL_HANDLE;
+        VkFence           fence         = VK_NULL_HANDLE;
+        ReadbackCallback  callback;
+        ReadbackImage     image{};
+        bool              pending       = false;
+    };
+
+    CommandPool           *commandPool;
+    VkMemoryPropertyFlags  memoryProperties;
+    std::vector<Slot>      slots;
+
+    void recordCopy(Slot          &slot,
+                    VkImage        image,
+                    VkImageLayout  layout);
+
+    void deliver(Slot &slot);
+};
\ No newline at end of file
@@ -0,0 +1,834 @@
+#include "renderGraph.h"
+
+#include <stdexcept>
+#include <algorithm>
+
+#include "buffer.h"
+#include "image.h"
+#include "frameBuffer.h"
+
+// ,       
+static const VkAccessFlags writeAccessMask = VK_ACCESS_SHADER_WRITE_BIT                   |
+                                             VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT         |
+                                             VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                             VK_ACCESS_TRANSFER_WRITE_BIT;
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+struct UsageInfo
+{
+    VkPipelineStageFlags stage;
+    VkAccessFlags        access;
+    // ,        
+    VkImageLayout        layout;
+    bool                 write;
+    // ,       
+    VkImageUsageFlags    imageUsage;
+};
+
+static UsageInfo getUsageInfo(ResourceUsage usage)
+{
+    switch(usage)
+    {
+        case ResourceUsage::COLOR_ATTACHMENT:
+            return {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                    true,
+                    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT};
+
+        case ResourceUsage::DEPTH_ATTACHMENT:
+            return {VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                    true,
+                    VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT};
+
+        case ResourceUsage::SAMPLED:
+            return {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                    VK_ACCESS_SHADER_READ_BIT,
+                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    false,
+                    VK_IMAGE_USAGE_SAMPLED_BIT};
+
+        case ResourceUsage::STORAGE_READ:
+            return {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    VK_ACCESS_SHADER_READ_BIT,
+                    VK_IMAGE_LAYOUT_GENERAL,
+                    false,
+                    VK_IMAGE_USAGE_STORAGE_BIT};
+
+        case ResourceUsage::STORAGE_WRITE:
+            return {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_GENERAL,
+                    true,
+                    VK_IMAGE_USAGE_STORAGE_BIT};
+
+        case ResourceUsage::FRAGMENT_STORAGE_WRITE:
+            return {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                    VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_GENERAL,
+                    true,
+                    VK_IMAGE_USAGE_STORAGE_BIT};
+
+        case ResourceUsage::TRANSFER_READ:
+            return {VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    VK_ACCESS_TRANSFER_READ_BIT,
+                    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                    false,
+                    VK_IMAGE_USAGE_TRANSFER_SRC_BIT};
+
+        case ResourceUsage::TRANSFER_WRITE:
+            return {VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    VK_ACCESS_TRANSFER_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    true,
+                    VK_IMAGE_USAGE_TRANSFER_DST_BIT};
+
+        case ResourceUsage::INDIRECT_READ:
+            return {VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                    VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+                    VK_IMAGE_LAYOUT_UNDEFINED,
+                    false,
+                    0};
+
+        case ResourceUsage::VERTEX_READ:
+            return {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                    VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT,
+                    VK_IMAGE_LAYOUT_UNDEFINED,
+                    false,
+                    0};
+    }
+
+    throw std::invalid_argument("unknown resource usage!");
+}
+
+static bool isDepthFormat(VkFormat format)
+{
+    return format == VK_FORMAT_D16_UNORM           ||
+           format == VK_FORMAT_X8_D24_UNORM_PACK32 ||
+           format == VK_FORMAT_D32_SFLOAT          ||
+           format == VK_FORMAT_D16_UNORM_S8_UINT   ||
+           format == VK_FORMAT_D24_UNORM_S8_UINT   ||
+           format == VK_FORMAT_D32_SFLOAT_S8_UINT;
+}
+
+static VkImageAspectFlags getBarrierAspectMask(VkFormat format)
+{
+    if(!isDepthFormat(format))
+        return VK_IMAGE_ASPECT_COLOR_BIT;
+
+    //          
+    if(hasStencilComponent(format))
+        return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+
+    return VK_IMAGE_ASPECT_DEPTH_BIT;
+}
+
+static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static bool lifetimesOverlap(int firstA, int lastA, int firstB, int lastB)
+{
+    return firstA <= lastB && firstB <= lastA;
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// RENDER GRAPH BEG //////////////////////////////
+
+RenderGraph::RenderGraph()
+{
+    device = nullptr;
+    stats  = {};
+}
+
+void RenderGraph::create(const LogicalDevice *device)
+{
+    this->device = device;
+}
+
+RenderResource RenderGraph::addResource(const Resource &resource)
+{
+    resources.push_back(resource);
+    return static_cast<RenderResource>(resources.size() - 1);
+}
+
+RenderResource RenderGraph::importImage(const std::string              &name,
+                                        const std::vector<VkImage>     &images,
+                                        const std::vector<VkImageView> &views,
+                                        VkFormat                        format,
+                                        VkExtent2D                      extent,
+                                        VkImageLayout                   initialLayout,
+                                        VkPipelineStageFlags            readyStage,
+                                        VkImageLayout                   finalLayout)
+{
+    Resource resource{};
+    resource.name          = name;
+    resource.image         = true;
+    resource.transient     = false;
+    resource.output        = true;
+    resource.images        = images;
+    resource.views         = views;
+    resource.format        = format;
+    resource.extent        = extent;
+    resource.initialLayout = initialLayout;
+    resource.readyStage    = readyStage;
+    resource.finalLayout   = finalLayout;
+
+    return addResource(resource);
+}
+
+RenderResource RenderGraph::importBuffer(const std::string &name)
+{
+    Resource resource{};
+    resource.name      = name;
+    resource.image     = false;
+    resource.transient = false;
+    resource.output    = false;
+
+    return addResource(resource);
+}
+
+RenderResource RenderGraph::createImage(const std::string &name,
+                                        VkFormat           format,
+                                        VkExtent2D         extent)
+{
+    Resource resource{};
+    resource.name          = name;
+    resource.image         = true;
+    resource.transient     = true;
+    resource.output        = false;
+    resource.format        = format;
+    resource.extent        = extent;
+    resource.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    resource.finalLayout   = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    return addResource(resource);
+}
+
+void RenderGraph::markOutput(RenderResource resource)
+{
+    resources[resource].output = true;
+}
+
+uint32_t RenderGraph::addPass(const std::string  &name,
+                              bool                graphics,
+                              RecordPassCallback  record)
+{
+    Pass pass{};
+    pass.name       = name;
+    pass.graphics   = graphics;
+    pass.record     = record;
+    pass.renderPass = VK_NULL_HANDLE;
+
+    passes.push_back(pass);
+    return static_cast<uint32_t>(passes.size() - 1);
+}
+
+void RenderGraph::use(uint32_t       pass,
+                      RenderResource resource,
+                      ResourceUsage  usage)
+{
+    UsageInfo info = getUsageInfo(usage);
+
+    Access access{};
+    access.resource        = resource;
+    access.stage           = info.stage;
+    access.access          = info.access;
+    access.layout          = resources[resource].image ? info.layout : VK_IMAGE_LAYOUT_UNDEFINED;
+    access.write           = info.write;
+    access.colorAttachment = usage == ResourceUsage::COLOR_ATTACHMENT;
+    access.depthAttachment = usage == ResourceUsage::DEPTH_ATTACHMENT;
+
+    resources[resource].usage |= info.imageUsage;
+
+    //         
+    for(Access &existing : passes[pass].accesses)
+    {
+        if(existing.resource != resource)
+            continue;
+
+        if(existing.layout != access.layout)
+            throw std::invalid_argument("pass " + passes[pass].name + " uses " +
+                                        resources[resource].name + " in two layouts!");
+
+        existing.stage           |= access.stage;
+        existing.access          |= access.access;
+        existing.write           |= access.write;
+        existing.colorAttachment |= access.colorAttachment;
+        existing.depthAttachment |= access.depthAttachment;
+        return;
+    }
+
+    passes[pass].accesses.push_back(access);
+}
+
+void RenderGraph::compile()
+{
+    stats = {};
+
+    cullPasses();
+    findLifetimes();
+    allocateTransientImages();
+    computeBarriers();
+    createRenderPasses();
+}
+
+void RenderGraph::cullPasses()
+{
+    //  ,    ,  -   
+    //    : ,    ,  
+    std::vector<bool> needed(resources.size());
+    for(size_t i = 0; i < resources.size(); i++)
+        needed[i] = resources[i].output;
+
+    for(size_t i = passes.size(); i-- > 0;)
+    {
+        Pass &pass = passes[i];
+
+        pass.culled = true;
+        for(const Access &access : pass.accesses)
+            if(access.write && needed[access.resource])
+                pass.culled = false;
+
+        if(pass.culled)
+        {
+            stats.culledPassCount++;
+            continue;
+        }
+
+        for(const Access &access : pass.accesses)
+            needed[access.resource] = true;
+    }
+
+    stats.passCount = static_cast<uint32_t>(passes.size());
+}
+
+void RenderGraph::findLifetimes()
+{
+    for(Resource &resource : resources)
+    {
+        resource.firstPass = -1;
+        resource.lastPass  = -1;
+    }
+
+    for(size_t i = 0; i < passes.size(); i++)
+    {
+        if(passes[i].culled)
+            continue;
+
+        for(const Access &access : passes[i].accesses)
+        {
+            Resource &resource = resources[access.resource];
+
+            if(resource.firstPass < 0)
+                resource.firstPass = static_cast<int>(i);
+
+            resource.lastPass = static_cast<int>(i);
+        }
+    }
+}
+
+void RenderGraph::allocateTransientImages()
+{
+    std::vector<RenderResource> transient;
+
+    for(RenderResource i = 0; i < resources.size(); i++)
+    {
+        Resource &resource = resources[i];
+        if(!resource.transient || resource.firstPass < 0)
+            continue;
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageInfo.extent        = {resource.extent.width, resource.extent.height, 1};
+        imageInfo.mipLevels     = 1;
+        imageInfo.arrayLayers   = 1;
+        imageInfo.format        = resource.format;
+        imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage         = resource.usage;
+        imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+
+        VkImage image;
+        if(vkCreateImage(device->handle, &imageInfo, nullptr, &image) != VK_SUCCESS)
+            throw std::runtime_error("failed to create render graph image " + resource.name + "!");
+
+        resource.images = {image};
+        vkGetImageMemoryRequirements(device->handle, image, &resource.memoryRequirements);
+
+        stats.unaliasedTransientMemory += resource.memoryRequirements.size;
+        transient.push_back(i);
+    }
+
+    //    ,      
+    std::sort(transient.begin(), transient.end(), [this](RenderResource a, RenderResource b)
+    {
+        return resources[a].memoryRequirements.size > resources[b].memoryRequirements.size;
+    });
+
+    for(RenderResource i : transient)
+    {
+        Resource &resource = resources[i];
+
+        size_t blockIndex = 0;
+        while(blockIndex < memoryBlocks.size() &&
+              memoryBlocks[blockIndex].memoryTypeBits != resource.memoryRequirements.memoryTypeBits)
+            blockIndex++;
+
+        if(blockIndex == memoryBlocks.size())
+            memoryBlocks.push_back({resource.memoryRequirements.memoryTypeBits, 0, VK_NULL_HANDLE, {}});
+
+        MemoryBlock &block = memoryBlocks[blockIndex];
+
+        //  ,       ,
+        //       
+        VkDeviceSize offset = 0;
+        bool         moved  = true;
+        while(moved)
+        {
+            moved = false;
+
+            for(RenderResource other : block.resources)
+            {
+                const Resource &placed = resources[other];
+
+                if(!lifetimesOverlap(resource.firstPass, resource.lastPass, placed.firstPass, placed.lastPass))
+                    continue;
+
+                VkDeviceSize placedEnd = placed.memoryOffset + placed.memoryRequirements.size;
+
+                if(offset < placedEnd && placed.memoryOffset < offset + resource.memoryRequirements.size)
+                {
+                    offset = alignUp(placedEnd, resource.memoryRequirements.alignment);
+                    moved  = true;
+                }
+            }
+        }
+
+        resource.memoryBlock  = static_cast<uint32_t>(blockIndex);
+        resource.memoryOffset = offset;
+
+        block.size = std::max(block.size, offset + resource.memoryRequirements.size);
+        block.resources.push_back(i);
+    }
+
+    for(MemoryBlock &block : memoryBlocks)
+    {
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize  = block.size;
+        allocInfo.memoryTypeIndex = findMemoryType(device->physicalDevice,
+                                                   block.memoryTypeBits,
+                                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        if(vkAllocateMemory(device->handle, &allocInfo, nullptr, &block.memory) != VK_SUCCESS)
+            throw std::runtime_error("failed to allocate render graph memory!");
+
+        stats.transientMemory += block.size;
+
+        for(RenderResource i : block.resources)
+        {
+            Resource &resource = resources[i];
+
+            vkBindImageMemory(device->handle, resource.images[0], block.memory, resource.memoryOffset);
+
+            resource.views = {createImageView(device->handle,
+                                              resource.images[0],
+                                              resource.format,
+                                              isDepthFormat(resource.format) ? VK_IMAGE_ASPECT_DEPTH_BIT
+                                                                             : VK_IMAGE_ASPECT_COLOR_BIT)};
+        }
+    }
+}
+
+void RenderGraph::computeBarriers()
+{
+    //     
+    struct State
+    {
+        VkImageLayout        layout;
+        //  ,     
+        VkPipelineStageFlags writeStages;
+        VkAccessFlags        writeAccess;
+        //    .     
+        VkPipelineStageFlags readStages;
+        //   ,     
+        VkPipelineStageFlags visibleStages;
+        VkAccessFlags        visibleAccess;
+        bool                 touched;
+    };
+
+    std::vector<State> states(resources.size());
+
+    for(size_t i = 0; i < resources.size(); i++)
+    {
+        const Resource &resource = resources[i];
+        State          &state    = states[i];
+
+        state = {};
+        state.layout      = resource.initialLayout;
+        state.writeStages = resource.readyStage;
+
+        if(!resource.transient || resource.firstPass < 0)
+            continue;
+
+        //        
+        //   ,     .     
+        for(RenderResource other : memoryBlocks[resource.memoryBlock].resources)
+            for(const Pass &pass : passes)
+                for(const Access &access : pass.accesses)
+                    if(!pass.culled && access.resource == other)
+                    {
+                        state.writeStages |= access.stage;
+                        state.writeAccess |= access.access & writeAccessMask;
+                    }
+    }
+
+    for(size_t passIndex = 0; passIndex < passes.size(); passIndex++)
+    {
+        Pass &pass = passes[passIndex];
+        if(pass.culled)
+            continue;
+
+        Barrier &barrier = pass.barrier;
+        barrier = Barrier();
+
+        pass.attachmentInfos.clear();
+        pass.attachments.clear();
+        pass.clearValues.clear();
+
+        for(const Access &access : pass.accesses)
+        {
+            const Resource &resource = resources[access.resource];
+            State          &state    = states[access.resource];
+
+            bool firstUse = !state.touched;
+
+            if(resource.image && access.layout != state.layout)
+            {
+                barrier.needed    = true;
+                barrier.srcStage |= state.writeStages | state.readStages;
+                barrier.dstStage |= access.stage;
+                barrier.images.push_back({access.resource, state.layout, access.layout, state.writeAccess, access.access});
+
+                state.layout = access.layout;
+
+                //   -  ,     
+                state.writeStages   = access.stage;
+                state.writeAccess   = access.access & writeAccessMask;
+                state.readStages    = access.write ? 0 : access.stage;
+                state.visibleStages = access.stage;
+                state.visibleAccess = access.access;
+            }
+            else if(access.write)
+            {
+                //         ,
+                //     ,   
+                if(state.writeStages | state.readStages)
+                {
+                    barrier.needed     = true;
+                    barrier.srcStage  |= state.writeStages | state.readStages;
+                    barrier.dstStage  |= access.stage;
+                    barrier.srcAccess |= state.writeAccess;
+                    barrier.dstAccess |= state.writeAccess ? access.access : 0;
+                }
+
+                state.writeStages   = access.stage;
+                state.writeAccess   = access.access & writeAccessMask;
+                state.readStages    = 0;
+                state.visibleStages = access.stage;
+                state.visibleAccess = access.access;
+            }
+            else
+            {
+                //           
+                if(state.writeStages && ((access.stage  & ~state.visibleStages) ||
+                                         (access.access & ~state.visibleAccess)))
+                {
+                    barrier.needed     = true;
+                    barrier.srcStage  |= state.writeStages;
+                    barrier.dstStage  |= access.stage;
+                    barrier.srcAccess |= state.writeAccess;
+                    barrier.dstAccess |= access.access;
+
+                    state.visibleStages |= access.stage;
+                    state.visibleAccess |= access.access;
+                }
+
+                state.readStages |= access.stage;
+            }
+
+            state.touched = true;
+
+            if(!pass.graphics || !(access.colorAttachment || access.depthAttachment))
+                continue;
+
+            //     ,  ,   , 
+            bool hasContent = !firstUse || resource.initialLayout != VK_IMAGE_LAYOUT_UNDEFINED;
+            bool readLater  = resource.output || resource.lastPass != static_cast<int>(passIndex);
+
+            AttachmentInfo info{};
+            info.format      = resource.format;
+            info.loadOp      = hasContent ? VK_ATTACHMENT_LOAD_OP_LOAD   : VK_ATTACHMENT_LOAD_OP_CLEAR;
+            info.storeOp     = readLater  ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            info.layout      = access.layout;
+            info.finalLayout = access.layout;
+            info.depth       = access.depthAttachment;
+
+            //    ,  -   
+            VkClearValue clearValue{};
+            if(info.depth)
+                clearValue.depthStencil = {1.0f, 0};
+            else
+                clearValue.color        = {{0.0f, 0.0f, 0.0f, 1.0f}};
+
+            pass.attachmentInfos.push_back(info);
+            pass.attachments.push_back(access.resource);
+            pass.clearValues.push_back(clearValue);
+            pass.extent = resource.extent;
+        }
+
+        if(barrier.needed)
+        {
+            stats.barrierCount++;
+            stats.imageBarrierCount += static_cast<uint32_t>(barrier.images.size());
+        }
+    }
+
+    //        finalLayout
+    finalBarrier = Barrier();
+
+    for(RenderResource i = 0; i < resources.size(); i++)
+    {
+        const Resource &resource = resources[i];
+        State          &state    = states[i];
+
+        // -     
+        if(!resource.image && resource.output && state.writeStages)
+        {
+            finalBarrier.needed     = true;
+            finalBarrier.srcStage  |= state.writeStages;
+            finalBarrier.dstStage  |= VK_PIPELINE_STAGE_HOST_BIT;
+            finalBarrier.srcAccess |= state.writeAccess;
+            finalBarrier.dstAccess |= VK_ACCESS_HOST_READ_BIT;
+            continue;
+        }
+
+        if(!resource.image || resource.transient ||
+           resource.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED || resource.finalLayout == state.layout)
+            continue;
+
+        //        ,
+        //        
+        if(resource.lastPass >= 0 && passes[resource.lastPass].graphics)
+        {
+            Pass &pass = passes[resource.lastPass];
+
+            auto attachment = std::find(pass.attachments.begin(), pass.attachments.end(), i);
+            if(attachment != pass.attachments.end())
+            {
+                pass.attachmentInfos[attachment - pass.attachments.begin()].finalLayout = resource.finalLayout;
+                continue;
+            }
+        }
+
+        //   -    -     
+        finalBarrier.needed    = true;
+        finalBarrier.srcStage |= state.writeStages | state.readStages;
+        finalBarrier.dstStage |= VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        finalBarrier.images.push_back({i, state.layout, resource.finalLayout, state.writeAccess, 0});
+    }
+
+    if(finalBarrier.needed)
+    {
+        stats.barrierCount++;
+        stats.imageBarrierCount += static_cast<uint32_t>(finalBarrier.images.size());
+    }
+}
+
+void RenderGraph::createRenderPasses()
+{
+    for(Pass &pass : passes)
+    {
+        if(pass.culled || !pass.graphics)
+            continue;
+
+        pass.renderPass = createRenderPass(*device, pass.attachmentInfos);
+
+        //       ,        
+        uint32_t bufferCount = 1;
+        for(RenderResource attachment : pass.attachments)
+            bufferCount = std::max(bufferCount, static_cast<uint32_t>(resources[attachment].views.size()));
+
+        pass.frameBuffers.resize(bufferCount);
+
+        for(uint32_t i = 0; i < bufferCount; i++)
+        {
+            std::vector<VkImageView> views;
+            for(RenderResource attachment : pass.attachments)
+            {
+                const std::vector<VkImageView> &resourceViews = resources[attachment].views;
+                views.push_back(resourceViews.size() == 1 ? resourceViews[0] : resourceViews[i]);
+            }
+
+            pass.frameBuffers[i] = createFrameBuffer(*device,
+                                                     pass.renderPass,
+                                                     {pass.extent.width, pass.extent.height, 1},
+                                                     views);
+        }
+    }
+}
+
+VkImage RenderGraph::getImage(RenderResource resource, uint32_t imageIndex) const
+{
+    const std::vector<VkImage> &images = resources[resource].images;
+    return images.size() == 1 ? images[0] : images[imageIndex];
+}
+
+void RenderGraph::recordBarrier(VkCommandBuffer  commandBuffer,
+                                const Barrier   &barrier,
+                                uint32_t         imageIndex) const
+{
+    if(!barrier.needed)
+        return;
+
+    VkMemoryBarrier memoryBarrier{};
+    memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.srcAccessMask = barrier.srcAccess;
+    memoryBarrier.dstAccessMask = barrier.dstAccess;
+
+    bool hasMemoryBarrier = barrier.srcAccess != 0 || barrier.dstAccess != 0;
+
+    std::vector<VkImageMemoryBarrier> imageBarriers(barrier.images.size());
+
+    for(size_t i = 0; i < barrier.images.size(); i++)
+    {
+        const ImageBarrier &image = barrier.images[i];
+
+        VkImageMemoryBarrier &imageBarrier = imageBarriers[i];
+        imageBarrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        imageBarrier.srcAccessMask       = image.srcAccess;
+        imageBarrier.dstAccessMask       = image.dstAccess;
+        imageBarrier.oldLayout           = image.oldLayout;
+        imageBarrier.newLayout           = image.newLayout;
+        imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image               = getImage(image.resource, imageIndex);
+
+        imageBarrier.subresourceRange.aspectMask     = getBarrierAspectMask(resources[image.resource].format);
+        imageBarrier.subresourceRange.baseMipLevel   = 0;
+        imageBarrier.subresourceRange.levelCount     = 1;
+        imageBarrier.subresourceRange.baseArrayLayer = 0;
+        imageBarrier.subresourceRange.layerCount     = 1;
+    }
+
+    //      .   -   
+    vkCmdPipelineBarrier(commandBuffer,
+                         barrier.srcStage ? barrier.srcStage : static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT),
+                         barrier.dstStage,
+                         0,
+                         hasMemoryBarrier ? 1 : 0, &memoryBarrier,
+                         0, nullptr,
+                         static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+}
+
+void RenderGraph::execute(VkCommandBuffer  commandBuffer,
+                          uint32_t         imageIndex,
+                          GpuProfiler     *profiler) const
+{
+    for(const Pass &pass : passes)
+    {
+        if(pass.culled)
+            continue;
+
+        if(profiler)
+            profiler->beginScope(commandBuffer, imageIndex, pass.name);
+
+        recordBarrier(commandBuffer, pass.barrier, imageIndex);
+
+        if(pass.graphics)
+        {
+            VkRenderPassBeginInfo renderPassInfo{};
+            renderPassInfo.sType       = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            renderPassInfo.renderPass  = pass.renderPass;
+            renderPassInfo.framebuffer = pass.frameBuffers.size() == 1 ? pass.frameBuffers[0]
+                                                                       : pass.frameBuffers[imageIndex];
+
+            //         
+            renderPassInfo.renderArea.offset = {0, 0};
+            renderPassInfo.renderArea.extent = pass.extent;
+
+            //      ,      
+            renderPassInfo.clearValueCount = static_cast<uint32_t>(pass.clearValues.size());
+            renderPassInfo.pClearValues    = pass.clearValues.data();
+
+            vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        }
+
+        pass.record(commandBuffer, imageIndex);
+
+        if(pass.graphics)
+            vkCmdEndRenderPass(commandBuffer);
+
+        if(profiler)
+            profiler->endScope(commandBuffer, imageIndex);
+    }
+
+    recordBarrier(commandBuffer, finalBarrier, imageIndex);
+}
+
+VkRenderPass RenderGraph::getRenderPass(uint32_t pass) const
+{
+    return passes[pass].renderPass;
+}
+
+RenderGraphStats RenderGraph::getStats() const
+{
+    return stats;
+}
+
+void RenderGraph::destroy()
+{
+    if(device)
+    {
+        for(Pass &pass : passes)
+        {
+            for(VkFramebuffer frameBuffer : pass.frameBuffers)
+                vkDestroyFramebuffer(device->handle, frameBuffer, nullptr);
+
+            if(pass.renderPass)
+                vkDestroyRenderPass(device->handle, pass.renderPass, nullptr);
+        }
+
+        for(Resource &resource : resources)
+        {
+            if(!resource.transient)
+                continue;
+
+            for(VkImageView view : resource.views)
+                vkDestroyImageView(device->handle, view, nullptr);
+
+            for(VkImage image : resource.images)
+                vkDestroyImage(device->handle, image, nullptr);
+        }
+
+        for(MemoryBlock &block : memoryBlocks)
+            vkFreeMemory(device->handle, block.memory, nullptr);
+    }
+
+    resources.clear();
+    passes.clear();
+    memoryBlocks.clear();
+    finalBarrier = Barrier();
+    stats        = {};
+}
+
+///////////////////////// RENDER GRAPH END //////////////////////////////
\ No newline at end of file
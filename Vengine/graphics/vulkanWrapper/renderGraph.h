@@ -0,0 +1,218 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "device.h"
+#include "gpuProfiler.h"
+#include "renderPass.h"
+
+//     
+typedef uint32_t RenderResource;
+
+//    .     ,     
+enum class ResourceUsage
+{
+    COLOR_ATTACHMENT,       //    
+    DEPTH_ATTACHMENT,       //  ,   
+    SAMPLED,                //    
+    STORAGE_READ,           //    
+    STORAGE_WRITE,          //      
+    FRAGMENT_STORAGE_WRITE, //      
+    TRANSFER_READ,          //  
+    TRANSFER_WRITE,         //    
+    INDIRECT_READ,          //      
+    VERTEX_READ             //    
+};
+
+//   . imageIndex -   ,    
+typedef std::function<void(VkCommandBuffer commandBuffer, uint32_t imageIndex)> RecordPassCallback;
+
+struct RenderGraphStats
+{
+    uint32_t     passCount;
+    uint32_t     culledPassCount;
+    //  vkCmdPipelineBarrier       
+    uint32_t     barrierCount;
+    uint32_t     imageBarrierCount;
+    //        
+    VkDeviceSize transientMemory;
+    VkDeviceSize unaliasedTransientMemory;
+};
+
+/*
+*  
+*        ,     
+* compile   :
+*  -  ,            
+*  -   . ,    ,
+*          
+*  -           vkCmdPipelineBarrier
+*  -         .  ,
+*           ,  ,   -  
+*     ,      
+*  destroy    ,     
+*/
+struct RenderGraph
+{
+    const LogicalDevice *device;
+
+    RenderGraph();
+
+    void create(const LogicalDevice *device);
+
+    // images  views -             
+    // readyStage - ,        ,
+    //      
+    //       finalLayout
+    RenderResource importImage(const std::string              &name,
+                               const std::vector<VkImage>     &images,
+                               const std::vector<VkImageView> &views,
+                               VkFormat                        format,
+                               VkExtent2D                      extent,
+                               VkImageLayout                   initialLayout,
+                               VkPipelineStageFlags            readyStage,
+                               VkImageLayout                   finalLayout);
+
+    RenderResource importBuffer(const std::string &name);
+
+    // ,     .   compile,
+    //     
+    RenderResource createImage(const std::string &name,
+                               VkFormat           format,
+                               VkExtent2D         extent);
+
+    //      .   -  
+    //   -      
+    void markOutput(RenderResource resource);
+
+    // graphics -  ,   -   COLOR_ATTACHMENT  DEPTH_ATTACHMENT
+    uint32_t addPass(const std::string  &name,
+                     bool                graphics,
+                     RecordPassCallback  record);
+
+    void use(uint32_t       pass,
+             RenderResource resource,
+             ResourceUsage  usage);
+
+    void compile();
+
+    //        .  
+    //       
+    void execute(VkCommandBuffer  commandBuffer,
+                 uint32_t         imageIndex,
+                 GpuProfiler     *profiler = nullptr) const;
+
+    //    . VK_NULL_HANDLE,   
+    VkRenderPass getRenderPass(uint32_t pass) const;
+
+    RenderGraphStats getStats() const;
+
+    void destroy();
+
+private:
+    struct Resource
+    {
+        std::string              name;
+        bool                     image;
+        bool                     transient;
+        bool                     output;
+
+        std::vector<VkImage>     images;
+        std::vector<VkImageView> views;
+        VkFormat                 format;
+        VkExtent2D               extent;
+        VkImageLayout            initialLayout;
+        VkPipelineStageFlags     readyStage;
+        VkImageLayout            finalLayout;
+
+        // ,      . -1,  
+        int                      firstPass;
+        int                      lastPass;
+
+        //  
+        VkImageUsageFlags        usage;
+        VkMemoryRequirements     memoryRequirements;
+        uint32_t                 memoryBlock;
+        VkDeviceSize             memoryOffset;
+    };
+
+    struct Access
+    {
+        RenderResource       resource;
+        VkPipelineStageFlags stage;
+        VkAccessFlags        access;
+        VkImageLayout        layout;
+        bool                 write;
+        bool                 colorAttachment;
+        bool                 depthAttachment;
+    };
+
+    struct ImageBarrier
+    {
+        RenderResource resource;
+        VkImageLayout  oldLayout;
+        VkImageLayout  newLayout;
+        VkAccessFlags  srcAccess;
+        VkAccessFlags  dstAccess;
+    };
+
+    //      
+    struct Barrier
+    {
+        bool                      needed    = false;
+        VkPipelineStageFlags      srcStage  = 0;
+        VkPipelineStageFlags      dstStage  = 0;
+        VkAccessFlags             srcAccess = 0;
+        VkAccessFlags             dstAccess = 0;
+        std::vector<ImageBarrier> images;
+    };
+
+    struct Pass
+    {
+        std::string                 name;
+        bool                        graphics;
+        RecordPassCallback          record;
+        std::vector<Access>         accesses;
+
+        bool                        culled;
+        Barrier                     barrier;
+
+        std::vector<AttachmentInfo> attachmentInfos;
+        std::vector<RenderResource> attachments;
+        std::vector<VkClearValue>   clearValues;
+        VkExtent2D                  extent;
+        VkRenderPass                renderPass;
+        std::vector<VkFramebuffer>  frameBuffers;
+    };
+
+    //          
+    struct MemoryBlock
+    {
+        uint32_t                    memoryTypeBits;
+        VkDeviceSize                size;
+        VkDeviceMemory              memory;
+        std::vector<RenderResource> resources;
+    };
+
+    std::vector<Resource>    resources;
+    std::vector<Pass>        passes;
+    std::vector<MemoryBlock> memoryBlocks;
+    //   finalLayout   
+    Barrier                  finalBarrier;
+    RenderGraphStats         stats;
+
+    RenderResource addResource(const Resource &resource);
+
+    void cullPasses();
+    void findLifetimes();
+    void allocateTransientImages();
+    void computeBarriers();
+    void createRenderPasses();
+
+    VkImage getImage(RenderResource resource, uint32_t imageIndex) const;
+    void    recordBarrier(VkCommandBuffer commandBuffer, const Barrier &barrier, uint32_t imageIndex) const;
+};
\ No newline at end of file
@@ -2,28 +2,28 @@
 
 #include <stdexcept>
 
-#include "image.h"
-
 ///////////////////////// STATIC BEG //////////////////////////////
 
-static void fillColorAttachmentDescription(VkAttachmentDescription &colorAttachment)
+static void fillAttachmentDescription(const AttachmentInfo    &info,
+                                      VkAttachmentDescription &attachment)
 {
-    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    attachment.format  = info.format;
+    attachment.samples = VK_SAMPLE_COUNT_1_BIT;
 
     //       
     // VK_ATTACHMENT_LOAD_OP_CLEAR -    .     
     // VK_ATTACHMENT_LOAD_OP_LOAD  -   
     // VK_ATTACHMENT_LOAD_OP_DONT_CARE -   
-    colorAttachment.loadOp  = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    attachment.loadOp  = info.loadOp;
 
     //    
     // VK_ATTACHMENT_STORE_OP_STORE -     .   
     // VK_ATTACHMENT_STORE_OP_DONT_CARE -         
-    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    attachment.storeOp = info.storeOp;
 
     //     - .     .     
-    colorAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    attachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 
     //          .
     // ..                ,
@@ -31,52 +31,17 @@ static void fillColorAttachmentDescription(VkAttachmentDescription &colorAttachm
     // initialLayout -       
     // finalLayout -          
     // VK_IMAGE_LAYOUT_PRESENT_SRC_KHR -        swap chain
-    //               swap chain
     // VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL -     
-    // VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL -      
+    // VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL -     
     //           
-    // VK_IMAGE_LAYOUT_UNDEFINED -         
-    //             
-    //            
-    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout   = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-}
-
-static void fillDepthAttachmentDescription(VkAttachmentDescription &depthAttachment)
-{
-    depthAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
-    depthAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    depthAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    depthAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    depthAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
-    depthAttachment.finalLayout    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-}
-
-static void fillSubpassDependencies(VkSubpassDependency &dependency)
-{
-    //       
-    // VK_SUBPASS_EXTERNAL         
-    //  render pass        srcSubpass  dstSubpass
-    dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-
-    //   .          0
-    dependency.dstSubpass = 0;
-    //dstSubpass      srcSubpass      
-
-    //                 
-    dependency.srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | 
-                               VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-
-    dependency.dstStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | 
-                               VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-
-    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT          | 
-                               VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    //            ,
+    //        ,    
+    attachment.initialLayout = info.layout;
+    attachment.finalLayout   = info.finalLayout;
 }
 
 static void setupAttachmentRef(uint32_t              attachmentIndex,
-                               VkImageLayout         layout, 
+                               VkImageLayout         layout,
                                VkAttachmentReference &attachmentRef)
 {
     attachmentRef.attachment = attachmentIndex; //  attachment    
@@ -85,9 +50,9 @@ static void setupAttachmentRef(uint32_t              attachmentIndex,
     attachmentRef.layout     = layout;
 }
 
-static void setupSubpassDescription(const VkAttachmentReference &colorAttachmentRef,
-                                    const VkAttachmentReference &depthAttachmentRef,
-                                          VkSubpassDescription        &subpass)
+static void setupSubpassDescription(const std::vector<VkAttachmentReference> &colorAttachmentRefs,
+                                    const VkAttachmentReference              *depthAttachmentRef,
+                                          VkSubpassDescription               &subpass)
 {
     //    
     // VK_PIPELINE_BIND_POINT_GRAPHICS -     
@@ -95,9 +60,9 @@ static void setupSubpassDescription(const VkAttachmentReference &colorAttachment
     subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
     //  attachment'             
     // layout(location = 0) out vec4 outColor
-    subpass.colorAttachmentCount    = 1;
-    subpass.pColorAttachments       = &colorAttachmentRef;
-    subpass.pDepthStencilAttachment = &depthAttachmentRef;
+    subpass.colorAttachmentCount    = static_cast<uint32_t>(colorAttachmentRefs.size());
+    subpass.pColorAttachments       = colorAttachmentRefs.data();
+    subpass.pDepthStencilAttachment = depthAttachmentRef;
 }
 
 ///////////////////////// STATIC END //////////////////////////////
@@ -105,50 +70,52 @@ static void setupSubpassDescription(const VkAttachmentReference &colorAttachment
 
 ///////////////////////// PUBLIC BEG //////////////////////////////
 
-VkRenderPass createRenderPass(const LogicalDevice &device,
-                                    VkFormat       swapChainImageFormat)
+VkRenderPass createRenderPass(const LogicalDevice               &device,
+                              const std::vector<AttachmentInfo> &attachments)
 {
-    VkAttachmentDescription colorAttachment{};
-    VkAttachmentDescription depthAttachment{};
-
-    fillColorAttachmentDescription(colorAttachment);
-    fillDepthAttachmentDescription(depthAttachment);
-
-    colorAttachment.format = swapChainImageFormat;
-    depthAttachment.format = findDepthFormat(device.physicalDevice);
-    
     //        :
     // pInputAttachments:        
     // pResolveAttachments :     
     // pDepthStencilAttachment :        
-    // pPreserveAttachments :        , 
+    // pPreserveAttachments :        ,
     //        
-    std::array<VkAttachmentDescription, 2> attachments = {colorAttachment, depthAttachment};
-
+    std::vector<VkAttachmentDescription> descriptions(attachments.size());
+
+    std::vector<VkAttachmentReference> colorAttachmentRefs;
+    VkAttachmentReference              depthAttachmentRef{};
+    bool                               hasDepth = false;
+
+    for(size_t i = 0; i < attachments.size(); i++)
+    {
+        fillAttachmentDescription(attachments[i], descriptions[i]);
+
+        VkAttachmentReference attachmentRef{};
+        setupAttachmentRef(static_cast<uint32_t>(i), attachments[i].layout, attachmentRef);
+
+        if(!attachments[i].depth)
+            colorAttachmentRefs.push_back(attachmentRef);
+        else if(!hasDepth)
+        {
+            depthAttachmentRef = attachmentRef;
+            hasDepth           = true;
+        }
+        else
+            throw std::invalid_argument("render pass can have only one depth attachment!");
+    }
 
-    VkAttachmentReference colorAttachmentRef{};
-    VkAttachmentReference depthAttachmentRef{};
-
-    setupAttachmentRef(0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,         colorAttachmentRef);
-    setupAttachmentRef(1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, depthAttachmentRef);
-
-    
     VkSubpassDescription subpass{};
-    setupSubpassDescription(colorAttachmentRef, depthAttachmentRef, subpass);
-    
-
-    VkSubpassDependency dependency{};
-    fillSubpassDependencies(dependency);
-
+    setupSubpassDescription(colorAttachmentRefs, hasDepth ? &depthAttachmentRef : nullptr, subpass);
 
+    //    .      ,
+    //         
     VkRenderPassCreateInfo renderPassInfo{};
     renderPassInfo.sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
-    renderPassInfo.pAttachments    = attachments.data();
+    renderPassInfo.attachmentCount = static_cast<uint32_t>(descriptions.size());
+    renderPassInfo.pAttachments    = descriptions.data();
     renderPassInfo.subpassCount    = 1;
     renderPassInfo.pSubpasses      = &subpass;
-    renderPassInfo.dependencyCount = 1;
-    renderPassInfo.pDependencies   = &dependency;
+    renderPassInfo.dependencyCount = 0;
+    renderPassInfo.pDependencies   = nullptr;
 
 
     VkRenderPass renderPass;
@@ -2,7 +2,27 @@
 
 #include "vulkan/vulkan.h"
 
+#include <vector>
+
 #include "device.h"
 
-VkRenderPass createRenderPass(const LogicalDevice &device,
-                                    VkFormat       swapChainImageFormat);
\ No newline at end of file
+/*
+*   
+*        layout,   
+*   . finalLayout   layout,    
+*            
+*/
+struct AttachmentInfo
+{
+    VkFormat            format;
+    VkAttachmentLoadOp  loadOp;
+    VkAttachmentStoreOp storeOp;
+    VkImageLayout       layout;
+    VkImageLayout       finalLayout;
+    bool                depth;
+};
+
+//    .      attachments,
+//      
+VkRenderPass createRenderPass(const LogicalDevice               &device,
+                              const std::vector<AttachmentInfo> &attachments);
\ No newline at end of file
@@ -0,0 +1,520 @@
+#include "shaderReflection.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+static const uint32_t spirvMagic = 0x07230203;
+
+// ,     SPIR-V,     
+enum SpirvOp
+{
+    OP_TYPE_INT            = 21,
+    OP_TYPE_FLOAT          = 22,
+    OP_TYPE_VECTOR         = 23,
+    OP_TYPE_MATRIX         = 24,
+    OP_TYPE_IMAGE          = 25,
+    OP_TYPE_SAMPLER        = 26,
+    OP_TYPE_SAMPLED_IMAGE  = 27,
+    OP_TYPE_ARRAY          = 28,
+    OP_TYPE_RUNTIME_ARRAY  = 29,
+    OP_TYPE_STRUCT         = 30,
+    OP_TYPE_POINTER        = 32,
+    OP_CONSTANT            = 43,
+    OP_SPEC_CONSTANT       = 50,
+    OP_VARIABLE            = 59,
+    OP_DECORATE            = 71,
+    OP_MEMBER_DECORATE     = 72
+};
+
+enum SpirvDecoration
+{
+    DECORATION_BUFFER_BLOCK   = 3,
+    DECORATION_ARRAY_STRIDE   = 6,
+    DECORATION_MATRIX_STRIDE  = 7,
+    DECORATION_BUILT_IN       = 11,
+    DECORATION_LOCATION       = 30,
+    DECORATION_BINDING        = 33,
+    DECORATION_DESCRIPTOR_SET = 34,
+    DECORATION_OFFSET         = 35
+};
+
+enum SpirvStorageClass
+{
+    STORAGE_UNIFORM_CONSTANT = 0,
+    STORAGE_INPUT            = 1,
+    STORAGE_UNIFORM          = 2,
+    STORAGE_PUSH_CONSTANT    = 9,
+    STORAGE_STORAGE_BUFFER   = 12
+};
+
+enum SpirvImageDim
+{
+    DIM_BUFFER        = 5,
+    DIM_SUBPASS_DATA  = 6
+};
+
+// ,     id 
+struct SpirvId
+{
+    // ,     ,     id
+    uint32_t              op = 0;
+    std::vector<uint32_t> operands;
+
+    bool                  hasBinding  = false;
+    bool                  hasLocation = false;
+    bool                  builtIn     = false;
+    bool                  bufferBlock = false;
+    uint32_t              set         = 0;
+    uint32_t              binding     = 0;
+    uint32_t              location    = 0;
+    uint32_t              arrayStride = 0;
+
+    //      
+    std::vector<uint32_t> memberOffsets;
+    std::vector<uint32_t> memberMatrixStrides;
+};
+
+struct SpirvVariable
+{
+    uint32_t id;
+    uint32_t pointerType;
+    uint32_t storageClass;
+};
+
+static void setMemberDecoration(std::vector<uint32_t> &values, uint32_t member, uint32_t value)
+{
+    if(member >= values.size())
+        values.resize(member + 1, 0);
+
+    values[member] = value;
+}
+
+static const SpirvId &getId(const std::vector<SpirvId> &ids, uint32_t id)
+{
+    if(id >= ids.size())
+        throw std::runtime_error("failed to reflect shader: id is out of bounds!");
+
+    return ids[id];
+}
+
+//  ,    
+static uint32_t getConstant(const std::vector<SpirvId> &ids, uint32_t id)
+{
+    const SpirvId &constant = getId(ids, id);
+    if((constant.op != OP_CONSTANT && constant.op != OP_SPEC_CONSTANT) || constant.operands.empty())
+        throw std::runtime_error("failed to reflect shader: array length is not a constant!");
+
+    return constant.operands[0];
+}
+
+//     push constant
+static uint32_t getTypeSize(const std::vector<SpirvId> &ids, uint32_t typeId, uint32_t matrixStride = 0)
+{
+    const SpirvId &type = getId(ids, typeId);
+
+    switch(type.op)
+    {
+    case OP_TYPE_INT:
+    case OP_TYPE_FLOAT:
+        return type.operands[0] / 8;
+
+    case OP_TYPE_VECTOR:
+        return type.operands[1] * getTypeSize(ids, type.operands[0]);
+
+    case OP_TYPE_MATRIX:
+        return type.operands[1] * (matrixStride ? matrixStride : getTypeSize(ids, type.operands[0]));
+
+    case OP_TYPE_ARRAY:
+    {
+        uint32_t stride = type.arrayStride ? type.arrayStride : getTypeSize(ids, type.operands[0]);
+        return getConstant(ids, type.operands[1]) * stride;
+    }
+
+    case OP_TYPE_STRUCT:
+    {
+        uint32_t size = 0;
+        for(uint32_t member = 0; member < type.operands.size(); member++)
+        {
+            uint32_t offset = member < type.memberOffsets.size()       ? type.memberOffsets[member]       : 0;
+            uint32_t stride = member < type.memberMatrixStrides.size() ? type.memberMatrixStrides[member] : 0;
+
+            size = std::max(size, offset + getTypeSize(ids, type.operands[member], stride));
+        }
+        return size;
+    }
+
+    default:
+        throw std::runtime_error("failed to reflect shader: unsupported push constant member type!");
+    }
+}
+
+static VkDescriptorType getDescriptorType(const std::vector<SpirvId> &ids, uint32_t typeId, uint32_t storageClass)
+{
+    const SpirvId &type = getId(ids, typeId);
+
+    switch(type.op)
+    {
+    case OP_TYPE_SAMPLER:
+        return VK_DESCRIPTOR_TYPE_SAMPLER;
+
+    case OP_TYPE_SAMPLED_IMAGE:
+        if(getId(ids, type.operands[0]).operands[1] == DIM_BUFFER)
+            return VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+        return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+
+    case OP_TYPE_IMAGE:
+    {
+        // :  , , depth, arrayed, ms, sampled, 
+        // sampled = 2 -      
+        uint32_t dim     = type.operands[1];
+        bool     storage = type.operands[5] == 2;
+
+        if(dim == DIM_BUFFER)
+            return storage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+        if(dim == DIM_SUBPASS_DATA)
+            return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+        return storage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    }
+
+    case OP_TYPE_STRUCT:
+        //  SPIR-V 1.3      Uniform   BufferBlock
+        if(storageClass == STORAGE_STORAGE_BUFFER || type.bufferBlock)
+            return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+
+    default:
+        throw std::runtime_error("failed to reflect shader: unsupported descriptor type!");
+    }
+}
+
+//          32- 
+static VkFormat getInputFormat(const std::vector<SpirvId> &ids, uint32_t typeId)
+{
+    static const VkFormat floatFormats[] = {VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT,
+                                            VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT};
+    static const VkFormat intFormats[]   = {VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT,
+                                            VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT};
+    static const VkFormat uintFormats[]  = {VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT,
+                                            VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT};
+
+    const SpirvId *type       = &getId(ids, typeId);
+    uint32_t       components = 1;
+
+    if(type->op == OP_TYPE_VECTOR)
+    {
+        components = type->operands[1];
+        type       = &getId(ids, type->operands[0]);
+    }
+
+    if(components < 1 || components > 4 || type->operands.empty() || type->operands[0] != 32)
+        throw std::runtime_error("failed to reflect shader: unsupported vertex input type!");
+
+    if(type->op == OP_TYPE_FLOAT)
+        return floatFormats[components - 1];
+
+    if(type->op == OP_TYPE_INT)
+        return type->operands[1] ? intFormats[components - 1] : uintFormats[components - 1];
+
+    throw std::runtime_error("failed to reflect shader: unsupported vertex input type!");
+}
+
+static void addInputs(const std::vector<SpirvId> &ids, uint32_t typeId, uint32_t location, ShaderReflection &reflection)
+{
+    const SpirvId &type = getId(ids, typeId);
+
+    if(type.op == OP_TYPE_ARRAY)
+    {
+        uint32_t length = getConstant(ids, type.operands[1]);
+        uint32_t step   = getId(ids, type.operands[0]).op == OP_TYPE_MATRIX
+                              ? getId(ids, type.operands[0]).operands[1]
+                              : 1;
+
+        for(uint32_t element = 0; element < length; element++)
+            addInputs(ids, type.operands[0], location + element * step, reflection);
+        return;
+    }
+
+    //      location
+    if(type.op == OP_TYPE_MATRIX)
+    {
+        for(uint32_t column = 0; column < type.operands[1]; column++)
+            reflection.inputs.push_back(ShaderInput{location + column, getInputFormat(ids, type.operands[0])});
+        return;
+    }
+
+    reflection.inputs.push_back(ShaderInput{location, getInputFormat(ids, typeId)});
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+///////////////////////// PUBLIC BEG //////////////////////////////
+
+ShaderReflection reflectShader(const std::vector<char>  &binaryCode,
+                               VkShaderStageFlagBits     stage)
+{
+    // : magic, , , bound, 0
+    const size_t headerWords = 5;
+
+    if(binaryCode.size() % sizeof(uint32_t) != 0 || binaryCode.size() < headerWords * sizeof(uint32_t))
+        throw std::runtime_error("failed to reflect shader: not a SPIR-V binary!");
+
+    std::vector<uint32_t> words(binaryCode.size() / sizeof(uint32_t));
+    std::memcpy(words.data(), binaryCode.data(), binaryCode.size());
+
+    if(words[0] != spirvMagic)
+        throw std::runtime_error("failed to reflect shader: not a SPIR-V binary!");
+
+    std::vector<SpirvId>       ids(words[3]);
+    std::vector<SpirvVariable> variables;
+
+    for(size_t position = headerWords; position < words.size();)
+    {
+        uint32_t op        = words[position] & 0xFFFF;
+        uint32_t wordCount = words[position] >> 16;
+
+        if(wordCount == 0 || position + wordCount > words.size())
+            throw std::runtime_error("failed to reflect shader: broken instruction!");
+
+        const uint32_t *operands = &words[position + 1];
+        uint32_t        count    = wordCount - 1;
+
+        switch(op)
+        {
+        case OP_DECORATE:
+        {
+            if(count < 2 || operands[0] >= ids.size())
+                break;
+
+            SpirvId &target = ids[operands[0]];
+            uint32_t value  = count > 2 ? operands[2] : 0;
+
+            switch(operands[1])
+            {
+            case DECORATION_DESCRIPTOR_SET: target.set = value;                                 break;
+            case DECORATION_BINDING:        target.binding = value;  target.hasBinding = true;  break;
+            case DECORATION_LOCATION:       target.location = value; target.hasLocation = true; break;
+            case DECORATION_BUILT_IN:       target.builtIn = true;                              break;
+            case DECORATION_BUFFER_BLOCK:   target.bufferBlock = true;                          break;
+            case DECORATION_ARRAY_STRIDE:   target.arrayStride = value;                         break;
+            }
+            break;
+        }
+
+        case OP_MEMBER_DECORATE:
+        {
+            if(count < 4 || operands[0] >= ids.size())
+                break;
+
+            SpirvId &target = ids[operands[0]];
+            if(operands[2] == DECORATION_OFFSET)
+                setMemberDecoration(target.memberOffsets, operands[1], operands[3]);
+            else if(operands[2] == DECORATION_MATRIX_STRIDE)
+                setMemberDecoration(target.memberMatrixStrides, operands[1], operands[3]);
+            break;
+        }
+
+        case OP_TYPE_INT:
+        case OP_TYPE_FLOAT:
+        case OP_TYPE_VECTOR:
+        case OP_TYPE_MATRIX:
+        case OP_TYPE_IMAGE:
+        case OP_TYPE_SAMPLER:
+        case OP_TYPE_SAMPLED_IMAGE:
+        case OP_TYPE_ARRAY:
+        case OP_TYPE_RUNTIME_ARRAY:
+        case OP_TYPE_STRUCT:
+        case OP_TYPE_POINTER:
+            if(count >= 1 && operands[0] < ids.size())
+            {
+                ids[operands[0]].op = op;
+                ids[operands[0]].operands.assign(operands + 1, operands + count);
+            }
+            break;
+
+        //     ,  id
+        case OP_CONSTANT:
+        case OP_SPEC_CONSTANT:
+            if(count >= 3 && operands[1] < ids.size())
+            {
+                ids[operands[1]].op = op;
+                ids[operands[1]].operands.assign(operands + 2, operands + count);
+            }
+            break;
+
+        case OP_VARIABLE:
+            if(count >= 3)
+                variables.push_back(SpirvVariable{operands[1], operands[0], operands[2]});
+            break;
+        }
+
+        position += wordCount;
+    }
+
+    ShaderReflection reflection;
+    reflection.stages = stage;
+
+    for(const SpirvVariable &variable : variables)
+    {
+        const SpirvId &id      = getId(ids, variable.id);
+        const SpirvId &pointer = getId(ids, variable.pointerType);
+
+        if(pointer.op != OP_TYPE_POINTER || pointer.operands.size() < 2)
+            throw std::runtime_error("failed to reflect shader: variable type is not a pointer!");
+
+        uint32_t typeId = pointer.operands[1];
+
+        switch(variable.storageClass)
+        {
+        case STORAGE_UNIFORM_CONSTANT:
+        case STORAGE_UNIFORM:
+        case STORAGE_STORAGE_BUFFER:
+        {
+            if(!id.hasBinding)
+                break;
+
+            //  :    
+            uint32_t descriptorCount = 1;
+            while(getId(ids, typeId).op == OP_TYPE_ARRAY || getId(ids, typeId).op == OP_TYPE_RUNTIME_ARRAY)
+            {
+                const SpirvId &array = getId(ids, typeId);
+
+                descriptorCount *= array.op == OP_TYPE_ARRAY ? getConstant(ids, array.operands[1]) : 0;
+                typeId           = array.operands[0];
+            }
+
+            reflection.bindings.push_back(ShaderBinding{id.set,
+                                                        id.binding,
+                                                        getDescriptorType(ids, typeId, variable.storageClass),
+                                                        descriptorCount,
+                                                        static_cast<VkShaderStageFlags>(stage)});
+            break;
+        }
+
+        case STORAGE_PUSH_CONSTANT:
+        {
+            const SpirvId &block = getId(ids, typeId);
+            if(block.op != OP_TYPE_STRUCT)
+                throw std::runtime_error("failed to reflect shader: push constant block is not a struct!");
+
+            uint32_t offset = block.memberOffsets.empty()
+                                  ? 0
+                                  : *std::min_element(block.memberOffsets.begin(), block.memberOffsets.end());
+
+            reflection.pushConstants.stageFlags = stage;
+            reflection.pushConstants.offset     = offset;
+            reflection.pushConstants.size       = getTypeSize(ids, typeId) - offset;
+            break;
+        }
+
+        case STORAGE_INPUT:
+            //    gl_VertexIndex   
+            if(stage == VK_SHADER_STAGE_VERTEX_BIT && id.hasLocation && !id.builtIn)
+                addInputs(ids, typeId, id.location, reflection);
+            break;
+        }
+    }
+
+    std::sort(reflection.bindings.begin(), reflection.bindings.end(),
+              [](const ShaderBinding &a, const ShaderBinding &b)
+              {
+                  return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+              });
+
+    std::sort(reflection.inputs.begin(), reflection.inputs.end(),
+              [](const ShaderInput &a, const ShaderInput &b)
+              {
+                  return a.location < b.location;
+              });
+
+    return reflection;
+}
+
+ShaderReflection mergeReflections(const std::vector<ShaderReflection> &stages)
+{
+    ShaderReflection merged;
+
+    for(const ShaderReflection &stage : stages)
+    {
+        merged.stages |= stage.stages;
+
+        for(const ShaderBinding &binding : stage.bindings)
+        {
+            auto same = std::find_if(merged.bindings.begin(), merged.bindings.end(),
+                                     [&binding](const ShaderBinding &other)
+                                     {
+                                         return other.set == binding.set && other.binding == binding.binding;
+                                     });
+
+            if(same == merged.bindings.end())
+            {
+                merged.bindings.push_back(binding);
+                continue;
+            }
+
+            if(same->type != binding.type || same->count != binding.count)
+                throw std::runtime_error("failed to merge shader stages: descriptor binding is declared differently!");
+
+            same->stages |= binding.stages;
+        }
+
+        //    ,      push constant
+        if(stage.pushConstants.size > 0)
+        {
+            VkPushConstantRange &range = merged.pushConstants;
+
+            if(range.size == 0)
+                range = stage.pushConstants;
+            else
+            {
+                uint32_t end = std::max(range.offset + range.size, stage.pushConstants.offset + stage.pushConstants.size);
+
+                range.offset      = std::min(range.offset, stage.pushConstants.offset);
+                range.size        = end - range.offset;
+                range.stageFlags |= stage.pushConstants.stageFlags;
+            }
+        }
+
+        if(stage.stages & VK_SHADER_STAGE_VERTEX_BIT)
+            merged.inputs = stage.inputs;
+    }
+
+    std::sort(merged.bindings.begin(), merged.bindings.end(),
+              [](const ShaderBinding &a, const ShaderBinding &b)
+              {
+                  return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+              });
+
+    return merged;
+}
+
+std::vector<VkVertexInputAttributeDescription> selectVertexAttributes(const ShaderReflection                               &vertexShader,
+                                                                      const std::vector<VkVertexInputAttributeDescription> &attributes)
+{
+    std::vector<VkVertexInputAttributeDescription> selected;
+
+    for(const ShaderInput &input : vertexShader.inputs)
+    {
+        auto attribute = std::find_if(attributes.begin(), attributes.end(),
+                                      [&input](const VkVertexInputAttributeDescription &description)
+                                      {
+                                          return description.location == input.location;
+                                      });
+
+        if(attribute == attributes.end())
+            throw std::runtime_error("failed to find vertex attribute for vertex shader input!");
+
+        //     C++,    
+        if(attribute->format != input.format)
+            throw std::runtime_error("vertex shader input does not match vertex attribute format!");
+
+        selected.push_back(*attribute);
+    }
+
+    return selected;
+}
+
+///////////////////////// PUBLIC END //////////////////////////////
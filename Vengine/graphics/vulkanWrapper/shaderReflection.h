@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+
+//   ,   
+struct ShaderBinding
+{
+    uint32_t            set;
+    uint32_t            binding;
+    VkDescriptorType    type;
+    // 0 -   ,    
+    uint32_t            count;
+    VkShaderStageFlags  stages;
+};
+
+//   .       
+struct ShaderInput
+{
+    uint32_t  location;
+    VkFormat  format;
+};
+
+/*
+*  ,    SPIR-V:   ,
+*  push constant    
+*    ,    : , , ,
+* , ,   
+*/
+struct ShaderReflection
+{
+    VkShaderStageFlags          stages = 0;
+    //      
+    std::vector<ShaderBinding>  bindings;
+    // size = 0 -    push constant
+    VkPushConstantRange         pushConstants{};
+    //   location
+    std::vector<ShaderInput>    inputs;
+};
+
+ShaderReflection reflectShader(const std::vector<char>  &binaryCode,
+                               VkShaderStageFlagBits     stage);
+
+//      .    push constant
+// ,  ,    -, - 
+ShaderReflection mergeReflections(const std::vector<ShaderReflection> &stages);
+
+//      . attributes -  ,
+//    ,       
+std::vector<VkVertexInputAttributeDescription> selectVertexAttributes(const ShaderReflection                               &vertexShader,
+                                                                      const std::vector<VkVertexInputAttributeDescription> &attributes);
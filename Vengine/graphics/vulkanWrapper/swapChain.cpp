@@ -18,11 +18,12 @@ static VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFor
     return availableFormats[0];
 }
 
-static VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes)
+static VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes,
+                                              VkPresentModeKHR                     preferredPresentMode)
 {
     for(auto &availablePresentMode : availablePresentModes)
     {
-        if(availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
+        if(availablePresentMode == preferredPresentMode)
             return availablePresentMode;
     }
 
@@ -71,10 +72,15 @@ static void setupSharingMode(VkPhysicalDevice          physicalDevice,
     }
 }
 
-static uint32_t getMinImageCount(SwapChainSupportDetails &swapChainSupport)
+static uint32_t getMinImageCount(SwapChainSupportDetails &swapChainSupport,
+                                 uint32_t                 preferredImageCount)
 {
     uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
 
+    // 0       
+    if(preferredImageCount != 0)
+        imageCount = std::max(preferredImageCount, swapChainSupport.capabilities.minImageCount);
+
     //maxImageCount          
     if(swapChainSupport.capabilities.maxImageCount > 0  &&
        imageCount > swapChainSupport.capabilities.maxImageCount)
@@ -90,6 +96,16 @@ static uint32_t getMinImageCount(SwapChainSupportDetails &swapChainSupport)
 
 ///////////////////////// SWAP CHAIN BEG //////////////////////////////
 
+Swapchain::Swapchain()
+{
+    device      = VK_NULL_HANDLE;
+    handle      = VK_NULL_HANDLE;
+    imageFormat = VkFormat{};
+    extent      = VkExtent2D{};
+    presentMode = VK_PRESENT_MODE_FIFO_KHR;
+    imageUsage  = 0;
+}
+
 void Swapchain::createImageViews()
 {
     imageViews.resize(images.size());
@@ -104,44 +120,20 @@ void Swapchain::createImageViews()
 }
 
 
-void Swapchain::createFrameBuffers(VkRenderPass         renderPass,
-                                   VkImageView          depthImageView)
-{
-    frameBuffers.resize(imageViews.size());
-
-    VkExtent3D frameBufferExtent {
-        extent.width,
-        extent.height,
-        1
-    };
-
-    for(size_t i = 0; i < imageViews.size(); i++)
-    {
-        //  .            
-        // swap chain       
-        std::array<VkImageView, 2> attachments = {
-            imageViews[i],
-            depthImageView
-        };
-
-        frameBuffers[i] = createFrameBuffer(*device,
-                                            renderPass,
-                                            frameBufferExtent,
-                                            attachments);
-    }
-}
-
-void Swapchain::create(LogicalDevice  &device,
-                       VkSurfaceKHR    surface,
-                       VkExtent2D     &requiredExtent)
+void Swapchain::create(LogicalDevice     &device,
+                       VkSurfaceKHR       surface,
+                       VkExtent2D        &requiredExtent,
+                       VkPresentModeKHR   preferredPresentMode,
+                       uint32_t           preferredImageCount)
 {
     this->device = &device;
 
     SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device.physicalDevice, surface);
     VkSurfaceFormatKHR      surfaceFormat    = chooseSwapSurfaceFormat(swapChainSupport.formats);
-    VkPresentModeKHR        presentMode      = chooseSwapPresentMode(swapChainSupport.presentModes);
     VkExtent2D              actualExtent     = chooseSwapExtent(requiredExtent, swapChainSupport.capabilities);
-    uint32_t                imageCount       = getMinImageCount(swapChainSupport);
+    uint32_t                imageCount       = getMinImageCount(swapChainSupport, preferredImageCount);
+
+    presentMode = chooseSwapPresentMode(swapChainSupport.presentModes, preferredPresentMode);
     
     imageFormat = surfaceFormat.format;
     extent      = actualExtent;
@@ -159,6 +151,12 @@ void Swapchain::create(LogicalDevice  &device,
     //          
     createInfo.imageUsage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 
+    //       ,      
+    if(swapChainSupport.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+        createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+    imageUsage = createInfo.imageUsage;
+
     setupSharingMode(device.physicalDevice, surface, createInfo);
 
     createInfo.preTransform   = swapChainSupport.capabilities.currentTransform;
@@ -180,19 +178,96 @@ void Swapchain::create(LogicalDevice  &device,
     createImageViews();
 }
 
-void Swapchain::destroy()
+void Swapchain::createOffscreen(LogicalDevice &device,
+                                VkExtent2D     extent,
+                                uint32_t       imageCount)
 {
-    for(auto framebuffer : frameBuffers)
-        vkDestroyFramebuffer(device->handle, framebuffer, nullptr);
+    this->device = &device;
+
+    //      ,      
+    imageFormat = VK_FORMAT_R8G8B8A8_SRGB;
+    this->extent = extent;
+
+    VkExtent3D imageExtent {
+        extent.width,
+        extent.height,
+        1
+    };
 
+    imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+    //   ,      
+    offscreenImages.clear();
+    for(uint32_t i = 0; i < imageCount; i++)
+        offscreenImages.emplace_back(&device);
+    images.resize(imageCount);
+
+    for(uint32_t i = 0; i < imageCount; i++)
+    {
+        //    ,     
+        offscreenImages[i].create(imageExtent,
+                                  imageFormat,
+                                  VK_IMAGE_TILING_OPTIMAL,
+                                  imageUsage,
+                                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        images[i] = offscreenImages[i].handle;
+    }
+
+    createImageViews();
+}
+
+bool Swapchain::isCreated() const
+{
+    return !images.empty();
+}
+
+void Swapchain::destroy()
+{
     for(auto imageView : imageViews)
         vkDestroyImageView(device->handle, imageView, nullptr);
     
-    vkDestroySwapchainKHR(device->handle, handle, nullptr);
+    if(handle)
+        vkDestroySwapchainKHR(device->handle, handle, nullptr);
+
+    for(Image &image : offscreenImages)
+        image.destroy();
 
+    handle      = VK_NULL_HANDLE;
     imageFormat = VkFormat{};
     extent      = VkExtent2D{};
     images.clear();
+    imageViews.clear();
+    offscreenImages.clear();
+}
+
+///////////////////////// SWAP SHAIN END //////////////////////////////
+
+
+///////////////////////// PUBLIC BEG //////////////////////////////
+
+std::vector<VkPresentModeKHR> getSupportedPresentModes(const LogicalDevice &device,
+                                                       VkSurfaceKHR         surface)
+{
+    return querySwapChainSupport(device.physicalDevice, surface).presentModes;
+}
+
+VkSurfaceCapabilitiesKHR getSurfaceCapabilities(const LogicalDevice &device,
+                                                VkSurfaceKHR         surface)
+{
+    return querySwapChainSupport(device.physicalDevice, surface).capabilities;
+}
+
+const char *presentModeToString(VkPresentModeKHR presentMode)
+{
+    switch(presentMode)
+    {
+        case VK_PRESENT_MODE_IMMEDIATE_KHR:    return "IMMEDIATE";
+        case VK_PRESENT_MODE_MAILBOX_KHR:      return "MAILBOX";
+        case VK_PRESENT_MODE_FIFO_KHR:         return "FIFO";
+        case VK_PRESENT_MODE_FIFO_RELAXED_KHR: return "FIFO_RELAXED";
+        default:                               return "UNKNOWN";
+    }
 }
 
-///////////////////////// SWAP SHAIN END //////////////////////////////
\ No newline at end of file
+///////////////////////// PUBLIC END //////////////////////////////
\ No newline at end of file
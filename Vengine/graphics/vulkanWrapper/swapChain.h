@@ -17,22 +17,48 @@ public:
     VkSwapchainKHR              handle;
     std::vector<VkImage>        images;
     std::vector<VkImageView>    imageViews;
-    std::vector<VkFramebuffer>  frameBuffers;
     VkFormat                    imageFormat;
     VkExtent2D                  extent;
+    VkPresentModeKHR            presentMode;
+    //  VK_IMAGE_USAGE_TRANSFER_SRC_BIT ,      
+    VkImageUsageFlags           imageUsage;
 
-    void create(LogicalDevice  &device,
-                VkSurfaceKHR    surface,
-                VkExtent2D     &requiredExtent);
+    // ,     .     handle,
+    //  images  imageViews    
+    std::vector<Image>          offscreenImages;
+
+    Swapchain();
+
+    void create(LogicalDevice     &device,
+                VkSurfaceKHR       surface,
+                VkExtent2D        &requiredExtent,
+                VkPresentModeKHR   preferredPresentMode,
+                uint32_t           preferredImageCount);
+
+    //   imageCount        
+    void createOffscreen(LogicalDevice &device,
+                         VkExtent2D     extent,
+                         uint32_t       imageCount);
+
+    bool isCreated() const;
 
     void destroy();
-    
-    void createFrameBuffers(VkRenderPass  renderPass,
-                            VkImageView   depthImageView);
+
 private:
     void createImageViews();
 };
 
 
+std::vector<VkPresentModeKHR> getSupportedPresentModes(const LogicalDevice &device,
+                                                       VkSurfaceKHR         surface);
+
+
+VkSurfaceCapabilitiesKHR getSurfaceCapabilities(const LogicalDevice &device,
+                                                VkSurfaceKHR         surface);
+
+
+const char *presentModeToString(VkPresentModeKHR presentMode);
+
+
 
 
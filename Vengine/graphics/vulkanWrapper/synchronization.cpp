@@ -6,16 +6,16 @@
 ///////////////////////// PUBLIC BEG //////////////////////////////
 
 void createSyncObjects(const LogicalDevice        &device,
-                       int                        MAX_FRAMES_IN_FLIGHT,
+                       uint32_t                   framesInFlight,
                        const Swapchain            &swapChain,
                        std::vector<VkSemaphore>   &imageAvailableSemaphores,
                        std::vector<VkSemaphore>   &renderFinishedSemaphores,
                        std::vector<VkFence>       &inFlightFences,
                        std::vector<VkFence>       &imagesInFlight)
 {
-    imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-    renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-    inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+    imageAvailableSemaphores.resize(framesInFlight);
+    renderFinishedSemaphores.resize(framesInFlight);
+    inFlightFences.resize(framesInFlight);
     imagesInFlight.resize(swapChain.images.size(), VK_NULL_HANDLE);
 
     //    Vulkan API       
@@ -28,7 +28,7 @@ void createSyncObjects(const LogicalDevice        &device,
     //            
     fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-    for(size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    for(size_t i = 0; i < framesInFlight; i++)
     {
         if(vkCreateSemaphore(device.handle, &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) != VK_SUCCESS ||
            vkCreateSemaphore(device.handle, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS ||
@@ -39,6 +39,26 @@ void createSyncObjects(const LogicalDevice        &device,
     }
 }
 
+void destroySyncObjects(const LogicalDevice        &device,
+                        std::vector<VkSemaphore>   &imageAvailableSemaphores,
+                        std::vector<VkSemaphore>   &renderFinishedSemaphores,
+                        std::vector<VkFence>       &inFlightFences,
+                        std::vector<VkFence>       &imagesInFlight)
+{
+    for(size_t i = 0; i < inFlightFences.size(); i++)
+    {
+        vkDestroySemaphore(device.handle, renderFinishedSemaphores[i], nullptr);
+        vkDestroySemaphore(device.handle, imageAvailableSemaphores[i], nullptr);
+        vkDestroyFence    (device.handle, inFlightFences[i],           nullptr);
+    }
+
+    imageAvailableSemaphores.clear();
+    renderFinishedSemaphores.clear();
+    inFlightFences.clear();
+    // imagesInFlight      inFlightFences,     
+    imagesInFlight.clear();
+}
+
 ///////////////////////// PUBLIC END //////////////////////////////
 
 
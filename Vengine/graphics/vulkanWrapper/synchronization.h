@@ -4,9 +4,16 @@
 #include "swapChain.h"
 
 void createSyncObjects(const LogicalDevice        &device,
-                       int                        MAX_FRAMES_IN_FLIGHT,
+                       uint32_t                   framesInFlight,
                        const Swapchain            &swapChain,
                        std::vector<VkSemaphore>   &imageAvailableSemaphores,
                        std::vector<VkSemaphore>   &renderFinishedSemaphores,
                        std::vector<VkFence>       &inFlightFences,
                        std::vector<VkFence>       &imagesInFlight);
+
+
+void destroySyncObjects(const LogicalDevice        &device,
+                        std::vector<VkSemaphore>   &imageAvailableSemaphores,
+                        std::vector<VkSemaphore>   &renderFinishedSemaphores,
+                        std::vector<VkFence>       &inFlightFences,
+                        std::vector<VkFence>       &imagesInFlight);
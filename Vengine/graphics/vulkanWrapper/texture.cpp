@@ -1,6 +1,7 @@
 #include "texture.h"
 
 #include <stdexcept>
+#include <algorithm>
 
 ///////////////////////// STATIC BEG //////////////////////////////
 
@@ -30,7 +31,9 @@ static void setupSamplerCreateInfo(const LogicalDevice        &device,
     samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
     samplerInfo.mipLodBias = 0.0f;
     samplerInfo.minLod     = 0.0f;
-    samplerInfo.maxLod     = 0.0f;
+    //     ,   ,
+    //         
+    samplerInfo.maxLod     = VK_LOD_CLAMP_NONE;
 }
 
 ///////////////////////// STATIC BEG //////////////////////////////
@@ -40,45 +43,105 @@ static void setupSamplerCreateInfo(const LogicalDevice        &device,
 void createTextureImage(void               *pixels,
                         int                 textureChannels,
                         VkExtent3D         &textureExtent,
-                        CommandPool        &commandPool,
+                        UploadBatch        &upload,
                         Image              &textureImage)
 {
-    textureImage.size = textureExtent.width * textureExtent.height * textureChannels;
+    createTextureImage({TextureLevelData{pixels, textureExtent}},
+                       textureChannels,
+                       upload,
+                       textureImage);
+}
 
-    Buffer stagingBuffer(commandPool.device);
-    
-    createStagingBuffer(textureImage.size, stagingBuffer);
+void createTextureImage(const std::vector<TextureLevelData> &levels,
+                        int                                  textureChannels,
+                        UploadBatch                         &upload,
+                        Image                               &textureImage)
+{
+    Image noSource;
+    createTextureImage(levels, noSource, 0, textureChannels, upload, textureImage);
+}
 
-    stagingBuffer.mapMemory(textureImage.size, 
-                            pixels);
-    
-    textureImage.setDevice(commandPool.device);
-    textureImage.create(textureExtent,
-                        VK_FORMAT_R8G8B8A8_SRGB,
-                        VK_IMAGE_TILING_OPTIMAL,
-                        VK_IMAGE_USAGE_TRANSFER_DST_BIT |
-                        VK_IMAGE_USAGE_SAMPLED_BIT,
-                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+void createTextureImage(const std::vector<TextureLevelData> &levels,
+                        Image                               &sourceImage,
+                        uint32_t                             sourceFirstLevel,
+                        int                                  textureChannels,
+                        UploadBatch                         &upload,
+                        Image                               &textureImage)
+{
+    //     
+    uint32_t sourceLevelCount = 0;
+    if(sourceImage.handle != VK_NULL_HANDLE && sourceFirstLevel < sourceImage.mipLevels)
+        sourceLevelCount = sourceImage.mipLevels - sourceFirstLevel;
 
+    if(levels.empty() && sourceLevelCount == 0)
+        throw std::invalid_argument("failed to create texture image without levels!");
 
-    transitionImageLayout(commandPool,
-                          textureImage,
-                          VK_FORMAT_R8G8B8A8_SRGB,
-                          VK_IMAGE_LAYOUT_UNDEFINED,
-                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    //   .     ,    1x1
+    std::vector<VkExtent3D> extents;
+    for(const TextureLevelData &level : levels)
+        extents.push_back(level.extent);
 
+    for(uint32_t level = sourceFirstLevel; level < sourceFirstLevel + sourceLevelCount; level++)
+        extents.push_back({std::max(static_cast<uint32_t>(sourceImage.width)  >> level, 1u),
+                           std::max(static_cast<uint32_t>(sourceImage.height) >> level, 1u),
+                           1});
 
-    copyBufferToImage(commandPool,
-                      textureExtent,
-                      stagingBuffer,
-                      textureImage);
+    VkDeviceSize imageSize = 0;
+    for(const VkExtent3D &extent : extents)
+        imageSize += extent.width * extent.height * textureChannels;
 
+    textureImage.size = imageSize;
 
-    transitionImageLayout(commandPool,
-                          textureImage,
-                          VK_FORMAT_R8G8B8A8_SRGB,
-                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    // TRANSFER_SRC ,         
+    textureImage.setDevice(upload.device);
+    textureImage.create(extents[0],
+                        VK_FORMAT_R8G8B8A8_SRGB,
+                        VK_IMAGE_TILING_OPTIMAL,
+                        VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                        VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                        VK_IMAGE_USAGE_SAMPLED_BIT,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                        static_cast<uint32_t>(extents.size()));
+
+
+    upload.transitionImageLayout(textureImage,
+                                 VK_FORMAT_R8G8B8A8_SRGB,
+                                 VK_IMAGE_LAYOUT_UNDEFINED,
+                                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+
+    for(uint32_t level = 0; level < levels.size(); level++)
+        upload.copyToImage(levels[level].pixels,
+                           levels[level].extent.width * levels[level].extent.height * textureChannels,
+                           levels[level].extent,
+                           textureImage,
+                           level);
+
+    if(sourceLevelCount > 0)
+    {
+        //    ,   ,   
+        //      
+        upload.transitionImageLayout(sourceImage,
+                                     VK_FORMAT_R8G8B8A8_SRGB,
+                                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+        for(uint32_t level = 0; level < sourceLevelCount; level++)
+        {
+            uint32_t dstLevel = static_cast<uint32_t>(levels.size()) + level;
+            upload.copyImage(sourceImage, sourceFirstLevel + level, textureImage, dstLevel, extents[dstLevel]);
+        }
+
+        upload.transitionImageLayout(sourceImage,
+                                     VK_FORMAT_R8G8B8A8_SRGB,
+                                     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    }
+
+    upload.transitionImageLayout(textureImage,
+                                 VK_FORMAT_R8G8B8A8_SRGB,
+                                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 }
 
 
@@ -89,7 +152,8 @@ void createTextureImageView(const LogicalDevice  &device,
     textureImageView = createImageView(device.handle, 
                                        textureImage.handle, 
                                        VK_FORMAT_R8G8B8A8_SRGB, 
-                                       VK_IMAGE_ASPECT_COLOR_BIT);
+                                       VK_IMAGE_ASPECT_COLOR_BIT,
+                                       textureImage.mipLevels);
 }
 
 void createTextureSampler(const LogicalDevice    &device,
@@ -1,21 +1,50 @@
 #pragma once
 
 #include "image.h"
-#include "transitionImageLayout.h"
+#include "uploadBatch.h"
+
+#include <vector>
 
 #include "texture.h"
 
+//     ,    
+struct TextureLevelData
+{
+    const void *pixels;
+    VkExtent3D  extent;
+};
+
 static void setupSamplerCreateInfo(const LogicalDevice        &device,
                                    VkSamplerCreateInfo  &samplerInfo);
 
 
+//        upload
+//       upload.submit
 void createTextureImage(void               *pixels,
                         int                 textureChannels,
                         VkExtent3D         &textureExtent,
-                        CommandPool        &commandPool,
+                        UploadBatch        &upload,
                         Image              &textureImage);
 
-
+//     . levels[0]   0 ,
+//      
+void createTextureImage(const std::vector<TextureLevelData> &levels,
+                        int                                  textureChannels,
+                        UploadBatch                         &upload,
+                        Image                               &textureImage);
+
+// ,     levels   sourceImage  sourceFirstLevel  
+//    ,         . sourceImage
+//   VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,       upload
+void createTextureImage(const std::vector<TextureLevelData> &levels,
+                        Image                               &sourceImage,
+                        uint32_t                             sourceFirstLevel,
+                        int                                  textureChannels,
+                        UploadBatch                         &upload,
+                        Image                               &textureImage);
+
+
+//      
 void createTextureImageView(const LogicalDevice  &device,
                             Image          &textureImage,
                             VkImageView    &textureImageView);
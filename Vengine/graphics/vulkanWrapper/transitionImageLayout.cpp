@@ -2,135 +2,118 @@
 
 #include <stdexcept>
 
-enum class TransitionType
+///////////////////////// STATIC BEG //////////////////////////////
+
+//   ,       layout
+//       ,   ,
+//   - ,    
+struct LayoutAccess
 {
-    WRITE_OPTIMAL         = 0,
-    SHADER_READ_OPTIMAL   = 1,
-    DEPTH_STENCIL_OPTIMAL = 2
+    VkPipelineStageFlags stage;
+    VkAccessFlags        access;
 };
 
-///////////////////////// STATIC BEG //////////////////////////////
-
-static TransitionType getTransitionType(VkImageLayout  oldLayout,
-                                        VkImageLayout  newLayout)
+static LayoutAccess getLayoutAccess(VkImageLayout layout)
 {
-    if(oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && 
-       newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+    switch(layout)
     {
-        return TransitionType::WRITE_OPTIMAL;
-    }
-    else if(oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && 
-            newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-    {
-        return TransitionType::SHADER_READ_OPTIMAL;
-    }
-    else if(oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && 
-            newLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
-    {
-        return TransitionType::DEPTH_STENCIL_OPTIMAL;
-    } else
-         throw std::invalid_argument("unsupported layout transition!");
-}
+        //    ,  
+        case VK_IMAGE_LAYOUT_UNDEFINED:
+            return {VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0};
 
-static void setupImageMemoryBarrier(VkImageLayout          oldLayout,
-                                    VkImageLayout          newLayout,
-                                    VkImage                image,
-                                    VkImageMemoryBarrier  &barrier)
-{
-    barrier.sType     = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = oldLayout;
-    barrier.newLayout = newLayout;
+        case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+            return {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT};
 
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+            return {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT};
 
-    barrier.image = image;
-    barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel   = 0;
-    barrier.subresourceRange.levelCount     = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount     = 1;
-
-    barrier.srcAccessMask = 0;
-    barrier.dstAccessMask = 0;
-}
+        case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+            return {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    VK_ACCESS_SHADER_READ_BIT};
 
-///////////////////////// STATIC END //////////////////////////////
-
-///////////////////////// IMAGE TRANSITION INFO BEG //////////////////////////////
+        case VK_IMAGE_LAYOUT_GENERAL:
+            return {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT};
 
-struct ImageTransitionInfo
-{
-    VkImageMemoryBarrier barrier{};
+        case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+            return {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT};
 
-    VkPipelineStageFlags sourceStage;
-    VkPipelineStageFlags destinationStage;
+        case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+            return {VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT};
 
-    void setupForTransition(TransitionType transitionType,
-                            VkFormat       imageFormat);
+        //   ,   
+        case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+            return {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0};
 
-private:
-    void setupForDataWriting();
-    void setupForShaderReading();
-    void setupForDepthStencil(VkFormat  format);
-};
+        default:
+            throw std::invalid_argument("unsupported layout transition!");
+    }
+}
 
-void ImageTransitionInfo::setupForTransition(TransitionType transitionType, 
-                                             VkFormat       imageFormat)
+static VkImageAspectFlags getAspectMask(VkImageLayout layout,
+                                        VkFormat      format)
 {
-    switch(transitionType)
-    {
-        case TransitionType::WRITE_OPTIMAL:
+    if(layout != VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
+        return VK_IMAGE_ASPECT_COLOR_BIT;
 
-            setupForDataWriting(); break;
+    VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
 
-        case TransitionType::SHADER_READ_OPTIMAL:
+    if(hasStencilComponent(format))
+        aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
 
-            setupForShaderReading(); break;
-
-        case TransitionType::DEPTH_STENCIL_OPTIMAL:
-
-            setupForDepthStencil(imageFormat); break;
-    }
+    return aspectMask;
 }
 
-void ImageTransitionInfo::setupForDataWriting()
-{
-     barrier.srcAccessMask = 0;
-     barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-     sourceStage      = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-     destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-}
+///////////////////////// STATIC END //////////////////////////////
 
-void ImageTransitionInfo::setupForShaderReading()
-{
-      barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-      barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
-      sourceStage      = VK_PIPELINE_STAGE_TRANSFER_BIT;
-      destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-}
+///////////////////////// PUBLIC BEG //////////////////////////////
 
-void ImageTransitionInfo::setupForDepthStencil(VkFormat  format)
+void recordImageLayoutTransition(VkCommandBuffer commandBuffer,
+                                 VkImage         image,
+                                 VkFormat        format,
+                                 VkImageLayout   oldLayout,
+                                 VkImageLayout   newLayout,
+                                 uint32_t        levelCount)
 {
-      barrier.srcAccessMask = 0;
-      barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | 
-                              VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-
-      barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    LayoutAccess oldAccess = getLayoutAccess(oldLayout);
+    LayoutAccess newAccess = getLayoutAccess(newLayout);
 
-      if(hasStencilComponent(format))
-          barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+    VkImageMemoryBarrier barrier{};
+    barrier.sType     = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
 
-      sourceStage      = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-      destinationStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-}
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 
-///////////////////////// IMAGE TRANSITION INFO END //////////////////////////////
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask     = getAspectMask(newLayout == VK_IMAGE_LAYOUT_UNDEFINED ? oldLayout
+                                                                                                    : newLayout,
+                                                            format);
+    barrier.subresourceRange.baseMipLevel   = 0;
+    barrier.subresourceRange.levelCount     = levelCount;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount     = 1;
 
+    //     ,     
+    barrier.srcAccessMask = oldAccess.access & (VK_ACCESS_TRANSFER_WRITE_BIT                 |
+                                                VK_ACCESS_SHADER_WRITE_BIT                   |
+                                                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT         |
+                                                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+    barrier.dstAccessMask = newAccess.access;
 
-///////////////////////// PUBLIC BEG //////////////////////////////
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        oldAccess.stage, newAccess.stage,
+        0,
+        0, nullptr,
+        0, nullptr,
+        1, &barrier
+    );
+}
 
 void transitionImageLayout(CommandPool    &commandPool,
                            Image          &image,
@@ -140,23 +123,13 @@ void transitionImageLayout(CommandPool    &commandPool,
 {
     VkCommandBuffer commandBuffer;
     commandBuffer = beginSingleTimeCommands(commandPool);
-    
-
-    ImageTransitionInfo  transitionInfo{};
-    setupImageMemoryBarrier(oldLayout, newLayout, image.handle, transitionInfo.barrier);
-    
-    TransitionType transitionType = getTransitionType(oldLayout, newLayout);
-    transitionInfo.setupForTransition(transitionType, format);
-    
 
-    vkCmdPipelineBarrier(
-        commandBuffer,
-        transitionInfo.sourceStage, transitionInfo.destinationStage,
-        0,
-        0, nullptr,
-        0, nullptr,
-        1, &transitionInfo.barrier
-    );
+    recordImageLayoutTransition(commandBuffer,
+                                image.handle,
+                                format,
+                                oldLayout,
+                                newLayout,
+                                image.mipLevels);
 
     endSingleTimeCommands(commandPool,
                           commandBuffer);
@@ -6,9 +6,18 @@
 #include "commandBuffer.h"
 #include "image.h"
 
+//        
+//          
+//     [0, levelCount)
+void recordImageLayoutTransition(VkCommandBuffer commandBuffer,
+                                 VkImage         image,
+                                 VkFormat        format,
+                                 VkImageLayout   oldLayout,
+                                 VkImageLayout   newLayout,
+                                 uint32_t        levelCount = 1);
+
 void transitionImageLayout(CommandPool    &commandPool,
                            Image          &image,
                            VkFormat       format,
                            VkImageLayout  oldLayout,
                            VkImageLayout  newLayout);
-                           
\ No newline at end of file
@@ -0,0 +1,363 @@
+#include "uploadBatch.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+#include "commandBuffer.h"
+#include "transitionImageLayout.h"
+
+///////////////////////// STATIC BEG //////////////////////////////
+
+//        ,
+//          
+static const VkDeviceSize stagingChunkSize = 8 * 1024 * 1024;
+
+//           4
+static const VkDeviceSize stagingAlignment = 16;
+
+static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static VkFence createUploadFence(const LogicalDevice &device)
+{
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    VkFence fence;
+    if(vkCreateFence(device.handle, &fenceInfo, nullptr, &fence) != VK_SUCCESS)
+        throw std::runtime_error("failed to create upload fence!");
+
+    return fence;
+}
+
+///////////////////////// STATIC END //////////////////////////////
+
+
+
+///////////////////////// UPLOADBATCH BEG //////////////////////////////
+
+UploadBatch::UploadBatch()
+{
+    this->device        = nullptr;
+    this->commandPool   = nullptr;
+    this->commandBuffer = VK_NULL_HANDLE;
+    this->fence         = VK_NULL_HANDLE;
+    this->pending       = false;
+    this->stagingOffset = 0;
+    this->commandCount  = 0;
+    this->submitCount   = 0;
+}
+
+void UploadBatch::begin(CommandPool &commandPool)
+{
+    if(isRecording())
+        throw std::logic_error("upload batch is already recording!");
+
+    if(pending)
+        throw std::logic_error("upload batch is still pending!");
+
+    this->commandPool = &commandPool;
+    this->device      = commandPool.device;
+
+    if(!fence)
+        fence = createUploadFence(*device);
+
+    //    ,    ,   submit
+    commandBuffer = beginSingleTimeCommands(commandPool);
+    commandCount  = 0;
+}
+
+bool UploadBatch::isRecording() const
+{
+    return commandBuffer != VK_NULL_HANDLE && !pending;
+}
+
+void UploadBatch::copyToBuffer(const void   *data,
+                               VkDeviceSize  size,
+                               Buffer       &buffer,
+                               VkDeviceSize  offset)
+{
+    VkDeviceSize sourceOffset;
+    Buffer &stagingBuffer = stage(data, size, sourceOffset);
+
+    VkBufferCopy copyRegion{};
+    copyRegion.srcOffset = sourceOffset;
+    copyRegion.dstOffset = offset;
+    copyRegion.size      = size;
+    vkCmdCopyBuffer(commandBuffer,
+                    stagingBuffer.handle,
+                    buffer.handle,
+                    1, &copyRegion);
+
+    commandCount++;
+}
+
+void UploadBatch::copyBuffer(Buffer       &srcBuffer,
+                             Buffer       &dstBuffer,
+                             VkDeviceSize  size)
+{
+    if(!isRecording())
+        throw std::logic_error("upload batch is not recording!");
+
+    VkBufferCopy copyRegion{};
+    copyRegion.size = size;
+    vkCmdCopyBuffer(commandBuffer,
+                    srcBuffer.handle,
+                    dstBuffer.handle,
+                    1, &copyRegion);
+
+    commandCount++;
+}
+
+void UploadBatch::copyToImage(const void   *data,
+                              VkDeviceSize  size,
+                              VkExtent3D    extent,
+                              Image        &image,
+                              uint32_t      mipLevel)
+{
+    VkDeviceSize sourceOffset;
+    Buffer &stagingBuffer = stage(data, size, sourceOffset);
+
+    VkBufferImageCopy region{};
+    region.bufferOffset      = sourceOffset;
+    region.bufferRowLength   = 0;
+    region.bufferImageHeight = 0;
+
+    region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel       = mipLevel;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount     = 1;
+
+    region.imageOffset = {0, 0, 0};
+    region.imageExtent = extent;
+
+    vkCmdCopyBufferToImage(commandBuffer,
+                           stagingBuffer.handle,
+                           image.handle,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           1, &region);
+
+    commandCount++;
+}
+
+void UploadBatch::copyImage(Image       &srcImage,
+                            uint32_t     srcLevel,
+                            Image       &dstImage,
+                            uint32_t     dstLevel,
+                            VkExtent3D   extent)
+{
+    if(!isRecording())
+        throw std::logic_error("upload batch is not recording!");
+
+    VkImageCopy region{};
+    region.srcSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.srcSubresource.mipLevel       = srcLevel;
+    region.srcSubresource.baseArrayLayer = 0;
+    region.srcSubresource.layerCount     = 1;
+
+    region.dstSubresource                = region.srcSubresource;
+    region.dstSubresource.mipLevel       = dstLevel;
+
+    region.srcOffset = {0, 0, 0};
+    region.dstOffset = {0, 0, 0};
+    region.extent    = extent;
+
+    vkCmdCopyImage(commandBuffer,
+                   srcImage.handle,
+                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   dstImage.handle,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   1, &region);
+
+    commandCount++;
+}
+
+void UploadBatch::transitionImageLayout(Image         &image,
+                                        VkFormat       format,
+                                        VkImageLayout  oldLayout,
+                                        VkImageLayout  newLayout)
+{
+    recordImageLayoutTransition(commandBuffer,
+                                image.handle,
+                                format,
+                                oldLayout,
+                                newLayout,
+                                image.mipLevels);
+
+    commandCount++;
+}
+
+void UploadBatch::memoryBarrier(VkPipelineStageFlags srcStage,
+                                VkAccessFlags        srcAccess,
+                                VkPipelineStageFlags dstStage,
+                                VkAccessFlags        dstAccess)
+{
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+
+    vkCmdPipelineBarrier(commandBuffer,
+                         srcStage, dstStage,
+                         0,
+                         1, &barrier,
+                         0, nullptr,
+                         0, nullptr);
+
+    commandCount++;
+}
+
+void UploadBatch::submit()
+{
+    submitAsync();
+    finish();
+}
+
+void UploadBatch::submitAsync()
+{
+    if(!isRecording())
+        throw std::logic_error("upload batch is not recording!");
+
+    if(commandPool->profiler)
+        commandPool->profiler->endUpload(commandBuffer);
+
+    if(vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+        throw std::runtime_error("failed to record upload command buffer!");
+
+    //    
+    if(commandCount == 0)
+    {
+        commandPool->freeCommandBuffers(1, &commandBuffer);
+        commandBuffer = VK_NULL_HANDLE;
+
+        releaseStagingBuffers();
+        return;
+    }
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers    = &commandBuffer;
+
+    if(vkQueueSubmit(device->graphicsQueue, 1, &submitInfo, fence) != VK_SUCCESS)
+        throw std::runtime_error("failed to submit upload command buffer!");
+
+    pending = true;
+    submitCount++;
+}
+
+bool UploadBatch::isPending() const
+{
+    return pending;
+}
+
+bool UploadBatch::poll()
+{
+    if(!pending)
+        return true;
+
+    if(vkGetFenceStatus(device->handle, fence) != VK_SUCCESS)
+        return false;
+
+    complete();
+    return true;
+}
+
+void UploadBatch::finish()
+{
+    if(!pending)
+        return;
+
+    //    ,    ,  vkQueueWaitIdle
+    vkWaitForFences(device->handle, 1, &fence, VK_TRUE, UINT64_MAX);
+
+    complete();
+}
+
+uint32_t UploadBatch::getCommandCount() const
+{
+    return commandCount;
+}
+
+uint32_t UploadBatch::getSubmitCount() const
+{
+    return submitCount;
+}
+
+void UploadBatch::destroy()
+{
+    finish();
+
+    if(isRecording())
+    {
+        vkEndCommandBuffer(commandBuffer);
+        commandPool->freeCommandBuffers(1, &commandBuffer);
+        commandBuffer = VK_NULL_HANDLE;
+    }
+
+    stagingBuffers.clear();
+    stagingOffset = 0;
+
+    if(fence)
+    {
+        vkDestroyFence(device->handle, fence, nullptr);
+        fence = VK_NULL_HANDLE;
+    }
+}
+
+
+Buffer &UploadBatch::stage(const void   *data,
+                           VkDeviceSize  size,
+                           VkDeviceSize &offset)
+{
+    if(!isRecording())
+        throw std::logic_error("upload batch is not recording!");
+
+    offset = alignUp(stagingOffset, stagingAlignment);
+
+    if(stagingBuffers.empty() || offset + size > stagingBuffers.back().size)
+    {
+        stagingBuffers.emplace_back(device);
+        createStagingBuffer(std::max(size, stagingChunkSize), stagingBuffers.back());
+        stagingBuffers.back().map();
+
+        offset = 0;
+    }
+
+    Buffer &stagingBuffer = stagingBuffers.back();
+    memcpy(static_cast<char *>(stagingBuffer.map()) + offset, data, static_cast<size_t>(size));
+
+    stagingOffset = offset + size;
+
+    return stagingBuffer;
+}
+
+void UploadBatch::releaseStagingBuffers()
+{
+    //        ,
+    //       
+    while(stagingBuffers.size() > 1 ||
+          (!stagingBuffers.empty() && stagingBuffers.back().size > stagingChunkSize))
+        stagingBuffers.pop_back();
+
+    stagingOffset = 0;
+}
+
+void UploadBatch::complete()
+{
+    vkResetFences(device->handle, 1, &fence);
+
+    if(commandPool->profiler)
+        commandPool->profiler->collectUpload();
+
+    commandPool->freeCommandBuffers(1, &commandBuffer);
+    commandBuffer = VK_NULL_HANDLE;
+    pending       = false;
+
+    releaseStagingBuffers();
+}
+
+///////////////////////// UPLOADBATCH END //////////////////////////////
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <deque>
+
+#include "device.h"
+#include "buffer.h"
+#include "image.h"
+#include "commandPool.h"
+
+/*
+*    
+*  ,          ,
+*    vkQueueSubmit    .  
+*    ,      
+*        ,    submit
+*    ,      
+* submitAsync    :     poll  finish,
+*        
+*/
+struct UploadBatch
+{
+    const LogicalDevice  *device;
+
+    UploadBatch();
+
+    void begin(CommandPool &commandPool);
+
+    bool isRecording() const;
+
+    void copyToBuffer(const void   *data,
+                      VkDeviceSize  size,
+                      Buffer       &buffer,
+                      VkDeviceSize  offset = 0);
+
+    //    ,       
+    void copyBuffer(Buffer       &srcBuffer,
+                    Buffer       &dstBuffer,
+                    VkDeviceSize  size);
+
+    //     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL.     
+    // extent -    mipLevel
+    void copyToImage(const void   *data,
+                     VkDeviceSize  size,
+                     VkExtent3D    extent,
+                     Image        &image,
+                     uint32_t      mipLevel = 0);
+
+    //   srcLevel   dstLevel    extent.   
+    //  VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,  -  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+    void copyImage(Image       &srcImage,
+                   uint32_t     srcLevel,
+                   Image       &dstImage,
+                   uint32_t     dstLevel,
+                   VkExtent3D   extent);
+
+    //      
+    void transitionImageLayout(Image         &image,
+                               VkFormat       format,
+                               VkImageLayout  oldLayout,
+                               VkImageLayout  newLayout);
+
+    //    . ,      
+    void memoryBarrier(VkPipelineStageFlags srcStage,
+                       VkAccessFlags        srcAccess,
+                       VkPipelineStageFlags dstStage,
+                       VkAccessFlags        dstAccess);
+
+    //      .      
+    void submit();
+
+    //     .    
+    //       ,    
+    void submitAsync();
+
+    //     ,      
+    bool isPending() const;
+
+    // true,        .    
+    bool poll();
+
+    //   
+    void finish();
+
+    //     
+    uint32_t getCommandCount() const;
+    //      
+    uint32_t getSubmitCount() const;
+
+    void destroy();
+
+private:
+    CommandPool       *commandPool;
+    VkCommandBuffer    commandBuffer;
+    VkFence            fence;
+    bool               pending;
+
+    //    .       
+    std::deque<Buffer> stagingBuffers;
+    VkDeviceSize       stagingOffset;
+
+    uint32_t           commandCount;
+    uint32_t           submitCount;
+
+    //      size .      
+    Buffer &stage(const void   *data,
+                  VkDeviceSize  size,
+                  VkDeviceSize &offset);
+
+    void releaseStagingBuffers();
+
+    //    :      
+    void complete();
+};
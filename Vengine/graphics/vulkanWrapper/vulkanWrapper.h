@@ -16,16 +16,24 @@
 
 #include "swapChain.h"
 #include "renderPass.h"
+#include "renderGraph.h"
 #include "shaderModule.h"
+#include "shaderReflection.h"
 #include "pipelineLayout.h"
 #include "pipeline.h"
 
 
 #include "transitionImageLayout.h"
+#include "uploadBatch.h"
+#include "geometryPool.h"
 #include "texture.h"
 
 #include "descriptorSetLayout.h"
+#include "layoutCache.h"
 #include "descriptorPool.h"
+#include "descriptorAllocator.h"
 #include "descriptorSet.h"
 
-#include "synchronization.h"
\ No newline at end of file
+#include "synchronization.h"
+#include "gpuProfiler.h"
+#include "readback.h"
\ No newline at end of file
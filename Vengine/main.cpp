@@ -1,6 +1,11 @@
 #include <iostream>
 #include <stdexcept>
 #include <cstdlib> //  EXIT_SUCCESS  EXIT_FAILURE
+#include <string>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <algorithm>
 
 #ifdef NDEBUG
     #define USE_VALIDATION_LAYERS
@@ -21,9 +26,15 @@ void interfaceCallBack(int key, int action, int modificators, Renderer *renderer
     static float onePressRotation = 2.5;
     static float onePressScale    = 0.05;
 
-    glm::vec3 &position = renderer->model.position;
-    glm::vec3 &rotation = renderer->model.rotation;
-    glm::vec3 &scale    = renderer->model.scale;
+    // Tab    
+    if(key == GLFW_KEY_TAB && action == GLFW_PRESS && !renderer->scene.empty())
+        renderer->selectedObject = (renderer->selectedObject + 1) % renderer->scene.objects.size();
+
+    SceneObject &object = renderer->getSelectedObject();
+
+    glm::vec3 &position = object.position;
+    glm::vec3 &rotation = object.rotation;
+    glm::vec3 &scale    = object.scale;
     PipelineFixedFunctions &fixedFunctions = renderer->pipelineFixedFunctions;
     
     if(modificators == 0)
@@ -56,10 +67,33 @@ void interfaceCallBack(int key, int action, int modificators, Renderer *renderer
         if(key == GLFW_KEY_KP_3 || key == GLFW_KEY_PAGE_DOWN ) scale.z -= onePressScale;
     }
 
+    //     renderer      
+    renderer->markObjectsChanged();
+
     if(key == GLFW_KEY_F) renderer->setFillMode(FillMode::FILL);
     if(key == GLFW_KEY_L) renderer->setFillMode(FillMode::LINE);
     if(key == GLFW_KEY_P) renderer->setFillMode(FillMode::POINT);
 
+    // I  ,         
+    if(key == GLFW_KEY_I && action == GLFW_PRESS)
+        renderer->setInstancing(!renderer->settings.instancing);
+
+    // C         
+    if(key == GLFW_KEY_C && action == GLFW_PRESS)
+        renderer->settings.frustumCulling = !renderer->settings.frustumCulling;
+
+    // O     .   LINE ,   
+    if(key == GLFW_KEY_O && action == GLFW_PRESS)
+        renderer->settings.lod = !renderer->settings.lod;
+
+    // T    ,   
+    if(key == GLFW_KEY_T && action == GLFW_PRESS && !renderer->settings.tracePath.empty())
+        renderer->writeTrace(renderer->settings.tracePath);
+
+    // F12   
+    if(key == GLFW_KEY_F12 && action == GLFW_PRESS)
+        renderer->saveScreenshot("screenshot.ppm");
+
     Pixel color;
     if(key == GLFW_KEY_1) color = Pixel{204, 255,   0}; // 
     if(key == GLFW_KEY_2) color = Pixel{228,   0, 225}; // 
@@ -81,22 +115,238 @@ void interfaceCallBack(int key, int action, int modificators, Renderer *renderer
         justColor.channels = 4;
 
         renderer->setTexture(justColor);
-        renderer->pushTexture();
+        renderer->pushTexture(object.texture);
+    }
+}
+
+
+/*
+*  count       [-1, 1]  XZ,
+*     .      
+*/
+static void fillInstanceGrid(Scene &scene, uint32_t count)
+{
+    MeshHandle    mesh    = scene.addMesh(Mesh());
+    TextureHandle texture = scene.addTexture(Texture());
+
+    uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    float    step = 2.0f / side;
+
+    for(uint32_t i = 0; i < count; i++)
+    {
+        glm::vec3 position(-1.0f + step * (i % side + 0.5f),
+                           0.0f,
+                           -1.0f + step * (i / side + 0.5f));
+
+        glm::vec3 scale(step * 0.4f);
+
+        glm::vec4 tint(0.5f + 0.5f * position.x,
+                       0.5f + 0.5f * position.z,
+                       1.0f,
+                       1.0f);
+
+        scene.addObject(mesh, texture, position, glm::vec3(0.0f), scale, tint);
+    }
+}
+
+
+static VkPresentModeKHR parsePresentMode(const std::string &name)
+{
+    if(name == "immediate")    return VK_PRESENT_MODE_IMMEDIATE_KHR;
+    if(name == "mailbox")      return VK_PRESENT_MODE_MAILBOX_KHR;
+    if(name == "fifo")         return VK_PRESENT_MODE_FIFO_KHR;
+    if(name == "fifo_relaxed") return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+
+    throw std::invalid_argument("unknown present mode: " + name);
+}
+
+/*
+*    :
+* --present-mode immediate|mailbox|fifo|fifo_relaxed
+* --swapchain-images N
+* --frames-in-flight N
+* --headless [] -        
+* --measure-latency [   ]
+* --instances N -   N ,       
+* --no-instancing -     
+* --compare-instancing [   ]
+* --no-culling -   ,       
+* --gpu-culling -    
+* --no-lod -      
+* --lod-error N -      
+* --lod-report -      
+* --draw-report -      
+* --texture-budget MB -     
+* --texture-report -         
+* --no-mip-streaming -      
+* --no-atlas -    ,      
+* --no-shader-reload -      
+* --gpu-profile [  ] -      
+* --trace FILE -            FILE
+* --screenshot FILE -       FILE.   : .png, .raw  PPM
+* --offline N [] -    N        
+* --encode-threads N -     --offline
+* --thumbnail-service SOCKET -         SOCKET
+* --thumbnail-batch N -      
+*
+*   , Renderer    :
+* --thumbnail-client SOCKET     FILE -        FILE
+*/
+static void parseArguments(int argc, char **argv, vkSettings &settings, uint32_t &instanceCount)
+{
+    for(int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        bool        hasValue = i + 1 < argc;
+
+        if(argument == "--present-mode" && hasValue)
+            settings.presentMode = parsePresentMode(argv[++i]);
+        else if(argument == "--swapchain-images" && hasValue)
+            settings.swapchainImageCount = std::stoul(argv[++i]);
+        else if(argument == "--frames-in-flight" && hasValue)
+            settings.framesInFlight = std::stoul(argv[++i]);
+        else if(argument == "--headless")
+        {
+            settings.headless = true;
+
+            if(hasValue && isdigit(argv[i + 1][0]))
+                settings.headlessFrames = std::stoul(argv[++i]);
+        }
+        else if(argument == "--measure-latency")
+        {
+            settings.measureLatency = true;
+
+            if(hasValue && isdigit(argv[i + 1][0]))
+                settings.measurementFrames = std::stoul(argv[++i]);
+        }
+        else if(argument == "--instances" && hasValue)
+            instanceCount = std::stoul(argv[++i]);
+        else if(argument == "--no-instancing")
+            settings.instancing = false;
+        else if(argument == "--no-culling")
+            settings.frustumCulling = false;
+        else if(argument == "--gpu-culling")
+            settings.gpuCulling = true;
+        else if(argument == "--no-lod")
+            settings.lod = false;
+        else if(argument == "--lod-error" && hasValue)
+            settings.lodErrorPixels = std::stof(argv[++i]);
+        else if(argument == "--lod-report")
+            settings.reportLod = true;
+        else if(argument == "--draw-report")
+            settings.reportDrawState = true;
+        else if(argument == "--texture-budget" && hasValue)
+            settings.textureBudgetMB = std::stoul(argv[++i]);
+        else if(argument == "--texture-report")
+            settings.reportTextureResidency = true;
+        else if(argument == "--no-mip-streaming")
+            settings.mipStreaming = false;
+        else if(argument == "--no-atlas")
+            settings.atlasMaxTextureSize = 0;
+        else if(argument == "--no-shader-reload")
+            settings.shaderHotReload = false;
+        else if(argument == "--gpu-profile")
+        {
+            settings.gpuProfiling = true;
+
+            if(hasValue && isdigit(argv[i + 1][0]))
+                settings.measurementFrames = std::stoul(argv[++i]);
+        }
+        else if(argument == "--trace" && hasValue)
+            settings.tracePath = argv[++i];
+        else if(argument == "--screenshot" && hasValue)
+            settings.screenshotPath = argv[++i];
+        else if(argument == "--offline" && hasValue)
+        {
+            settings.offlineFrames = std::stoul(argv[++i]);
+
+            if(i + 1 < argc && argv[i + 1][0] != '-')
+                settings.offlinePath = argv[++i];
+        }
+        else if(argument == "--encode-threads" && hasValue)
+            settings.encodeThreads = std::stoul(argv[++i]);
+        else if(argument == "--thumbnail-service" && hasValue)
+            settings.servicePath = argv[++i];
+        else if(argument == "--thumbnail-batch" && hasValue)
+            settings.serviceBatchSize = std::max<uint32_t>(std::stoul(argv[++i]), 1);
+        else if(argument == "--compare-instancing")
+        {
+            settings.compareInstancing = true;
+
+            if(hasValue && isdigit(argv[i + 1][0]))
+                settings.measurementFrames = std::stoul(argv[++i]);
+        }
+        else
+            throw std::invalid_argument("unknown argument: " + argument);
     }
 }
 
+//   : --thumbnail-client SOCKET     FILE
+static int requestThumbnail(char **argv)
+{
+    ThumbnailJob job;
+    job.id          = "0";
+    job.meshPath    = argv[3];
+    job.texturePath = argv[4];
+    job.width       = std::stoul(argv[5]);
+    job.height      = std::stoul(argv[6]);
+
+    std::vector<unsigned char> png = ThumbnailService::request(argv[2], job);
+
+    std::ofstream file(argv[7], std::ios::binary);
+    if(!file.is_open())
+        throw std::runtime_error("failed to open file " + std::string(argv[7]) + "!");
+
+    file.write(reinterpret_cast<const char *>(png.data()), png.size());
+    
+    return EXIT_SUCCESS;
+}
+
 
-int main() 
+int main(int argc, char **argv) 
 {
+    if(argc == 8 && std::string(argv[1]) == "--thumbnail-client")
+    {
+        try
+        {
+            return requestThumbnail(argv);
+        }
+        catch(std::exception &e)
+        {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
     Shader vertexShader("shaders/bin/vert.spv", ShaderStages::VERTEX_STAGE);
     Shader fragmentShader("shaders/bin/frag.spv", ShaderStages::FRAGMENT_STAGE);
 
     Renderer app;
+    uint32_t instanceCount = 0;
+
+    try
+    {
+        parseArguments(argc, argv, app.settings, instanceCount);
+    }
+    catch(std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
     app.loadShader(vertexShader);
     app.loadShader(fragmentShader);
 
+    if(app.settings.gpuCulling)
+        app.loadCullingShaders(Shader("shaders/bin/cull.spv",     ShaderStages::COMPUTE_STAGE),
+                               Shader("shaders/bin/compact.spv",  ShaderStages::COMPUTE_STAGE),
+                               Shader("shaders/bin/clusters.spv", ShaderStages::COMPUTE_STAGE));
+
     app.setInterfaceCallback(interfaceCallBack);
 
+    if(instanceCount > 0)
+        fillInstanceGrid(app.scene, instanceCount);
+
     try 
     {
         app.run();
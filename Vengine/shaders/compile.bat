@@ -1,2 +1,5 @@
 D:\Programms\Vulkan\1.2.154.1\Bin32\glslc.exe shader.vert -o bin\vert.spv
-D:\Programms\Vulkan\1.2.154.1\Bin32\glslc.exe shader.frag -o bin\frag.spv
\ No newline at end of file
+D:\Programms\Vulkan\1.2.154.1\Bin32\glslc.exe shader.frag -o bin\frag.spv
+D:\Programms\Vulkan\1.2.154.1\Bin32\glslc.exe cull.comp -o bin\cull.spv
+D:\Programms\Vulkan\1.2.154.1\Bin32\glslc.exe compact.comp -o bin\compact.spv
+D:\Programms\Vulkan\1.2.154.1\Bin32\glslc.exe clusters.comp -o bin\clusters.spv
\ No newline at end of file
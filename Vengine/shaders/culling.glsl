@@ -0,0 +1,129 @@
+//     cull.comp, clusters.comp  compact.comp
+//      Culling*  buffer.h
+
+layout(set = 0, binding = 0) uniform UniformBufferObject {
+    mat4 view;
+    mat4 proj;
+    bool noTexture;
+    vec4 frustumPlanes[6];
+    vec4 lodParameters;
+} ubo;
+
+struct Object {
+    mat4 model;
+    vec4 tint;
+    vec4 uvRect;
+    vec4 sphere;
+    uint group;
+    float scale;
+};
+
+struct Group {
+    uint indexCount;
+    uint firstIndex;
+    int  vertexOffset;
+    uint firstInstance;
+    uint textureRun;
+    uint runFirstDraw;
+    float lodError;
+    uint lodCount;
+    uint clusterCount;
+};
+
+struct Instance {
+    mat4 model;
+    vec4 tint;
+    vec4 uvRect;
+};
+
+//    VkDrawIndexedIndirectCommand
+struct DrawCommand {
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int  vertexOffset;
+    uint firstInstance;
+};
+
+struct Cluster {
+    vec4 sphere;
+    vec4 cone;
+    uint object;
+    uint group;
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer ObjectBuffer {
+    Object objects[];
+};
+
+layout(std430, set = 0, binding = 2) readonly buffer GroupBuffer {
+    Group groups[];
+};
+
+//  groupCount  -     ,
+//       
+layout(std430, set = 0, binding = 3) buffer CounterBuffer {
+    uint counters[];
+};
+
+layout(std430, set = 0, binding = 4) writeonly buffer InstanceBuffer {
+    Instance instances[];
+};
+
+layout(std430, set = 0, binding = 5) writeonly buffer CommandBuffer {
+    DrawCommand commands[];
+};
+
+layout(std430, set = 0, binding = 6) readonly buffer ClusterBuffer {
+    Cluster clusters[];
+};
+
+layout(push_constant) uniform PushConstants {
+    uint objectCount;
+    uint groupCount;
+    uint compactDraws;
+    uint clusterCount;
+} pc;
+
+bool isVisible(vec4 sphere)
+{
+    for(int i = 0; i < 6; i++)
+    {
+        if(dot(ubo.frustumPlanes[i].xyz, sphere.xyz) + ubo.frustumPlanes[i].w < -sphere.w)
+            return false;
+    }
+
+    return true;
+}
+
+//    ,       
+//         
+uint selectLod(Object object)
+{
+    if(ubo.lodParameters.w <= 0.0)
+        return 0;
+
+    //       
+    float distance = length(object.sphere.xyz - ubo.lodParameters.xyz) - object.sphere.w;
+    if(distance <= 0.0)
+        return 0;
+
+    for(uint lod = groups[object.group].lodCount - 1; lod > 0; lod--)
+    {
+        if(groups[object.group + lod].lodError * object.scale * ubo.lodParameters.w <= distance)
+            return lod;
+    }
+
+    return 0;
+}
+
+//    .      :      
+void appendInstance(uint group, Object object)
+{
+    uint slot = atomicAdd(counters[group], 1);
+
+    uint instance = groups[group].firstInstance + slot;
+    instances[instance].model  = object.model;
+    instances[instance].tint   = object.tint;
+    instances[instance].uvRect = object.uvRect;
+}
\ No newline at end of file
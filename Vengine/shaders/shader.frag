@@ -1,14 +1,61 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
+#extension GL_EXT_nonuniform_qualifier : require
 
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) in vec4 fragTint;
+//     : xy - , zw - 
+layout(location = 3) flat in vec4 fragUvRect;
 
 layout(location = 0) out vec4 outColor;
 
-layout(binding = 1) uniform sampler2D texSampler;
+//   .    ,   
+// ,     
+layout(set = 1, binding = 0) uniform texture2D textures[];
+layout(set = 1, binding = 1) uniform sampler   texSampler;
+
+layout(push_constant) uniform DrawConstants
+{
+    uint textureIndex;
+} draw;
+
+//   :      
+//     ,      
+layout(set = 0, binding = 1) buffer TextureFeedback
+{
+    uint requestedSize[];
+} feedback;
+
+//         feedbackTile x feedbackTile ,
+//      
+const int feedbackTile = 8;
 
 void main() 
 {
-    outColor = vec4(fragColor * texture(texSampler, fragTexCoord).rgb, 1.0);
+    //       fract,   
+    //   :         .
+    //     ,      
+    vec2 uvDx = dFdx(fragTexCoord) * fragUvRect.xy;
+    vec2 uvDy = dFdy(fragTexCoord) * fragUvRect.xy;
+    vec2 uv   = fract(fragTexCoord) * fragUvRect.xy + fragUvRect.zw;
+
+    vec3 texel = textureGrad(sampler2D(textures[draw.textureIndex], texSampler), uv, uvDx, uvDy).rgb;
+
+    vec2 textureExtent = vec2(textureSize(sampler2D(textures[draw.textureIndex], texSampler), 0));
+    vec2 dx            = uvDx * textureExtent;
+    vec2 dy            = uvDy * textureExtent;
+
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    if(pixel.x % feedbackTile == 0 && pixel.y % feedbackTile == 0)
+    {
+        //     . ,    
+        //   ,    ,    
+        float footprint = max(max(length(dx), length(dy)), 1.0 / 65536.0);
+        float wanted    = max(textureExtent.x, textureExtent.y) / footprint;
+
+        atomicMax(feedback.requestedSize[draw.textureIndex], uint(min(wanted, 65536.0)));
+    }
+
+    outColor = vec4(fragColor * texel, 1.0) * fragTint;
 }
\ No newline at end of file
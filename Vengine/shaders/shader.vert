@@ -1,8 +1,7 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
-layout(binding = 0) uniform UniformBufferObject {
-    mat4 model;
+layout(set = 0, binding = 0) uniform UniformBufferObject {
     mat4 view;
     mat4 proj;
     bool noTexture;
@@ -12,11 +11,20 @@ layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inColor;
 layout(location = 2) in vec2 inTexCoord;
 
+//      .    location: 3, 4, 5  6
+layout(location = 3) in mat4 inModel;
+layout(location = 7) in vec4 inTint;
+layout(location = 8) in vec4 inUvRect;
+
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) out vec4 fragTint;
+layout(location = 3) flat out vec4 fragUvRect;
 
 void main() {
-    gl_Position  = ubo.proj * ubo.view * ubo.model * vec4(inPosition, 1.0);
+    gl_Position  = ubo.proj * ubo.view * inModel * vec4(inPosition, 1.0);
     fragColor    = inColor;
+    fragTint     = inTint;
     fragTexCoord = inTexCoord;
+    fragUvRect   = inUvRect;
 }
@@ -0,0 +1,570 @@
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <cstdlib> //  EXIT_SUCCESS  EXIT_FAILURE
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+#include "graphics/Mesh.h"
+#include "graphics/Texture.h"
+#include "graphics/Renderer.h"
+#include "graphics/Shader.h"
+
+#include "graphics/tools.h"
+
+#include "graphics/vulkanWrapper/vulkanWrapper.h"
+
+/*
+*        
+*       ,    
+*    models  textures.    Vengine,   shaders
+*    JSON:
+* {"benchmarks":[{"name":"load/obj","bytes":...,"seconds":...,"mbPerSecond":...},
+*                {"name":"frame/1000","objects":1000,"avgMs":...,"minMs":...,"p99Ms":...,"maxMs":...,"frames":...}]}
+*/
+
+struct BenchmarkSettings
+{
+    std::string outputPath   = "bench.json";
+    std::string objPath;
+    std::string imagePath;
+
+    //      .    
+    uint32_t    repeats      = 5;
+    uint32_t    frames       = 500;
+
+    //          
+    uint32_t    objGridSide  = 300;
+    uint32_t    imageSide    = 2048;
+
+    std::vector<uint32_t> sceneSizes = {1, 1000, 100000};
+};
+
+struct BenchmarkResult
+{
+    std::string name;
+    //   -    
+    std::vector<std::pair<std::string, double>> values;
+};
+
+
+///////////////////////// HELPERS BEG //////////////////////////////
+
+using Clock = std::chrono::steady_clock;
+
+template<typename Function>
+static double measureMedianSeconds(uint32_t repeats, Function function)
+{
+    std::vector<double> times;
+
+    for(uint32_t i = 0; i < repeats; i++)
+    {
+        Clock::time_point begin = Clock::now();
+        function();
+        times.push_back(std::chrono::duration<double>(Clock::now() - begin).count());
+    }
+
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+static size_t getFileSize(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if(!file.is_open())
+        throw std::runtime_error("failed to open file! " + path);
+
+    return static_cast<size_t>(file.tellg());
+}
+
+static BenchmarkResult makeThroughputResult(const std::string &name,
+                                            size_t             bytes,
+                                            double             seconds)
+{
+    BenchmarkResult result;
+    result.name   = name;
+    result.values = {{"bytes",       static_cast<double>(bytes)},
+                     {"seconds",     seconds},
+                     {"mbPerSecond", bytes / seconds / (1024.0 * 1024.0)}};
+
+    return result;
+}
+
+static void printResult(const BenchmarkResult &result)
+{
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << result.name << ":";
+
+    for(const auto &value : result.values)
+        std::cout << " " << value.first << " " << value.second;
+
+    std::cout << "\n";
+    std::cout.unsetf(std::ios_base::floatfield);
+}
+
+static void writeJson(const std::string                  &path,
+                      const std::vector<BenchmarkResult> &results)
+{
+    std::ofstream file(path);
+    if(!file.is_open())
+        throw std::runtime_error("failed to open benchmark output file!");
+
+    file << std::fixed << std::setprecision(6);
+    file << "{\"benchmarks\":[";
+
+    for(size_t i = 0; i < results.size(); i++)
+    {
+        file << (i == 0 ? "\n" : ",\n") << "{\"name\":\"" << results[i].name << "\"";
+
+        for(const auto &value : results[i].values)
+            file << ",\"" << value.first << "\":" << value.second;
+
+        file << "}";
+    }
+
+    file << "\n]}\n";
+}
+
+///////////////////////// HELPERS END //////////////////////////////
+
+
+///////////////////////// GENERATED DATA BEG //////////////////////////////
+
+/*
+*   side x side    
+*      "v/vt",    ,   
+*/
+static void writeGridObj(const std::string &path, uint32_t side)
+{
+    std::ofstream file(path);
+    if(!file.is_open())
+        throw std::runtime_error("failed to create benchmark obj file!");
+
+    file << std::fixed << std::setprecision(6);
+
+    for(uint32_t z = 0; z <= side; z++)
+        for(uint32_t x = 0; x <= side; x++)
+        {
+            float u = static_cast<float>(x) / side;
+            float v = static_cast<float>(z) / side;
+
+            file << "v "  << u - 0.5f << " " << 0.05f * std::sin(u * 40.0f) * std::cos(v * 40.0f) << " " << v - 0.5f << "\n";
+            file << "vt " << u << " " << v << "\n";
+        }
+
+    //   obj   
+    for(uint32_t z = 0; z < side; z++)
+        for(uint32_t x = 0; x < side; x++)
+        {
+            uint32_t a = z * (side + 1) + x + 1;
+            uint32_t b = a + 1;
+            uint32_t c = a + side + 1;
+            uint32_t d = c + 1;
+
+            file << "f " << a << "/" << a << " " << c << "/" << c << " " << b << "/" << b << "\n";
+            file << "f " << b << "/" << b << " " << c << "/" << c << " " << d << "/" << d << "\n";
+        }
+}
+
+static uint8_t getPatternValue(uint32_t x, uint32_t y, uint32_t channel)
+{
+    //   ,     
+    uint32_t hash = (x * 73856093u) ^ (y * 19349663u) ^ (channel * 83492791u);
+    uint32_t cell = ((x / 64) + (y / 64)) % 2;
+
+    return static_cast<uint8_t>(cell * 160 + hash % 96);
+}
+
+//  24- BMP,  stb_image    
+static void writePatternBmp(const std::string &path, uint32_t side)
+{
+    std::ofstream file(path, std::ios::binary);
+    if(!file.is_open())
+        throw std::runtime_error("failed to create benchmark image file!");
+
+    uint32_t rowSize   = (side * 3 + 3) & ~3u;
+    uint32_t imageSize = rowSize * side;
+    uint32_t fileSize  = 54 + imageSize;
+
+    auto write16 = [&file](uint16_t value) { file.write(reinterpret_cast<const char *>(&value), 2); };
+    auto write32 = [&file](uint32_t value) { file.write(reinterpret_cast<const char *>(&value), 4); };
+
+    file.write("BM", 2);
+    write32(fileSize);
+    write32(0);
+    write32(54);
+
+    write32(40);
+    write32(side);
+    write32(side);
+    write16(1);
+    write16(24);
+    write32(0);
+    write32(imageSize);
+    write32(2835);
+    write32(2835);
+    write32(0);
+    write32(0);
+
+    std::vector<uint8_t> row(rowSize, 0);
+    for(uint32_t y = 0; y < side; y++)
+    {
+        for(uint32_t x = 0; x < side; x++)
+            for(uint32_t channel = 0; channel < 3; channel++)
+                row[x * 3 + channel] = getPatternValue(x, y, channel);
+
+        file.write(reinterpret_cast<const char *>(row.data()), rowSize);
+    }
+}
+
+//    1      
+static Mesh createCubeMesh()
+{
+    Mesh mesh;
+
+    const glm::vec3 normals[6] = {{ 1, 0, 0}, {-1, 0, 0},
+                                  { 0, 1, 0}, { 0,-1, 0},
+                                  { 0, 0, 1}, { 0, 0,-1}};
+
+    for(const glm::vec3 &normal : normals)
+    {
+        glm::vec3 tangent   = std::abs(normal.y) > 0.5f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+        glm::vec3 bitangent = glm::cross(normal, tangent);
+
+        uint32_t first = static_cast<uint32_t>(mesh.vertices.size());
+
+        for(int corner = 0; corner < 4; corner++)
+        {
+            float u = (corner == 1 || corner == 2) ? 1.0f : 0.0f;
+            float v = (corner >= 2)                ? 1.0f : 0.0f;
+
+            Vertex vertex;
+            vertex.pos      = 0.5f * normal + (u - 0.5f) * tangent + (v - 0.5f) * bitangent;
+            vertex.color    = glm::vec3(1.0f);
+            vertex.texCoord = glm::vec2(u, v);
+
+            mesh.vertices.push_back(vertex);
+        }
+
+        for(uint32_t index : {0u, 1u, 2u, 2u, 3u, 0u})
+            mesh.indices.push_back(first + index);
+    }
+
+    mesh.computeBounds();
+
+    return mesh;
+}
+
+static Texture createCheckerTexture(uint32_t side)
+{
+    Texture texture;
+    texture.width    = side;
+    texture.height   = side;
+    texture.channels = 4;
+
+    for(uint32_t y = 0; y < side; y++)
+        for(uint32_t x = 0; x < side; x++)
+            texture.pixels.push_back(Pixel{getPatternValue(x, y, 0),
+                                           getPatternValue(x, y, 1),
+                                           getPatternValue(x, y, 2),
+                                           255});
+
+    return texture;
+}
+
+/*
+*  count     [-1, 1]  XZ,     
+*/
+static void fillCubeGrid(Scene &scene, uint32_t count)
+{
+    MeshHandle    mesh    = scene.addMesh(createCubeMesh());
+    TextureHandle texture = scene.addTexture(createCheckerTexture(256));
+
+    uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    float    step = 2.0f / side;
+
+    for(uint32_t i = 0; i < count; i++)
+    {
+        glm::vec3 position(-1.0f + step * (i % side + 0.5f),
+                           0.0f,
+                           -1.0f + step * (i / side + 0.5f));
+
+        //  ,       
+        glm::vec3 rotation(0.0f, static_cast<float>(i % 360), 0.0f);
+        glm::vec3 scale(step * 0.4f);
+
+        scene.addObject(mesh, texture, position, rotation, scale, glm::vec4(1.0f));
+    }
+}
+
+///////////////////////// GENERATED DATA END //////////////////////////////
+
+
+///////////////////////// SCENARIOS BEG //////////////////////////////
+
+static BenchmarkResult benchmarkObjLoad(const BenchmarkSettings &settings)
+{
+    std::string path = settings.objPath;
+    if(path.empty())
+    {
+        path = "bench_grid.obj";
+        writeGridObj(path, settings.objGridSide);
+    }
+
+    double seconds = measureMedianSeconds(settings.repeats, [&path]()
+    {
+        std::vector<Vertex>   vertices;
+        std::vector<uint32_t> indices;
+        VengineTools::loadMesh(path, vertices, indices);
+    });
+
+    BenchmarkResult result = makeThroughputResult("load/obj", getFileSize(path), seconds);
+
+    if(settings.objPath.empty())
+        std::remove(path.c_str());
+
+    return result;
+}
+
+static BenchmarkResult benchmarkImageLoad(const BenchmarkSettings &settings)
+{
+    std::string path = settings.imagePath;
+    if(path.empty())
+    {
+        path = "bench_pattern.bmp";
+        writePatternBmp(path, settings.imageSide);
+    }
+
+    double seconds = measureMedianSeconds(settings.repeats, [&path]()
+    {
+        int                width;
+        int                height;
+        int                channels;
+        std::vector<Pixel> pixels;
+        VengineTools::loadImage(path, width, height, channels, pixels);
+    });
+
+    BenchmarkResult result = makeThroughputResult("load/image", getFileSize(path), seconds);
+
+    if(settings.imagePath.empty())
+        std::remove(path.c_str());
+
+    return result;
+}
+
+/*
+*            ,
+*      ,    
+*/
+static std::vector<BenchmarkResult> benchmarkUploads(const BenchmarkSettings &settings)
+{
+    vkSettings engineSettings;
+
+    VkInstance instance = createInstance(engineSettings.validationLayers, {}, false);
+
+    //       
+    std::vector<const char *> deviceExtensions;
+    for(const char *extension : engineSettings.deviceExtensions)
+        if(std::string(extension) != VK_KHR_SWAPCHAIN_EXTENSION_NAME)
+            deviceExtensions.push_back(extension);
+
+    VkPhysicalDevice physicalDevice = pickPhysicalDevice(instance, VK_NULL_HANDLE, deviceExtensions);
+    LogicalDevice    device         = createLogicalDevice(instance, physicalDevice, VK_NULL_HANDLE, deviceExtensions);
+
+    CommandPool commandPool(&device);
+    commandPool.create();
+
+    UploadBatch upload;
+
+    std::vector<BenchmarkResult> results;
+
+    //    1 
+    std::vector<Vertex> vertices(1024 * 1024);
+    for(size_t i = 0; i < vertices.size(); i++)
+    {
+        vertices[i].pos      = glm::vec3(i % 1024, i / 1024, 0.0f);
+        vertices[i].color    = glm::vec3(1.0f);
+        vertices[i].texCoord = glm::vec2(0.0f);
+    }
+
+    double vertexSeconds = measureMedianSeconds(settings.repeats, [&]()
+    {
+        Buffer vertexBuffer(&device);
+        upload.begin(commandPool);
+        createVertexBuffer(upload, vertices, vertexBuffer);
+        upload.submit();
+        vertexBuffer.destroy();
+    });
+    results.push_back(makeThroughputResult("upload/vertex", vertices.size() * sizeof(Vertex), vertexSeconds));
+
+    Texture    texture = createCheckerTexture(settings.imageSide);
+    VkExtent3D extent  = {static_cast<uint32_t>(texture.width), static_cast<uint32_t>(texture.height), 1};
+
+    double textureSeconds = measureMedianSeconds(settings.repeats, [&]()
+    {
+        Image textureImage;
+        upload.begin(commandPool);
+        createTextureImage(texture.pixels.data(), texture.channels, extent, upload, textureImage);
+        upload.submit();
+        textureImage.destroy();
+    });
+    results.push_back(makeThroughputResult("upload/texture", texture.pixels.size() * sizeof(Pixel), textureSeconds));
+
+    //      ,    :    
+    std::vector<uint32_t> indices(vertices.size() / 4 * 6);
+    for(size_t i = 0; i < indices.size(); i++)
+        indices[i] = static_cast<uint32_t>(i % vertices.size());
+
+    double modelSeconds = measureMedianSeconds(settings.repeats, [&]()
+    {
+        Buffer vertexBuffer(&device);
+        Buffer indexBuffer(&device);
+        Image  textureImage;
+
+        upload.begin(commandPool);
+        createVertexBuffer(upload, vertices, vertexBuffer);
+        createIndexBuffer(upload, indices, indexBuffer);
+        createTextureImage(texture.pixels.data(), texture.channels, extent, upload, textureImage);
+        upload.submit();
+
+        textureImage.destroy();
+        indexBuffer.destroy();
+        vertexBuffer.destroy();
+    });
+    results.push_back(makeThroughputResult("upload/model",
+                                           vertices.size() * sizeof(Vertex) + 
+                                           indices.size()  * sizeof(uint32_t) +
+                                           texture.pixels.size() * sizeof(Pixel),
+                                           modelSeconds));
+
+    upload.destroy();
+
+    commandPool.destroy();
+    vkDestroyDevice(device.handle, nullptr);
+    vkDestroyInstance(instance, nullptr);
+
+    return results;
+}
+
+static BenchmarkResult benchmarkFrames(const BenchmarkSettings &settings, uint32_t objectCount)
+{
+    Renderer renderer;
+    renderer.settings.headless       = true;
+    renderer.settings.headlessFrames = settings.frames;
+
+    renderer.loadShader(Shader("shaders/bin/vert.spv", ShaderStages::VERTEX_STAGE));
+    renderer.loadShader(Shader("shaders/bin/frag.spv", ShaderStages::FRAGMENT_STAGE));
+
+    fillCubeGrid(renderer.scene, objectCount);
+
+    renderer.run();
+
+    FrameStats::Summary summary = renderer.getFrameStats().getFrameTimeSummary();
+
+    BenchmarkResult result;
+    result.name   = "frame/" + std::to_string(objectCount);
+    result.values = {{"objects", static_cast<double>(objectCount)},
+                     {"avgMs",   summary.avg},
+                     {"minMs",   summary.min},
+                     {"p99Ms",   summary.p99},
+                     {"maxMs",   summary.max},
+                     {"frames",  static_cast<double>(summary.samples)}};
+
+    return result;
+}
+
+///////////////////////// SCENARIOS END //////////////////////////////
+
+
+/*
+*    :
+* --out FILE -   JSON,   bench.json
+* --obj FILE -      
+* --image FILE -      
+* --repeats N -     
+* --frames N -    
+* --scenes N[,N...] -    ,   1,1000,100000
+*/
+static void parseArguments(int argc, char **argv, BenchmarkSettings &settings)
+{
+    for(int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        bool        hasValue = i + 1 < argc;
+
+        if(argument == "--out" && hasValue)
+            settings.outputPath = argv[++i];
+        else if(argument == "--obj" && hasValue)
+            settings.objPath = argv[++i];
+        else if(argument == "--image" && hasValue)
+            settings.imagePath = argv[++i];
+        else if(argument == "--repeats" && hasValue)
+            settings.repeats = std::max(1ul, std::stoul(argv[++i]));
+        else if(argument == "--frames" && hasValue)
+            settings.frames = std::stoul(argv[++i]);
+        else if(argument == "--scenes" && hasValue)
+        {
+            settings.sceneSizes.clear();
+
+            std::string list = argv[++i];
+            size_t      begin = 0;
+            while(begin < list.size())
+            {
+                size_t end = list.find(',', begin);
+                if(end == std::string::npos)
+                    end = list.size();
+
+                settings.sceneSizes.push_back(std::stoul(list.substr(begin, end - begin)));
+                begin = end + 1;
+            }
+        }
+        else
+            throw std::invalid_argument("unknown argument: " + argument);
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    BenchmarkSettings settings;
+
+    try
+    {
+        parseArguments(argc, argv, settings);
+
+        std::vector<BenchmarkResult> results;
+
+        results.push_back(benchmarkObjLoad(settings));
+        printResult(results.back());
+
+        results.push_back(benchmarkImageLoad(settings));
+        printResult(results.back());
+
+        for(const BenchmarkResult &result : benchmarkUploads(settings))
+        {
+            results.push_back(result);
+            printResult(result);
+        }
+
+        for(uint32_t objectCount : settings.sceneSizes)
+        {
+            results.push_back(benchmarkFrames(settings, objectCount));
+            printResult(results.back());
+        }
+
+        writeJson(settings.outputPath, results);
+        std::cout << "\nresults written to " << settings.outputPath << "\n";
+    }
+    catch(std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file